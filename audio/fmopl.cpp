@@ -155,6 +155,38 @@ OPL *Config::create(DriverId driver, OplType type) {
 
 bool OPL::_hasInstance = false;
 
+void WriteQueue::push(uint32 sample, int r, int v) {
+	Write write;
+	write.sample = _writes.empty() ? sample : MAX(sample, _writes.back().sample);
+	write.reg = r;
+	write.value = v;
+	_writes.push_back(write);
+}
+
+void WriteQueue::render(OPL *opl, int16 *buffer, int frames) {
+	const int channels = opl->isStereo() ? 2 : 1;
+	int pos = 0;
+
+	for (uint i = 0; i < _writes.size(); ++i) {
+		const Write &write = _writes[i];
+
+		// Only split the buffer where the chip state changes
+		const int sample = MIN<uint32>(write.sample, frames);
+		if (sample > pos) {
+			opl->readBuffer(buffer + pos * channels, (sample - pos) * channels);
+			pos = sample;
+		}
+
+		opl->writeReg(write.reg, write.value);
+	}
+
+	if (pos < frames)
+		opl->readBuffer(buffer + pos * channels, (frames - pos) * channels);
+
+	// Keep the storage around for the next buffer
+	_writes.resize(0);
+}
+
 } // End of namespace OPL
 
 void OPLDestroy(FM_OPL *OPL) {
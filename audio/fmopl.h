@@ -24,6 +24,7 @@
 #define AUDIO_FMOPL_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 
 namespace Common {
 class String;
@@ -157,6 +158,50 @@ public:
 	virtual bool isStereo() const = 0;
 };
 
+/**
+ * Register writes, each timestamped with the sample it has to take effect
+ * at. This allows a player to run all its ticks for a buffer first and then
+ * render the whole buffer with as few readBuffer() calls as possible, rather
+ * than one for each tick.
+ */
+class WriteQueue {
+public:
+	/**
+	 * Queue a register write, see OPL::writeReg().
+	 *
+	 * @param sample	sample frame, counted from the start of the next
+	 *					render() call, at which the write takes effect.
+	 *					Writes have to be queued in order, an earlier
+	 *					sample is moved to the last queued one.
+	 * @param r			hardware register number to write to
+	 * @param v			value, which will be written
+	 */
+	void push(uint32 sample, int r, int v);
+
+	/**
+	 * Render 'frames' sample frames, applying the queued writes on the way.
+	 * Writes due at or after the end of the buffer are applied after the
+	 * last sample. The queue is empty afterwards.
+	 *
+	 * @param opl		emulator to write to and read from
+	 * @param buffer	buffer for frames samples, or twice as many for a
+	 *					stereo OPL
+	 * @param frames	number of sample frames to render
+	 */
+	void render(OPL *opl, int16 *buffer, int frames);
+
+	bool empty() const { return _writes.empty(); }
+
+private:
+	struct Write {
+		uint32 sample;
+		uint16 reg;
+		uint8 value;
+	};
+
+	Common::Array<Write> _writes;
+};
+
 } // End of namespace OPL
 
 // Legacy API
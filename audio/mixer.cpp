@@ -26,6 +26,8 @@
 #include "common/system.h"
 #include "common/textconsole.h"
 
+#include "common/atomic.h"
+
 #include "audio/mixer_intern.h"
 #include "audio/rate.h"
 #include "audio/audiostream.h"
@@ -88,6 +90,11 @@ public:
 	 */
 	bool isPaused() const { return (_pauseLevel != 0); }
 
+	/**
+	 * Queries how often the channel has been paused without being unpaused.
+	 */
+	int getPauseLevel() const { return _pauseLevel; }
+
 	/**
 	 * Sets the channel's own volume.
 	 *
@@ -122,10 +129,31 @@ public:
 	 */
 	void notifyGlobalVolChange() { updateChannelVolumes(); }
 
+	/**
+	 * The values which determine how long the channel has been playing.
+	 */
+	struct Timing {
+		uint32 samplesConsumed;
+		uint32 mixerTimeStamp;
+		uint32 pauseStartTime;
+		uint32 pauseTime;
+		bool paused;
+	};
+
+	/**
+	 * Queries the channel's current playback timing.
+	 */
+	Timing getTiming() const;
+
+	/**
+	 * Computes how long a channel with the given timing has been playing.
+	 */
+	static Timestamp getElapsedTime(const Timing &timing, uint rate);
+
 	/**
 	 * Queries how long the channel has been playing.
 	 */
-	Timestamp getElapsedTime();
+	Timestamp getElapsedTime() { return getElapsedTime(getTiming(), _mixer->getOutputRate()); }
 
 	/**
 	 * Queries the channel's sound type.
@@ -173,17 +201,51 @@ private:
 #pragma mark --- Mixer ---
 #pragma mark -
 
+namespace {
+
+/**
+ * Pack the settings of a channel into one word, so that they can be passed
+ * to the mix callback atomically. The low byte of the handle serial makes
+ * sure stale settings are never applied to a newer channel in the slot.
+ */
+uint32 packChannelParams(uint32 handleSerial, byte volume, int8 balance, int pauseLevel) {
+	return ((handleSerial & 0xFF) << 24) | (volume << 16) | ((byte)balance << 8) | MIN(pauseLevel, 255);
+}
+
+} // End of anonymous namespace
+
 // TODO: parameter "system" is unused
-MixerImpl::MixerImpl(OSystem *system, uint sampleRate)
-	: _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+MixerImpl::MixerImpl(OSystem *system, uint sampleRate, bool useCommandQueue)
+	: _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _useCommandQueue(useCommandQueue), _commandsQueued(0), _commandsProcessed(0),
+	  _callbackCount(0), _callbackDuration(0), _seenCallbackCount(0), _seenCallbackTime(0),
+	  _callbackBusy(0), _engineBusy(0),
+	  _soundTypeSerial(0), _appliedSoundTypeSerial(0),
+	  _lastCallbackTime(0), _statsResetRequests(0), _statsResetsHandled(0) {
 
 	assert(sampleRate > 0);
 
-	for (int i = 0; i != NUM_CHANNELS; i++)
+	for (int i = 0; i != NUM_CHANNELS; i++) {
 		_channels[i] = 0;
+		_channelParams[i] = 0;
+		_finishedHandles[i] = 0xFFFFFFFF;
+		memset((void *)&_channelTimings[i], 0, sizeof(_channelTimings[i]));
+		_channelTimings[i].handle = 0xFFFFFFFF;
+	}
+
+	memset(&_stats, 0, sizeof(_stats));
 }
 
 MixerImpl::~MixerImpl() {
+	// Channels which were started, but never reached the mix callback
+	Command cmd;
+	while (_commands.pop(cmd)) {
+		if (cmd.type == Command::kPlay)
+			delete cmd.channel;
+	}
+
+	deleteRetiredChannels();
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
 }
@@ -221,6 +283,222 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 		*handle = chanHandle;
 }
 
+void MixerImpl::insertChannelState(SoundHandle *handle, Channel *chan, int id, byte volume, int8 balance, bool permanent, SoundType type) {
+	reapFinishedChannels();
+
+	int index = -1;
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		if (!_channelStates[i].active) {
+			index = i;
+			break;
+		}
+	}
+	if (index == -1) {
+		warning("MixerImpl::out of mixer slots");
+		delete chan;
+		return;
+	}
+
+	SoundHandle chanHandle;
+	chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
+	chan->setHandle(chanHandle);
+
+	ChannelState &state = _channelStates[index];
+	state.active = true;
+	state.handle = chanHandle._val;
+	state.id = id;
+	state.type = type;
+	state.permanent = permanent;
+	state.volume = volume;
+	state.balance = balance;
+	state.pauseLevel = 0;
+	publishChannelParams(index);
+
+	Command cmd;
+	cmd.type = Command::kPlay;
+	cmd.handle = chanHandle._val;
+	cmd.channel = chan;
+	queueCommand(cmd);
+
+	_handleSeed++;
+	if (handle)
+		*handle = chanHandle;
+}
+
+void MixerImpl::reapFinishedChannels() {
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		if (_channelStates[i].active && Common::atomicLoad(_finishedHandles[i]) == _channelStates[i].handle)
+			_channelStates[i].active = false;
+	}
+}
+
+int MixerImpl::findChannelState(SoundHandle handle) {
+	reapFinishedChannels();
+
+	const int index = handle._val % NUM_CHANNELS;
+	if (!_channelStates[index].active || _channelStates[index].handle != handle._val)
+		return -1;
+	return index;
+}
+
+void MixerImpl::publishChannelParams(int index) {
+	const ChannelState &state = _channelStates[index];
+	Common::atomicStore(_channelParams[index],
+		packChannelParams(state.handle / NUM_CHANNELS, state.volume, state.balance, state.pauseLevel));
+}
+
+void MixerImpl::stopChannelState(int index) {
+	Command cmd;
+	cmd.type = Command::kStop;
+	cmd.handle = _channelStates[index].handle;
+	cmd.channel = 0;
+	queueCommand(cmd);
+
+	_channelStates[index].active = false;
+}
+
+void MixerImpl::queueCommand(const Command &cmd) {
+	deleteRetiredChannels();
+
+	// If the mix callback is behind, wait until it has made room. Commands
+	// are never dropped.
+	while (!_commands.push(cmd))
+		waitForCommands();
+
+	_commandsQueued++;
+}
+
+void MixerImpl::waitForCommands() {
+	while ((int32)(Common::atomicLoad(_commandsProcessed) - _commandsQueued) < 0) {
+		deleteRetiredChannels();
+
+		// The mix callback processes the commands whenever it is entered.
+		// Only if it has not been called for a few buffers (or ever), e.g.
+		// because the audio device is not running, do it here instead.
+		const uint32 now = g_system->getMillis(true);
+		const uint32 count = Common::atomicLoad(_callbackCount);
+		if (count != _seenCallbackCount) {
+			_seenCallbackCount = count;
+			_seenCallbackTime = now;
+		} else if (count == 0 || now - _seenCallbackTime > 4 * Common::atomicLoad(_callbackDuration) + 10) {
+			if (tryProcessCommands())
+				continue;
+		}
+
+		g_system->delayMillis(1);
+	}
+
+	deleteRetiredChannels();
+}
+
+bool MixerImpl::tryProcessCommands() {
+	// Each side raises its flag before checking the other one's, so at most
+	// one of them gets to use the channels. If mixCallback() loses, it
+	// outputs silence instead of waiting for us.
+	Common::atomicStore(_engineBusy, (uint32)1);
+	Common::memoryBarrier();
+	const bool callbackBusy = Common::atomicLoad(_callbackBusy) != 0;
+	if (!callbackBusy)
+		processCommands();
+	Common::atomicStore(_engineBusy, (uint32)0);
+
+	return !callbackBusy;
+}
+
+void MixerImpl::deleteRetiredChannels() {
+	Channel *chan;
+	while (_retiredChannels.pop(chan))
+		delete chan;
+}
+
+void MixerImpl::processCommands() {
+	uint32 processed = 0;
+	Command cmd;
+	while (_commands.pop(cmd)) {
+		processed++;
+		const int index = cmd.handle % NUM_CHANNELS;
+
+		switch (cmd.type) {
+		case Command::kPlay:
+			// The engine side only reuses a slot after it has been stopped
+			// or reported as finished, so it is free by now.
+			assert(!_channels[index]);
+			_channels[index] = cmd.channel;
+			applyChannelParams(index);
+			break;
+
+		case Command::kStop:
+			if (_channels[index] && _channels[index]->getHandle()._val == cmd.handle) {
+				// Leave deleting the channel, and with it possibly the
+				// stream, to the engine side
+				if (!_retiredChannels.push(_channels[index]))
+					delete _channels[index];
+				_channels[index] = 0;
+			}
+			break;
+		}
+	}
+	Common::atomicStore(_commandsProcessed, _commandsProcessed + processed);
+
+	const uint32 serial = Common::atomicLoad(_soundTypeSerial);
+	if (serial != _appliedSoundTypeSerial) {
+		_appliedSoundTypeSerial = serial;
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i])
+				_channels[i]->notifyGlobalVolChange();
+		}
+	}
+}
+
+void MixerImpl::applyChannelParams(int index) {
+	Channel *chan = _channels[index];
+	const uint32 params = Common::atomicLoad(_channelParams[index]);
+
+	// Ignore settings meant for a newer channel, which will replace this
+	// one as soon as its kPlay command is processed.
+	if ((params >> 24) != ((chan->getHandle()._val / NUM_CHANNELS) & 0xFF))
+		return;
+
+	const byte volume = (params >> 16) & 0xFF;
+	const int8 balance = (int8)((params >> 8) & 0xFF);
+	const int pauseLevel = params & 0xFF;
+
+	if (chan->getVolume() != volume)
+		chan->setVolume(volume);
+	if (chan->getBalance() != balance)
+		chan->setBalance(balance);
+
+	while (chan->getPauseLevel() < pauseLevel)
+		chan->pause(true);
+	while (chan->getPauseLevel() > pauseLevel)
+		chan->pause(false);
+}
+
+void MixerImpl::publishChannelTiming(int index) {
+	ChannelTiming &timing = _channelTimings[index];
+	const Channel::Timing current = _channels[index]->getTiming();
+
+	// Odd serials mark an update in progress
+	Common::atomicStore(timing.serial, timing.serial + 1);
+	Common::memoryBarrier();
+	timing.handle = _channels[index]->getHandle()._val;
+	timing.samplesConsumed = current.samplesConsumed;
+	timing.mixerTimeStamp = current.mixerTimeStamp;
+	timing.pauseStartTime = current.pauseStartTime;
+	timing.pauseTime = current.pauseTime;
+	timing.paused = current.paused;
+	Common::atomicStore(timing.serial, timing.serial + 1);
+}
+
+void MixerImpl::channelFinished(int index) {
+	const uint32 handle = _channels[index]->getHandle()._val;
+	delete _channels[index];
+	_channels[index] = 0;
+
+	if (_useCommandQueue)
+		Common::atomicStore(_finishedHandles[index], handle);
+}
+
 void MixerImpl::playStream(
 			SoundType type,
 			SoundHandle *handle,
@@ -241,8 +519,15 @@ void MixerImpl::playStream(
 
 	// Prevent duplicate sounds
 	if (id != -1) {
-		for (int i = 0; i != NUM_CHANNELS; i++)
-			if (_channels[i] != 0 && _channels[i]->getId() == id) {
+		if (_useCommandQueue)
+			reapFinishedChannels();
+
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			const bool duplicate = _useCommandQueue
+				? (_channelStates[i].active && _channelStates[i].id == id)
+				: (_channels[i] != 0 && _channels[i]->getId() == id);
+
+			if (duplicate) {
 				// Delete the stream if were asked to auto-dispose it.
 				// Note: This could cause trouble if the client code does not
 				// yet expect the stream to be gone. The primary example to
@@ -253,6 +538,7 @@ void MixerImpl::playStream(
 					delete stream;
 				return;
 			}
+		}
 	}
 
 #ifdef AUDIO_REVERSE_STEREO
@@ -263,13 +549,39 @@ void MixerImpl::playStream(
 	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
-	insertChannel(handle, chan);
+
+	if (_useCommandQueue)
+		insertChannelState(handle, chan, id, volume, balance, permanent, type);
+	else
+		insertChannel(handle, chan);
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
-	Common::StackLock lock(_mutex);
+	const uint32 start = g_system->getMillis(true);
+
+	// In command queue mode, the engine side never touches the channels, so
+	// there is nothing to lock.
+	if (!_useCommandQueue) {
+		_mutex.lock();
+	} else {
+		Common::atomicStore(_callbackCount, _callbackCount + 1);
+		Common::atomicStore(_callbackDuration, (uint32)(len / 4 * 1000 / _sampleRate));
+
+		// The engine side only processes commands while this callback does
+		// not seem to run. Should it still be doing so, never wait for it
+		// but output silence this time.
+		Common::atomicStore(_callbackBusy, (uint32)1);
+		Common::memoryBarrier();
+		if (Common::atomicLoad(_engineBusy)) {
+			Common::atomicStore(_callbackBusy, (uint32)0);
+			memset(samples, 0, len);
+			return 0;
+		}
+
+		processCommands();
+	}
 
 	int16 *buf = (int16 *)samples;
 	// we store stereo, 16-bit samples
@@ -286,22 +598,85 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	int res = 0, tmp;
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i]) {
+			if (_useCommandQueue)
+				applyChannelParams(i);
+
 			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = 0;
+				channelFinished(i);
 			} else if (!_channels[i]->isPaused()) {
 				tmp = _channels[i]->mix(buf, len);
 
 				if (tmp > res)
 					res = tmp;
 			}
+
+			if (_useCommandQueue && _channels[i])
+				publishChannelTiming(i);
 		}
 
+	if (!_useCommandQueue)
+		_mutex.unlock();
+	else
+		Common::atomicStore(_callbackBusy, (uint32)0);
+
+	updateCallbackStats(start, g_system->getMillis(true), len);
+
 	return res;
 }
 
+void MixerImpl::updateCallbackStats(uint32 start, uint32 end, uint len) {
+	const uint32 resets = Common::atomicLoad(_statsResetRequests);
+	if (resets != _statsResetsHandled) {
+		_statsResetsHandled = resets;
+		memset(&_stats, 0, sizeof(_stats));
+		_lastCallbackTime = 0;
+	}
+
+	const uint32 duration = end - start;
+	const uint32 bufferDuration = len * 1000 / _sampleRate;
+	bool xrun = (duration >= bufferDuration);
+
+	if (_lastCallbackTime != 0) {
+		const uint32 interval = start - _lastCallbackTime;
+		if (_stats.callbacks == 1 || interval < _stats.minInterval)
+			_stats.minInterval = interval;
+		_stats.maxInterval = MAX(_stats.maxInterval, interval);
+
+		// Backends keep at least two buffers queued, so the device only runs
+		// dry if we are later than that.
+		if (interval > 2 * bufferDuration)
+			xrun = true;
+	}
+
+	_lastCallbackTime = start;
+	_stats.callbacks++;
+	_stats.maxDuration = MAX(_stats.maxDuration, duration);
+	_stats.bufferDuration = bufferDuration;
+	if (xrun)
+		_stats.xruns++;
+}
+
+MixerImpl::CallbackStats MixerImpl::getCallbackStats() const {
+	Common::memoryBarrier();
+	return _stats;
+}
+
+void MixerImpl::resetCallbackStats() {
+	Common::atomicStore(_statsResetRequests, _statsResetRequests + 1);
+}
+
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
+	if (_useCommandQueue) {
+		reapFinishedChannels();
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channelStates[i].active && !_channelStates[i].permanent)
+				stopChannelState(i);
+		}
+		waitForCommands();
+		return;
+	}
+
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != 0 && !_channels[i]->isPermanent()) {
 			delete _channels[i];
@@ -312,6 +687,16 @@ void MixerImpl::stopAll() {
 
 void MixerImpl::stopID(int id) {
 	Common::StackLock lock(_mutex);
+	if (_useCommandQueue) {
+		reapFinishedChannels();
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channelStates[i].active && _channelStates[i].id == id)
+				stopChannelState(i);
+		}
+		waitForCommands();
+		return;
+	}
+
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != 0 && _channels[i]->getId() == id) {
 			delete _channels[i];
@@ -323,6 +708,15 @@ void MixerImpl::stopID(int id) {
 void MixerImpl::stopHandle(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
 
+	if (_useCommandQueue) {
+		const int index = findChannelState(handle);
+		if (index != -1) {
+			stopChannelState(index);
+			waitForCommands();
+		}
+		return;
+	}
+
 	// Simply ignore stop requests for handles of sounds that already terminated
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
@@ -336,6 +730,11 @@ void MixerImpl::muteSoundType(SoundType type, bool mute) {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
 	_soundTypeSettings[type].mute = mute;
 
+	if (_useCommandQueue) {
+		Common::atomicStore(_soundTypeSerial, _soundTypeSerial + 1);
+		return;
+	}
+
 	for (int i = 0; i != NUM_CHANNELS; ++i) {
 		if (_channels[i] && _channels[i]->getType() == type)
 			_channels[i]->notifyGlobalVolChange();
@@ -350,6 +749,15 @@ bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
 	Common::StackLock lock(_mutex);
 
+	if (_useCommandQueue) {
+		const int index = findChannelState(handle);
+		if (index != -1) {
+			_channelStates[index].volume = volume;
+			publishChannelParams(index);
+		}
+		return;
+	}
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return;
@@ -358,6 +766,12 @@ void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
+	if (_useCommandQueue) {
+		Common::StackLock lock(_mutex);
+		const int index = findChannelState(handle);
+		return (index != -1) ? _channelStates[index].volume : 0;
+	}
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return 0;
@@ -368,6 +782,15 @@ byte MixerImpl::getChannelVolume(SoundHandle handle) {
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
 	Common::StackLock lock(_mutex);
 
+	if (_useCommandQueue) {
+		const int index = findChannelState(handle);
+		if (index != -1) {
+			_channelStates[index].balance = balance;
+			publishChannelParams(index);
+		}
+		return;
+	}
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return;
@@ -376,6 +799,12 @@ void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
+	if (_useCommandQueue) {
+		Common::StackLock lock(_mutex);
+		const int index = findChannelState(handle);
+		return (index != -1) ? _channelStates[index].balance : 0;
+	}
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return 0;
@@ -390,6 +819,31 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
 
+	if (_useCommandQueue) {
+		const int index = findChannelState(handle);
+		if (index == -1)
+			return Timestamp(0, _sampleRate);
+
+		const ChannelTiming &published = _channelTimings[index];
+		Channel::Timing timing;
+		uint32 serial;
+		do {
+			serial = Common::atomicLoad(published.serial);
+			timing.samplesConsumed = published.samplesConsumed;
+			timing.mixerTimeStamp = published.mixerTimeStamp;
+			timing.pauseStartTime = published.pauseStartTime;
+			timing.pauseTime = published.pauseTime;
+			timing.paused = published.paused;
+			if (published.handle != handle._val) {
+				// The channel has not been mixed yet
+				timing.mixerTimeStamp = 0;
+			}
+			Common::memoryBarrier();
+		} while ((serial & 1) || serial != published.serial);
+
+		return Channel::getElapsedTime(timing, _sampleRate);
+	}
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return Timestamp(0, _sampleRate);
@@ -399,6 +853,18 @@ Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
 
 void MixerImpl::pauseAll(bool paused) {
 	Common::StackLock lock(_mutex);
+	if (_useCommandQueue) {
+		reapFinishedChannels();
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			ChannelState &state = _channelStates[i];
+			if (state.active && (paused || state.pauseLevel > 0)) {
+				state.pauseLevel += paused ? 1 : -1;
+				publishChannelParams(i);
+			}
+		}
+		return;
+	}
+
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != 0) {
 			_channels[i]->pause(paused);
@@ -408,6 +874,21 @@ void MixerImpl::pauseAll(bool paused) {
 
 void MixerImpl::pauseID(int id, bool paused) {
 	Common::StackLock lock(_mutex);
+	if (_useCommandQueue) {
+		reapFinishedChannels();
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			ChannelState &state = _channelStates[i];
+			if (state.active && state.id == id) {
+				if (paused || state.pauseLevel > 0) {
+					state.pauseLevel += paused ? 1 : -1;
+					publishChannelParams(i);
+				}
+				return;
+			}
+		}
+		return;
+	}
+
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != 0 && _channels[i]->getId() == id) {
 			_channels[i]->pause(paused);
@@ -419,6 +900,18 @@ void MixerImpl::pauseID(int id, bool paused) {
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
 	Common::StackLock lock(_mutex);
 
+	if (_useCommandQueue) {
+		const int index = findChannelState(handle);
+		if (index != -1) {
+			ChannelState &state = _channelStates[index];
+			if (paused || state.pauseLevel > 0) {
+				state.pauseLevel += paused ? 1 : -1;
+				publishChannelParams(index);
+			}
+		}
+		return;
+	}
+
 	// Simply ignore (un)pause requests for sounds that already terminated
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
@@ -434,6 +927,14 @@ bool MixerImpl::isSoundIDActive(int id) {
 	g_eventRec.updateSubsystems();
 #endif
 
+	if (_useCommandQueue) {
+		reapFinishedChannels();
+		for (int i = 0; i != NUM_CHANNELS; i++)
+			if (_channelStates[i].active && _channelStates[i].id == id)
+				return true;
+		return false;
+	}
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i] && _channels[i]->getId() == id)
 			return true;
@@ -442,6 +943,12 @@ bool MixerImpl::isSoundIDActive(int id) {
 
 int MixerImpl::getSoundID(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
+
+	if (_useCommandQueue) {
+		const int index = findChannelState(handle);
+		return (index != -1) ? _channelStates[index].id : 0;
+	}
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
 		return _channels[index]->getId();
@@ -455,12 +962,24 @@ bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
 	g_eventRec.updateSubsystems();
 #endif
 
+	if (_useCommandQueue)
+		return findChannelState(handle) != -1;
+
 	const int index = handle._val % NUM_CHANNELS;
 	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
 	Common::StackLock lock(_mutex);
+
+	if (_useCommandQueue) {
+		reapFinishedChannels();
+		for (int i = 0; i != NUM_CHANNELS; i++)
+			if (_channelStates[i].active && _channelStates[i].type == type)
+				return true;
+		return false;
+	}
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i] && _channels[i]->getType() == type)
 			return true;
@@ -482,6 +1001,11 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	Common::StackLock lock(_mutex);
 	_soundTypeSettings[type].volume = volume;
 
+	if (_useCommandQueue) {
+		Common::atomicStore(_soundTypeSerial, _soundTypeSerial + 1);
+		return;
+	}
+
 	for (int i = 0; i != NUM_CHANNELS; ++i) {
 		if (_channels[i] && _channels[i]->getType() == type)
 			_channels[i]->notifyGlobalVolChange();
@@ -579,23 +1103,32 @@ void Channel::pause(bool paused) {
 	}
 }
 
-Timestamp Channel::getElapsedTime() {
-	const uint32 rate = _mixer->getOutputRate();
+Channel::Timing Channel::getTiming() const {
+	Timing timing;
+	timing.samplesConsumed = _samplesConsumed;
+	timing.mixerTimeStamp = _mixerTimeStamp;
+	timing.pauseStartTime = _pauseStartTime;
+	timing.pauseTime = _pauseTime;
+	timing.paused = isPaused();
+	return timing;
+}
+
+Timestamp Channel::getElapsedTime(const Timing &timing, uint rate) {
 	uint32 delta = 0;
 
 	Audio::Timestamp ts(0, rate);
 
-	if (_mixerTimeStamp == 0)
+	if (timing.mixerTimeStamp == 0)
 		return ts;
 
-	if (isPaused())
-		delta = _pauseStartTime - _mixerTimeStamp;
+	if (timing.paused)
+		delta = timing.pauseStartTime - timing.mixerTimeStamp;
 	else
-		delta = g_system->getMillis(true) - _mixerTimeStamp - _pauseTime;
+		delta = g_system->getMillis(true) - timing.mixerTimeStamp - timing.pauseTime;
 
 	// Convert the number of samples into a time duration.
 
-	ts = ts.addFrames(_samplesConsumed);
+	ts = ts.addFrames(timing.samplesConsumed);
 	ts = ts.addMsecs(delta);
 
 	// In theory it would seem like a good idea to limit the approximation
@@ -25,6 +25,7 @@
 
 #include "common/scummsys.h"
 #include "common/mutex.h"
+#include "common/spscqueue.h"
 #include "audio/mixer.h"
 
 namespace Audio {
@@ -42,6 +43,17 @@ namespace Audio {
  * 4) Change the mixer into ready mode via setReady(true).
  * 5) Start audio processing (e.g. by resuming the audio thread, if applicable).
  *
+ * By default, all methods and mixCallback() are serialized by one mutex.
+ * If the instance is created with useCommandQueue set, mixCallback() never
+ * takes a lock instead: starting and stopping channels is passed to the mix
+ * callback through a lock-free queue, channel settings through atomically
+ * updated words, and queries are answered from the state the engine side
+ * keeps for itself. Engine calls then never wait for the mixing to finish,
+ * except for stopping channels: callers may free a stream right after
+ * stopping it, so stops only return once no callback can use the channel
+ * anymore. If no callback is running at that moment, the engine side
+ * processes the queued commands itself.
+ *
  * In the future, we might make it possible for backends to provide
  * (partial) alternative implementations of the mixer, e.g. to make
  * better use of native sound mixing support on low-end devices.
@@ -70,10 +82,126 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	const bool _useCommandQueue;
+
+	/**
+	 * Commands from the engine side to the mix callback, only used in
+	 * command queue mode.
+	 */
+	struct Command {
+		enum Type {
+			kPlay,
+			kStop
+		};
+
+		Type type;
+		uint32 handle;
+		Channel *channel; ///< The new channel for kPlay
+	};
+
+	Common::SPSCQueue<Command, 256> _commands;
+	uint32 _commandsQueued;                ///< Only written by the engine side
+	volatile uint32 _commandsProcessed;    ///< Written by whoever processes the commands
+
+	/**
+	 * Stopped channels, handed back to the engine side to be deleted there.
+	 * Every entry stems from a kStop command which was processed since the
+	 * engine side last emptied it, so it can never overflow.
+	 */
+	Common::SPSCQueue<Channel *, 512> _retiredChannels;
+
+	volatile uint32 _callbackCount;        ///< Incremented whenever mixCallback() is entered
+	volatile uint32 _callbackDuration;     ///< Length of the last buffer mixed, in milliseconds
+	uint32 _seenCallbackCount;             ///< _callbackCount as last seen by the engine side
+	uint32 _seenCallbackTime;              ///< Time at which _seenCallbackCount was last changed
+	volatile uint32 _callbackBusy;         ///< Set while mixCallback() uses the channels
+	volatile uint32 _engineBusy;           ///< Set while the engine side processes commands
+
+	/**
+	 * The engine side view of a channel in command queue mode. It is only
+	 * accessed with _mutex held, which the mix callback never takes.
+	 */
+	struct ChannelState {
+		ChannelState() : active(false), handle(0), id(-1), type(kPlainSoundType), permanent(false),
+			volume(kMaxChannelVolume), balance(0), pauseLevel(0) {}
+
+		bool active;
+		uint32 handle;
+		int id;
+		SoundType type;
+		bool permanent;
+		byte volume;
+		int8 balance;
+		int pauseLevel;
+	};
+
+	ChannelState _channelStates[NUM_CHANNELS];
+
+	/**
+	 * Playback position of a channel, as published by the mix callback in
+	 * command queue mode. A reader has to retry if serial is odd or changed
+	 * while the fields were read.
+	 */
+	struct ChannelTiming {
+		volatile uint32 serial;
+		volatile uint32 handle;
+		volatile uint32 samplesConsumed;
+		volatile uint32 mixerTimeStamp;
+		volatile uint32 pauseStartTime;
+		volatile uint32 pauseTime;
+		volatile bool paused;
+	};
+
+	ChannelTiming _channelTimings[NUM_CHANNELS];
+
+	/** Volume, balance and pause level per channel, set by the engine side. */
+	volatile uint32 _channelParams[NUM_CHANNELS];
+	/** Handle of the last channel in each slot which ended on its own. */
+	volatile uint32 _finishedHandles[NUM_CHANNELS];
+	/** Incremented whenever a sound type volume or mute setting changes. */
+	volatile uint32 _soundTypeSerial;
+	uint32 _appliedSoundTypeSerial;
+
+	void insertChannelState(SoundHandle *handle, Channel *chan, int id, byte volume, int8 balance, bool permanent, SoundType type);
+	void reapFinishedChannels();
+	int findChannelState(SoundHandle handle);
+	void publishChannelParams(int index);
+	void stopChannelState(int index);
+	void queueCommand(const Command &cmd);
+	void waitForCommands();
+	bool tryProcessCommands();
+	void deleteRetiredChannels();
+
+	void processCommands();
+	void applyChannelParams(int index);
+	void publishChannelTiming(int index);
+	void channelFinished(int index);
 
 public:
+	/**
+	 * Statistics about the invocations of mixCallback(), which help to
+	 * diagnose audio dropouts. All times are in milliseconds.
+	 */
+	struct CallbackStats {
+		uint32 callbacks;      ///< Number of mixCallback() invocations
+		uint32 xruns;          ///< Callbacks which ran longer than the buffer lasts, or came too late
+		uint32 maxDuration;    ///< Longest time spent in a single mixCallback()
+		uint32 minInterval;    ///< Shortest time between two consecutive callbacks
+		uint32 maxInterval;    ///< Longest time between two consecutive callbacks
+		uint32 bufferDuration; ///< Playback time of the most recent buffer
+	};
+
+private:
+	CallbackStats _stats;
+	uint32 _lastCallbackTime;
+	volatile uint32 _statsResetRequests;
+	uint32 _statsResetsHandled;
 
-	MixerImpl(OSystem *system, uint sampleRate);
+	void updateCallbackStats(uint32 start, uint32 end, uint len);
+
+public:
+
+	MixerImpl(OSystem *system, uint sampleRate, bool useCommandQueue = false);
 	~MixerImpl();
 
 	virtual bool isReady() const { return _mixerReady; }
@@ -139,6 +267,25 @@ public:
 	 * their audio system has been completed.
 	 */
 	void setReady(bool ready);
+
+	/**
+	 * Whether this instance passes engine calls through a command queue
+	 * instead of locking the mix callback.
+	 */
+	bool usesCommandQueue() const { return _useCommandQueue; }
+
+	/**
+	 * Return the callback statistics gathered since the mixer was created or
+	 * resetCallbackStats() was last called. As the statistics are updated
+	 * by the audio thread, the values may be slightly out of date.
+	 */
+	CallbackStats getCallbackStats() const;
+
+	/**
+	 * Request the callback statistics to be reset. This takes effect with
+	 * the next mixCallback() invocation.
+	 */
+	void resetCallbackStats();
 };
 
 
@@ -31,10 +31,27 @@
 #include "audio/audiostream.h"
 #include "audio/rate.h"
 #include "audio/mixer.h"
+#include "common/cpudetect.h"
 #include "common/frac.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
+// The vectorized mixing code below produces native endian signed samples only
+#if !defined(OUTPUT_UNSIGNED_AUDIO)
+#if defined(SCUMMVM_SSE2)
+#include <emmintrin.h>
+#define USE_SSE2_MIXING
+#endif
+#if defined(SCUMMVM_AVX2)
+#include <immintrin.h>
+#define USE_AVX2_MIXING
+#endif
+#if defined(SCUMMVM_NEON)
+#include <arm_neon.h>
+#define USE_NEON_MIXING
+#endif
+#endif
+
 namespace Audio {
 
 
@@ -47,6 +64,242 @@ namespace Audio {
 #define INTERMEDIATE_BUFFER_SIZE 512
 
 
+#pragma mark -
+
+
+/**
+ * Mix the stereo frames from 'in' into 'obuf', scaling the channels by vol0
+ * and vol1 respectively. The input has to be in output channel order.
+ */
+typedef void (*MixStereoProc)(st_sample_t *obuf, const st_sample_t *in, st_size_t numFrames, int vol0, int vol1);
+
+/**
+ * Mix the mono samples from 'in' into both channels of 'obuf', scaling the
+ * channels by vol0 and vol1 respectively.
+ */
+typedef void (*MixMonoProc)(st_sample_t *obuf, const st_sample_t *in, st_size_t numFrames, int vol0, int vol1);
+
+static void mixStereoScalar(st_sample_t *obuf, const st_sample_t *in, st_size_t numFrames, int vol0, int vol1) {
+	for (; numFrames > 0; --numFrames) {
+		clampedAdd(obuf[0], (in[0] * vol0) / Audio::Mixer::kMaxMixerVolume);
+		clampedAdd(obuf[1], (in[1] * vol1) / Audio::Mixer::kMaxMixerVolume);
+		in += 2;
+		obuf += 2;
+	}
+}
+
+static void mixMonoScalar(st_sample_t *obuf, const st_sample_t *in, st_size_t numFrames, int vol0, int vol1) {
+	for (; numFrames > 0; --numFrames) {
+		clampedAdd(obuf[0], (*in * vol0) / Audio::Mixer::kMaxMixerVolume);
+		clampedAdd(obuf[1], (*in * vol1) / Audio::Mixer::kMaxMixerVolume);
+		in++;
+		obuf += 2;
+	}
+}
+
+/*
+ * The vectorized variants compute exactly the same results as the scalar
+ * code: the full 32 bit products are divided by kMaxMixerVolume (256)
+ * rounding towards zero, which always fits into 16 bits again. The
+ * saturating add then does what clampedAdd does.
+ */
+
+#ifdef USE_SSE2_MIXING
+
+SCUMMVM_TARGET_SSE2
+static inline __m128i scaleSSE2(__m128i s, __m128i vol) {
+	const __m128i lo = _mm_mullo_epi16(s, vol);
+	const __m128i hi = _mm_mulhi_epi16(s, vol);
+	__m128i p0 = _mm_unpacklo_epi16(lo, hi);
+	__m128i p1 = _mm_unpackhi_epi16(lo, hi);
+	// Add 255 to negative products so the shift rounds towards zero
+	const __m128i bias = _mm_set1_epi32(Audio::Mixer::kMaxMixerVolume - 1);
+	p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), bias)), 8);
+	p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), bias)), 8);
+	return _mm_packs_epi32(p0, p1);
+}
+
+SCUMMVM_TARGET_SSE2
+static void mixStereoSSE2(st_sample_t *obuf, const st_sample_t *in, st_size_t numFrames, int vol0, int vol1) {
+	const __m128i vol = _mm_set1_epi32((vol1 << 16) | vol0);
+
+	for (; numFrames >= 4; numFrames -= 4) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)in);
+		const __m128i o = _mm_loadu_si128((const __m128i *)obuf);
+		_mm_storeu_si128((__m128i *)obuf, _mm_adds_epi16(o, scaleSSE2(s, vol)));
+		in += 8;
+		obuf += 8;
+	}
+
+	mixStereoScalar(obuf, in, numFrames, vol0, vol1);
+}
+
+SCUMMVM_TARGET_SSE2
+static void mixMonoSSE2(st_sample_t *obuf, const st_sample_t *in, st_size_t numFrames, int vol0, int vol1) {
+	const __m128i vol = _mm_set1_epi32((vol1 << 16) | vol0);
+
+	for (; numFrames >= 8; numFrames -= 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)in);
+		const __m128i o0 = _mm_loadu_si128((const __m128i *)obuf);
+		const __m128i o1 = _mm_loadu_si128((const __m128i *)(obuf + 8));
+		_mm_storeu_si128((__m128i *)obuf, _mm_adds_epi16(o0, scaleSSE2(_mm_unpacklo_epi16(s, s), vol)));
+		_mm_storeu_si128((__m128i *)(obuf + 8), _mm_adds_epi16(o1, scaleSSE2(_mm_unpackhi_epi16(s, s), vol)));
+		in += 8;
+		obuf += 16;
+	}
+
+	mixMonoScalar(obuf, in, numFrames, vol0, vol1);
+}
+
+#endif
+
+#ifdef USE_AVX2_MIXING
+
+// All operations used work within 128 bit lanes, so the sample order is kept
+SCUMMVM_TARGET_AVX2
+static inline __m256i scaleAVX2(__m256i s, __m256i vol) {
+	const __m256i lo = _mm256_mullo_epi16(s, vol);
+	const __m256i hi = _mm256_mulhi_epi16(s, vol);
+	__m256i p0 = _mm256_unpacklo_epi16(lo, hi);
+	__m256i p1 = _mm256_unpackhi_epi16(lo, hi);
+	const __m256i bias = _mm256_set1_epi32(Audio::Mixer::kMaxMixerVolume - 1);
+	p0 = _mm256_srai_epi32(_mm256_add_epi32(p0, _mm256_and_si256(_mm256_srai_epi32(p0, 31), bias)), 8);
+	p1 = _mm256_srai_epi32(_mm256_add_epi32(p1, _mm256_and_si256(_mm256_srai_epi32(p1, 31), bias)), 8);
+	return _mm256_packs_epi32(p0, p1);
+}
+
+SCUMMVM_TARGET_AVX2
+static void mixStereoAVX2(st_sample_t *obuf, const st_sample_t *in, st_size_t numFrames, int vol0, int vol1) {
+	const __m256i vol = _mm256_set1_epi32((vol1 << 16) | vol0);
+
+	for (; numFrames >= 8; numFrames -= 8) {
+		const __m256i s = _mm256_loadu_si256((const __m256i *)in);
+		const __m256i o = _mm256_loadu_si256((const __m256i *)obuf);
+		_mm256_storeu_si256((__m256i *)obuf, _mm256_adds_epi16(o, scaleAVX2(s, vol)));
+		in += 16;
+		obuf += 16;
+	}
+
+	mixStereoScalar(obuf, in, numFrames, vol0, vol1);
+}
+
+SCUMMVM_TARGET_AVX2
+static void mixMonoAVX2(st_sample_t *obuf, const st_sample_t *in, st_size_t numFrames, int vol0, int vol1) {
+	const __m256i vol = _mm256_set1_epi32((vol1 << 16) | vol0);
+
+	for (; numFrames >= 16; numFrames -= 16) {
+		// Reorder the 64 bit blocks so the in-lane unpacks yield samples 0-7
+		// and 8-15 respectively
+		const __m256i s = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i *)in), 0xD8);
+		const __m256i o0 = _mm256_loadu_si256((const __m256i *)obuf);
+		const __m256i o1 = _mm256_loadu_si256((const __m256i *)(obuf + 16));
+		_mm256_storeu_si256((__m256i *)obuf, _mm256_adds_epi16(o0, scaleAVX2(_mm256_unpacklo_epi16(s, s), vol)));
+		_mm256_storeu_si256((__m256i *)(obuf + 16), _mm256_adds_epi16(o1, scaleAVX2(_mm256_unpackhi_epi16(s, s), vol)));
+		in += 16;
+		obuf += 32;
+	}
+
+	mixMonoScalar(obuf, in, numFrames, vol0, vol1);
+}
+
+#endif
+
+#ifdef USE_NEON_MIXING
+
+static inline int16x4_t scaleNEON(int16x4_t s, int16x4_t vol) {
+	int32x4_t p = vmull_s16(s, vol);
+	// Add 255 to negative products so the shift rounds towards zero
+	p = vaddq_s32(p, vandq_s32(vshrq_n_s32(p, 31), vdupq_n_s32(Audio::Mixer::kMaxMixerVolume - 1)));
+	return vshrn_n_s32(p, 8);
+}
+
+static inline int16x8_t scaleNEON(int16x8_t s, int16x8_t vol) {
+	return vcombine_s16(scaleNEON(vget_low_s16(s), vget_low_s16(vol)), scaleNEON(vget_high_s16(s), vget_high_s16(vol)));
+}
+
+static void mixStereoNEON(st_sample_t *obuf, const st_sample_t *in, st_size_t numFrames, int vol0, int vol1) {
+	const int16x8_t vol = vreinterpretq_s16_s32(vdupq_n_s32((vol1 << 16) | vol0));
+
+	for (; numFrames >= 4; numFrames -= 4) {
+		vst1q_s16(obuf, vqaddq_s16(vld1q_s16(obuf), scaleNEON(vld1q_s16(in), vol)));
+		in += 8;
+		obuf += 8;
+	}
+
+	mixStereoScalar(obuf, in, numFrames, vol0, vol1);
+}
+
+static void mixMonoNEON(st_sample_t *obuf, const st_sample_t *in, st_size_t numFrames, int vol0, int vol1) {
+	const int16x8_t vol = vreinterpretq_s16_s32(vdupq_n_s32((vol1 << 16) | vol0));
+
+	for (; numFrames >= 8; numFrames -= 8) {
+		const int16x8_t s = vld1q_s16(in);
+		const int16x8x2_t d = vzipq_s16(s, s);
+		vst1q_s16(obuf, vqaddq_s16(vld1q_s16(obuf), scaleNEON(d.val[0], vol)));
+		vst1q_s16(obuf + 8, vqaddq_s16(vld1q_s16(obuf + 8), scaleNEON(d.val[1], vol)));
+		in += 8;
+		obuf += 16;
+	}
+
+	mixMonoScalar(obuf, in, numFrames, vol0, vol1);
+}
+
+#endif
+
+static MixStereoProc s_mixStereo = mixStereoScalar;
+static MixMonoProc s_mixMono = mixMonoScalar;
+
+/**
+ * Select the fastest mixing code the CPU supports. This is done when creating
+ * a rate converter, so the choice is made before the first flow() call.
+ */
+static void initMixProcs() {
+	MixStereoProc mixStereo = mixStereoScalar;
+	MixMonoProc mixMono = mixMonoScalar;
+
+#ifdef USE_SSE2_MIXING
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2)) {
+		mixStereo = mixStereoSSE2;
+		mixMono = mixMonoSSE2;
+	}
+#endif
+#ifdef USE_AVX2_MIXING
+	if (Common::hasCpuFeature(Common::kCpuFeatureAVX2)) {
+		mixStereo = mixStereoAVX2;
+		mixMono = mixMonoAVX2;
+	}
+#endif
+#ifdef USE_NEON_MIXING
+	if (Common::hasCpuFeature(Common::kCpuFeatureNEON)) {
+		mixStereo = mixStereoNEON;
+		mixMono = mixMonoNEON;
+	}
+#endif
+
+	s_mixStereo = mixStereo;
+	s_mixMono = mixMono;
+}
+
+/**
+ * Mix numFrames frames from 'in' into 'obuf'. Stereo input has to be in output
+ * channel order already, i.e. with reverseStereo the right channel comes first.
+ */
+template<bool stereo, bool reverseStereo>
+static inline void mixFrames(st_sample_t *obuf, const st_sample_t *in, st_size_t numFrames, st_volume_t vol_l, st_volume_t vol_r) {
+	if (stereo) {
+		if (reverseStereo)
+			s_mixStereo(obuf, in, numFrames, vol_r, vol_l);
+		else
+			s_mixStereo(obuf, in, numFrames, vol_l, vol_r);
+	} else {
+		s_mixMono(obuf, in, numFrames, vol_l, vol_r);
+	}
+}
+
+
+#pragma mark -
+
+
 /**
  * Audio rate converter based on simple resampling. Used when no
  * interpolation is required.
@@ -60,6 +313,9 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** resampled frames (in output channel order) waiting to be mixed */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 	/** position of how far output is ahead of input */
 	/** Holds what would have been opos-ipos */
 	long opos;
@@ -103,45 +359,53 @@ SimpleRateConverter<stereo, reverseStereo>::SimpleRateConverter(st_rate_t inrate
  */
 template<bool stereo, bool reverseStereo>
 int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-	st_sample_t *ostart, *oend;
+	const st_size_t maxFrames = ARRAYSIZE(outBuf) / (stereo ? 2 : 1);
+	st_size_t done = 0;
+	bool endOfInput = false;
+
+	while (done < osamp && !endOfInput) {
+		const st_size_t numFrames = MIN<st_size_t>(osamp - done, maxFrames);
+		st_sample_t *out = outBuf;
+		st_size_t frames;
+
+		for (frames = 0; frames < numFrames; ++frames) {
+			// read enough input samples so that opos >= 0
+			do {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				opos--;
+				if (opos >= 0) {
+					inPtr += (stereo ? 2 : 1);
+				}
+			} while (opos >= 0);
+
+			if (endOfInput)
+				break;
 
-	ostart = obuf;
-	oend = obuf + osamp * 2;
-
-	while (obuf < oend) {
-
-		// read enough input samples so that opos >= 0
-		do {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
-			}
-			inLen -= (stereo ? 2 : 1);
-			opos--;
-			if (opos >= 0) {
-				inPtr += (stereo ? 2 : 1);
+			if (stereo) {
+				out[reverseStereo    ] = *inPtr++;
+				out[reverseStereo ^ 1] = *inPtr++;
+				out += 2;
+			} else {
+				*out++ = *inPtr++;
 			}
-		} while (opos >= 0);
-
-		st_sample_t out0, out1;
-		out0 = *inPtr++;
-		out1 = (stereo ? *inPtr++ : out0);
-
-		// Increment output position
-		opos += opos_inc;
-
-		// output left channel
-		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
 
-		// output right channel
-		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+			// Increment output position
+			opos += opos_inc;
+		}
 
-		obuf += 2;
+		mixFrames<stereo, reverseStereo>(obuf + done * 2, outBuf, frames, vol_l, vol_r);
+		done += frames;
 	}
-	return (obuf - ostart) / 2;
+	return done;
 }
 
 /**
@@ -162,6 +426,9 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** interpolated frames (in output channel order) waiting to be mixed */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 	/** fractional position of the output stream in input stream unit */
 	frac_t opos;
 
@@ -212,55 +479,62 @@ LinearRateConverter<stereo, reverseStereo>::LinearRateConverter(st_rate_t inrate
  */
 template<bool stereo, bool reverseStereo>
 int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-	st_sample_t *ostart, *oend;
-
-	ostart = obuf;
-	oend = obuf + osamp * 2;
-
-	while (obuf < oend) {
-
-		// read enough input samples so that opos < 0
-		while ((frac_t)FRAC_ONE <= opos) {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
+	const st_size_t maxFrames = ARRAYSIZE(outBuf) / (stereo ? 2 : 1);
+	st_size_t done = 0;
+	bool endOfInput = false;
+
+	while (done < osamp && !endOfInput) {
+		const st_size_t numFrames = MIN<st_size_t>(osamp - done, maxFrames);
+		st_sample_t *out = outBuf;
+		st_size_t frames = 0;
+
+		while (frames < numFrames) {
+			// read enough input samples so that opos < 0
+			while ((frac_t)FRAC_ONE <= opos) {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				ilast0 = icur0;
+				icur0 = *inPtr++;
+				if (stereo) {
+					ilast1 = icur1;
+					icur1 = *inPtr++;
+				}
+				opos -= FRAC_ONE;
 			}
-			inLen -= (stereo ? 2 : 1);
-			ilast0 = icur0;
-			icur0 = *inPtr++;
-			if (stereo) {
-				ilast1 = icur1;
-				icur1 = *inPtr++;
+
+			if (endOfInput)
+				break;
+
+			// Loop as long as the outpos trails behind, and as long as there is
+			// still space in the intermediate buffer.
+			while (opos < (frac_t)FRAC_ONE && frames < numFrames) {
+				// interpolate
+				if (stereo) {
+					out[reverseStereo    ] = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF) >> FRAC_BITS));
+					out[reverseStereo ^ 1] = (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF) >> FRAC_BITS));
+					out += 2;
+				} else {
+					*out++ = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF) >> FRAC_BITS));
+				}
+				++frames;
+
+				// Increment output position
+				opos += opos_inc;
 			}
-			opos -= FRAC_ONE;
 		}
 
-		// Loop as long as the outpos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (opos < (frac_t)FRAC_ONE && obuf < oend) {
-			// interpolate
-			st_sample_t out0, out1;
-			out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF) >> FRAC_BITS));
-			out1 = (stereo ?
-						  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF) >> FRAC_BITS)) :
-						  out0);
-
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
-
-			// Increment output position
-			opos += opos_inc;
-		}
+		mixFrames<stereo, reverseStereo>(obuf + done * 2, outBuf, frames, vol_l, vol_r);
+		done += frames;
 	}
-	return (obuf - ostart) / 2;
+	return done;
 }
 
 
@@ -286,8 +560,6 @@ public:
 		st_sample_t *ptr;
 		st_size_t len;
 
-		st_sample_t *ostart = obuf;
-
 		if (stereo)
 			osamp *= 2;
 
@@ -304,22 +576,18 @@ public:
 		// Read up to 'osamp' samples into our temporary buffer
 		len = input.readBuffer(_buffer, osamp);
 
-		// Mix the data into the output buffer
-		ptr = _buffer;
-		for (; len > 0; len -= (stereo ? 2 : 1)) {
-			st_sample_t out0, out1;
-			out0 = *ptr++;
-			out1 = (stereo ? *ptr++ : out0);
-
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+		const st_size_t numFrames = len / (stereo ? 2 : 1);
 
-			obuf += 2;
+		// Bring the channels into output order
+		if (reverseStereo) {
+			ptr = _buffer;
+			for (st_size_t i = 0; i < numFrames; ++i, ptr += 2)
+				SWAP(ptr[0], ptr[1]);
 		}
-		return (obuf - ostart) / 2;
+
+		// Mix the data into the output buffer
+		mixFrames<stereo, reverseStereo>(obuf, _buffer, numFrames, vol_l, vol_r);
+		return numFrames;
 	}
 
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
@@ -347,6 +615,8 @@ RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
  * Create and return a RateConverter object for the specified input and output rates.
  */
 RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+	initMixProcs();
+
 	if (stereo) {
 		if (reverseStereo)
 			return makeRateConverter<true, true>(inrate, outrate);
@@ -958,6 +958,7 @@ private:
 #endif
 
 	OPL::OPL *_opl;
+	OPL::WriteQueue _writeQueue;
 	byte *_regCache;
 #ifdef ENABLE_OPL3
 	byte *_regCacheSecondary;
@@ -1411,6 +1412,10 @@ int MidiDriver_ADLIB::open() {
 
 	MidiDriver_Emulated::open();
 
+	// Run the ticks of a whole buffer before rendering it, so that it is
+	// only split where registers change
+	setBatchTicks(true);
+
 	int i;
 	AdLibVoice *voice;
 
@@ -1597,7 +1602,10 @@ void MidiDriver_ADLIB::adlibWrite(byte reg, byte value) {
 #endif
 	_regCache[reg] = value;
 
-	_opl->writeReg(reg, value);
+	if (getTickSample() >= 0)
+		_writeQueue.push(getTickSample(), reg, value);
+	else
+		_opl->writeReg(reg, value);
 }
 
 #ifdef ENABLE_OPL3
@@ -1612,15 +1620,15 @@ void MidiDriver_ADLIB::adlibWriteSecondary(byte reg, byte value) {
 #endif
 	_regCacheSecondary[reg] = value;
 
-	_opl->writeReg(reg | 0x100, value);
+	if (getTickSample() >= 0)
+		_writeQueue.push(getTickSample(), reg | 0x100, value);
+	else
+		_opl->writeReg(reg | 0x100, value);
 }
 #endif
 
 void MidiDriver_ADLIB::generateSamples(int16 *data, int len) {
-	if (_opl->isStereo()) {
-		len *= 2;
-	}
-	_opl->readBuffer(data, len);
+	_writeQueue.render(_opl, data, len);
 }
 
 void MidiDriver_ADLIB::onTimer() {
@@ -44,12 +44,29 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	bool _batchTicks;
+	int _tickSample;
+
 protected:
 	int _baseFreq;
 
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
+	/**
+	 * Make readBuffer() run all timer ticks due within a buffer first, and
+	 * then call generateSamples() once for the whole buffer. The driver has
+	 * to hold back the effect of each tick until getTickSample() samples of
+	 * the buffer are generated.
+	 */
+	void setBatchTicks(bool batch) { _batchTicks = batch; }
+
+	/**
+	 * Return the sample of the buffer to be generated at which the running
+	 * timer tick takes effect, or -1 outside of batched timer ticks.
+	 */
+	int getTickSample() const { return _tickSample; }
+
 public:
 	MidiDriver_Emulated(Audio::Mixer *mixer) :
 		_mixer(mixer),
@@ -58,6 +75,8 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_batchTicks(false),
+		_tickSample(-1),
 		_baseFreq(250) {
 	}
 
@@ -93,6 +112,32 @@ public:
 		int len = numSamples / stereoFactor;
 		int step;
 
+		if (_batchTicks) {
+			int pos = 0;
+
+			do {
+				step = len - pos;
+				if (step > (_nextTick >> FIXP_SHIFT))
+					step = (_nextTick >> FIXP_SHIFT);
+
+				pos += step;
+				_nextTick -= step << FIXP_SHIFT;
+				if (!(_nextTick >> FIXP_SHIFT)) {
+					_tickSample = pos;
+					if (_timerProc)
+						(*_timerProc)(_timerParam);
+
+					onTimer();
+					_tickSample = -1;
+
+					_nextTick += _samplesPerTick;
+				}
+			} while (pos < len);
+
+			generateSamples(data, len);
+			return numSamples;
+		}
+
 		do {
 			step = len;
 			if (step > (_nextTick >> FIXP_SHIFT))
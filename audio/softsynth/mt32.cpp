@@ -32,12 +32,15 @@
 #include "audio/musicplugin.h"
 #include "audio/mpu401.h"
 
+#include "common/atomic.h"
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/error.h"
 #include "common/events.h"
 #include "common/file.h"
+#include "common/mutex.h"
 #include "common/system.h"
+#include "common/timer.h"
 #include "common/util.h"
 #include "common/archive.h"
 #include "common/textconsole.h"
@@ -102,6 +105,27 @@ private:
 
 	int _outputRate;
 
+	// Render ahead mode: the synth (and the MIDI timer callbacks, so the
+	// events stay sample accurate) is only ever run from a timer proc, and
+	// the mixer only copies the samples out of the FIFO below. When the FIFO
+	// runs dry, the mixer plays silence instead of rendering by itself.
+	int16 *_fifo;
+	uint32 _fifoSize;			// in samples, a multiple of 2
+	uint32 _fifoLatency;		// number of samples to render ahead
+	volatile uint32 _fifoRead;	// only written by the consumer
+	volatile uint32 _fifoWrite;	// only written by the producer
+	uint32 _fifoUnderruns;
+
+	// MIDI events are not played directly but pushed into the timestamped
+	// event queue of the synth, which is processed while rendering. The
+	// queue only supports a single producer, so this serializes the
+	// different threads sending events. Never call anything else while
+	// holding it.
+	Common::Mutex _midiMutex;
+
+	static void renderAheadProc(void *refCon);
+	void fillFifo(uint32 numSamples);
+
 protected:
 	void generateSamples(int16 *buf, int len);
 
@@ -122,6 +146,7 @@ public:
 	MidiChannel *getPercussionChannel();
 
 	// AudioStream API
+	int readBuffer(int16 *data, const int numSamples);
 	bool isStereo() const { return true; }
 	int getRate() const { return _outputRate; }
 };
@@ -151,6 +176,13 @@ MidiDriver_MT32::MidiDriver_MT32(Audio::Mixer *mixer) : MidiDriver_Emulated(mixe
 	_pcmROM = NULL;
 	_controlFile = NULL;
 	_pcmFile = NULL;
+
+	_fifo = NULL;
+	_fifoSize = 0;
+	_fifoLatency = 0;
+	_fifoRead = 0;
+	_fifoWrite = 0;
+	_fifoUnderruns = 0;
 }
 
 MidiDriver_MT32::~MidiDriver_MT32() {
@@ -222,12 +254,85 @@ int MidiDriver_MT32::open() {
 
 	g_system->updateScreen();
 
+	int renderAhead = ConfMan.getInt("mt32_render_ahead");
+	if (renderAhead > 0) {
+		// Anything shorter than a few timer ticks would just underrun
+		renderAhead = CLIP(renderAhead, 40, 1000);
+		_fifoLatency = (uint32)(renderAhead * _outputRate / 1000) * 2;
+		// Leave room for a mixer callback's worth of samples on top
+		_fifoSize = _fifoLatency + 8192;
+		_fifo = new int16[_fifoSize];
+		_fifoRead = 0;
+		_fifoWrite = 0;
+		_fifoUnderruns = 0;
+
+		// Render ahead first, then keep the FIFO topped up four times per
+		// latency, so it never drains by more than a quarter between ticks
+		fillFifo(_fifoLatency);
+		g_system->getTimerManager()->installTimerProc(renderAheadProc, MAX(renderAhead * 250, 10000), this, "MT32RenderAhead");
+	}
+
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
 	return 0;
 }
 
+void MidiDriver_MT32::renderAheadProc(void *refCon) {
+	MidiDriver_MT32 *driver = (MidiDriver_MT32 *)refCon;
+	const uint32 queued = driver->_fifoWrite - Common::atomicLoad(driver->_fifoRead);
+	if (queued < driver->_fifoLatency)
+		driver->fillFifo(driver->_fifoLatency - queued);
+}
+
+void MidiDriver_MT32::fillFifo(uint32 numSamples) {
+	// Only called from open() and renderAheadProc(), so this is the only
+	// place the synth gets rendered and no locking is needed
+	// Clip to the free space, which may have changed in the meantime
+	const uint32 writePos = _fifoWrite;
+	const uint32 space = _fifoSize - (writePos - Common::atomicLoad(_fifoRead));
+	numSamples = MIN(numSamples, space) & ~1;
+	if (!numSamples)
+		return;
+
+	const uint32 offset = writePos % _fifoSize;
+	const uint32 firstPart = MIN(numSamples, _fifoSize - offset);
+	MidiDriver_Emulated::readBuffer(_fifo + offset, firstPart);
+	if (firstPart < numSamples)
+		MidiDriver_Emulated::readBuffer(_fifo, numSamples - firstPart);
+
+	Common::atomicStore(_fifoWrite, writePos + numSamples);
+}
+
+int MidiDriver_MT32::readBuffer(int16 *data, const int numSamples) {
+	if (!_fifo)
+		return MidiDriver_Emulated::readBuffer(data, numSamples);
+
+	uint32 remaining = numSamples;
+	while (remaining > 0) {
+		const uint32 readPos = _fifoRead;
+		const uint32 queued = Common::atomicLoad(_fifoWrite) - readPos;
+		if (!queued) {
+			// Underrun: play silence rather than rendering on the mixer
+			// thread, the timer proc will catch up on its next run
+			memset(data, 0, remaining * sizeof(int16));
+			_fifoUnderruns++;
+			break;
+		}
+
+		const uint32 offset = readPos % _fifoSize;
+		const uint32 count = MIN(MIN(queued, remaining), _fifoSize - offset);
+		memcpy(data, _fifo + offset, count * sizeof(int16));
+		Common::atomicStore(_fifoRead, readPos + count);
+
+		data += count;
+		remaining -= count;
+	}
+
+	return numSamples;
+}
+
 void MidiDriver_MT32::send(uint32 b) {
+	Common::StackLock lock(_midiMutex);
 	_synth->playMsg(b);
 }
 
@@ -250,9 +355,20 @@ void MidiDriver_MT32::setPitchBendRange(byte channel, uint range) {
 
 void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 	if (msg[0] == 0xf0) {
+		Common::StackLock lock(_midiMutex);
 		_synth->playSysex(msg, length);
 	} else {
-		_synth->playSysexWithoutFraming(msg, length);
+		// playSysexWithoutFraming() bypasses the event queue and would touch
+		// the synth state while it is rendering, so add the framing instead
+		byte *framed = new byte[length + 2];
+		framed[0] = 0xf0;
+		memcpy(framed + 1, msg, length);
+		framed[length + 1] = 0xf7;
+		{
+			Common::StackLock lock(_midiMutex);
+			_synth->playSysex(framed, length + 2);
+		}
+		delete[] framed;
 	}
 }
 
@@ -261,11 +377,22 @@ void MidiDriver_MT32::close() {
 		return;
 	_isOpen = false;
 
+	// Stop rendering ahead first, this waits for a running renderAheadProc()
+	if (_fifo)
+		g_system->getTimerManager()->removeTimerProc(renderAheadProc);
 	// Detach the player callback handler
 	setTimerCallback(NULL, NULL);
-	// Detach the mixer callback handler
+	// Detach the mixer callback handler, the mixer does not touch the
+	// stream anymore once this returns
 	_mixer->stopHandle(_mixerSoundHandle);
 
+	if (_fifo) {
+		if (_fifoUnderruns)
+			debug(2, "MT-32 render ahead FIFO ran dry %d times", _fifoUnderruns);
+		delete[] _fifo;
+		_fifo = NULL;
+	}
+
 	_synth->close();
 	deleteMuntStructures();
 }
@@ -159,6 +159,13 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Returns the time the object referred by this path was last modified,
+	 * in seconds since an arbitrary but fixed point in time.
+	 *
+	 * @return the modification time, or 0 if it is not known
+	 */
+	virtual uint32 getModificationTime() const { return 0; }
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -96,7 +96,7 @@ void SdlMixerManager::init() {
 			error("SDL mixer output requires stereo output device");
 #endif
 
-		_mixer = new Audio::MixerImpl(g_system, _obtained.freq);
+		_mixer = new Audio::MixerImpl(g_system, _obtained.freq, ConfMan.getBool("mixer_command_queue"));
 		assert(_mixer);
 		_mixer->setReady(true);
 
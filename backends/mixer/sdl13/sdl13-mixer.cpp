@@ -73,7 +73,7 @@ void Sdl13MixerManager::init() {
 	} else {
 		debug(1, "Output sample rate: %d Hz", _obtained.freq);
 
-		_mixer = new Audio::MixerImpl(g_system, _obtained.freq);
+		_mixer = new Audio::MixerImpl(g_system, _obtained.freq, ConfMan.getBool("mixer_command_queue"));
 		assert(_mixer);
 		_mixer->setReady(true);
 
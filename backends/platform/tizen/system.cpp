@@ -91,6 +91,7 @@ bool TizenSaveFileManager::removeSavefile(const Common::String &filename) {
 	// recreate FSNode since checkPath may have changed/created the directory
 	Common::FSNode savePath(savePathName);
 	Common::FSNode file = savePath.getChild(filename);
+	markChanged(filename);
 
 	String unicodeFileName;
 	StringUtil::Utf8ToString(file.getPath().c_str(), unicodeFileName);
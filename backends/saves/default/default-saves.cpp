@@ -31,19 +31,188 @@
 #include "common/fs.h"
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/memstream.h"
+#include "common/textconsole.h"
 #include "common/zlib.h"
 
 #ifndef _WIN32_WCE
 #include <errno.h>	// for removeSavefile()
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+static const uint32 kMetaDataIndexVersion = 1;
+
+static Common::String getMetaDataIndexFilename(const Common::String &index) {
+	// The savefile patterns of most engines start with the target name, so
+	// don't start with it here
+	return "metainfo-" + index + ".idx";
+}
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _changeCounter(1), _metaDataIndexDirty(false) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) : _changeCounter(1), _metaDataIndexDirty(false) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+void DefaultSaveFileManager::markChanged(const Common::String &filename) {
+	if (++_changeCounter == 0)
+		_changeCounter = 1;
+
+	_changedSavefiles[filename] = true;
+	if (_metaDataIndex.contains(filename)) {
+		_metaDataIndex.erase(filename);
+		_metaDataIndexDirty = true;
+	}
+}
+
+bool DefaultSaveFileManager::getSavefileStamp(const Common::String &filename, uint32 &size, uint32 &modificationTime) {
+	Common::FSNode file = Common::FSNode(getSavePath()).getChild(filename);
+	if (!file.exists() || file.isDirectory())
+		return false;
+
+	// Without modification times, changes made outside of ScummVM could go
+	// unnoticed
+	modificationTime = file.getModificationTime();
+	if (!modificationTime)
+		return false;
+
+	Common::SeekableReadStream *stream = file.createReadStream();
+	if (!stream)
+		return false;
+
+	size = stream->size();
+	delete stream;
+	return true;
+}
+
+void DefaultSaveFileManager::loadMetaDataIndex(const Common::String &index) {
+	if (index == _metaDataIndexName)
+		return;
+
+	flushSavefileMetaData();
+	_metaDataIndex.clear();
+	_metaDataIndexName = index;
+	_metaDataIndexDirty = false;
+
+	Common::FSNode file = Common::FSNode(getSavePath()).getChild(getMetaDataIndexFilename(index));
+	if (!file.exists())
+		return;
+
+	Common::SeekableReadStream *in = file.createReadStream();
+	if (!in)
+		return;
+
+	if (in->readUint32BE() != MKTAG('S', 'M', 'D', 'I') || in->readUint32BE() != kMetaDataIndexVersion) {
+		delete in;
+		return;
+	}
+
+	const uint32 count = in->readUint32BE();
+	for (uint32 i = 0; i < count && !in->eos() && !in->err(); i++) {
+		Common::String filename;
+		const uint32 nameLength = in->readUint32BE();
+		for (uint32 j = 0; j < nameLength; j++)
+			filename += (char)in->readByte();
+
+		MetaDataEntry entry;
+		entry.size = in->readUint32BE();
+		entry.modificationTime = in->readUint32BE();
+		entry.data.resize(in->readUint32BE());
+		if (entry.data.size() > (uint32)(in->size() - in->pos()))
+			break;
+		if (!entry.data.empty())
+			in->read(&entry.data[0], entry.data.size());
+
+		if (_changedSavefiles.contains(filename))
+			_metaDataIndexDirty = true;
+		else
+			_metaDataIndex[filename] = entry;
+	}
+
+	delete in;
+}
+
+Common::SeekableReadStream *DefaultSaveFileManager::loadSavefileMetaData(const Common::String &index, const Common::String &filename) {
+	// Nothing may be cached if changes are not tracked
+	if (!getChangeCounter())
+		return 0;
+
+	loadMetaDataIndex(index);
+
+	MetaDataEntryMap::iterator i = _metaDataIndex.find(filename);
+	if (i == _metaDataIndex.end())
+		return 0;
+
+	uint32 size, modificationTime;
+	if (!getSavefileStamp(filename, size, modificationTime) || size != i->_value.size || modificationTime != i->_value.modificationTime) {
+		_metaDataIndex.erase(i);
+		_metaDataIndexDirty = true;
+		return 0;
+	}
+
+	const Common::Array<byte> &data = i->_value.data;
+	byte *buffer = (byte *)malloc(MAX<uint32>(data.size(), 1));
+	if (!data.empty())
+		memcpy(buffer, &data[0], data.size());
+
+	return new Common::MemoryReadStream(buffer, data.size(), DisposeAfterUse::YES);
+}
+
+void DefaultSaveFileManager::storeSavefileMetaData(const Common::String &index, const Common::String &filename, const byte *data, uint32 size) {
+	if (!getChangeCounter())
+		return;
+
+	MetaDataEntry entry;
+	if (!getSavefileStamp(filename, entry.size, entry.modificationTime))
+		return;
+
+	entry.data = Common::Array<byte>(data, size);
+
+	loadMetaDataIndex(index);
+	_metaDataIndex[filename] = entry;
+	_metaDataIndexDirty = true;
+	_changedSavefiles.erase(filename);
+}
+
+void DefaultSaveFileManager::flushSavefileMetaData() {
+	if (!_metaDataIndexDirty)
+		return;
+
+	_metaDataIndexDirty = false;
+
+	Common::String savePathName = getSavePath();
+	checkPath(Common::FSNode(savePathName));
+	if (getError().getCode() != Common::kNoError)
+		return;
+
+	// Not written through openForSaving(), this is no savefile change
+	Common::FSNode file = Common::FSNode(savePathName).getChild(getMetaDataIndexFilename(_metaDataIndexName));
+	Common::WriteStream *out = file.createWriteStream();
+	if (!out) {
+		warning("Could not write the savefile meta data index '%s'", file.getName().c_str());
+		return;
+	}
+
+	out->writeUint32BE(MKTAG('S', 'M', 'D', 'I'));
+	out->writeUint32BE(kMetaDataIndexVersion);
+	out->writeUint32BE(_metaDataIndex.size());
+
+	for (MetaDataEntryMap::const_iterator i = _metaDataIndex.begin(); i != _metaDataIndex.end(); ++i) {
+		out->writeUint32BE(i->_key.size());
+		out->writeString(i->_key);
+		out->writeUint32BE(i->_value.size);
+		out->writeUint32BE(i->_value.modificationTime);
+		out->writeUint32BE(i->_value.data.size());
+		if (!i->_value.data.empty())
+			out->write(&i->_value.data[0], i->_value.data.size());
+	}
+
+	out->finalize();
+	if (out->err())
+		warning("Could not write the savefile meta data index '%s'", file.getName().c_str());
+	delete out;
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -111,6 +280,7 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 
 	// Open the file for saving
 	Common::WriteStream *sf = file.createWriteStream();
+	markChanged(filename);
 
 	return compress ? Common::wrapCompressedWriteStream(sf) : sf;
 }
@@ -125,6 +295,7 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	Common::FSNode savePath(savePathName);
 
 	Common::FSNode file = savePath.getChild(filename);
+	markChanged(filename);
 
 	// FIXME: remove does not exist on all systems. If your port fails to
 	// compile because of this, please let us know (scummvm-devel or Fingolfin).
@@ -27,6 +27,8 @@
 #include "common/savefile.h"
 #include "common/str.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
+#include "common/array.h"
 
 /**
  * Provides a default savefile manager implementation for common platforms.
@@ -40,6 +42,10 @@ public:
 	virtual Common::InSaveFile *openForLoading(const Common::String &filename);
 	virtual Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true);
 	virtual bool removeSavefile(const Common::String &filename);
+	virtual uint32 getChangeCounter() const { return _changeCounter; }
+	virtual Common::SeekableReadStream *loadSavefileMetaData(const Common::String &index, const Common::String &filename);
+	virtual void storeSavefileMetaData(const Common::String &index, const Common::String &filename, const byte *data, uint32 size);
+	virtual void flushSavefileMetaData();
 
 protected:
 	/**
@@ -54,6 +60,48 @@ protected:
 	 * Sets the internal error and error message accordingly.
 	 */
 	virtual void checkPath(const Common::FSNode &dir);
+
+	/**
+	 * Incremented whenever a savefile is opened for saving or removed.
+	 * Never 0, since that means changes are not tracked.
+	 */
+	uint32 _changeCounter;
+
+	/**
+	 * Called whenever the given savefile is opened for saving or removed.
+	 */
+	void markChanged(const Common::String &filename);
+
+	/**
+	 * Meta data stored for a savefile, along with the size and modification
+	 * time the savefile had at that point.
+	 */
+	struct MetaDataEntry {
+		uint32 size;
+		uint32 modificationTime;
+		Common::Array<byte> data;
+	};
+
+	typedef Common::HashMap<Common::String, MetaDataEntry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> MetaDataEntryMap;
+	typedef Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SavefileSet;
+
+	/**
+	 * Only one meta data index, usually the one of the target shown in the
+	 * save/load dialog, is kept in memory.
+	 */
+	Common::String _metaDataIndexName;
+	MetaDataEntryMap _metaDataIndex;
+	bool _metaDataIndexDirty;
+
+	/**
+	 * Savefiles written or removed in this session. Their entries are
+	 * dropped from indexes which are loaded later on, since a change within
+	 * the same second might leave the size and modification time unchanged.
+	 */
+	SavefileSet _changedSavefiles;
+
+	bool getSavefileStamp(const Common::String &filename, uint32 &size, uint32 &modificationTime);
+	void loadMetaDataIndex(const Common::String &index);
 };
 
 #endif
@@ -31,6 +31,9 @@
 class RecorderSaveFileManager : public DefaultSaveFileManager {
 	virtual Common::StringArray listSaveFiles(const Common::String &pattern);
 	virtual Common::InSaveFile *openForLoading(const Common::String &filename);
+
+	// The recorded savefiles differ from the ones on disk, so nothing may be cached
+	virtual uint32 getChangeCounter() const { return 0; }
 };
 
 #endif
@@ -34,48 +34,89 @@ struct TimerSlot {
 	uint32 nextFireTime;	// in milliseconds
 	uint32 nextFireTimeMicro;	// microseconds part of nextFire
 
-	TimerSlot *next;
+	Common::TimerManager::TimerStats stats;
 };
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
-
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = 0;
+/**
+ * Check whether slot a is due before slot b. The millisecond counter may
+ * wrap around, hence the comparison of the signed difference.
+ */
+static inline bool firesBefore(const TimerSlot *a, const TimerSlot *b) {
+	const int32 diff = (int32)(a->nextFireTime - b->nextFireTime);
+	return diff < 0 || (diff == 0 && a->nextFireTimeMicro < b->nextFireTimeMicro);
+}
 
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == 0 || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
-	}
+static void resetStats(TimerSlot *slot) {
+	Common::TimerManager::TimerStats &stats = slot->stats;
+	stats.id = slot->id;
+	stats.interval = slot->interval;
+	stats.calls = 0;
+	stats.totalDuration = 0;
+	stats.maxDuration = 0;
+	stats.totalLateness = 0;
+	stats.maxLateness = 0;
+	stats.overruns = 0;
 }
 
 
 DefaultTimerManager::DefaultTimerManager() :
-	_head(0) {
-
-	_head = new TimerSlot();
-	memset(_head, 0, sizeof(TimerSlot));
+	_runningSlot(0) {
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
+	for (uint i = 0; i < _heap.size(); ++i)
+		delete _heap[i];
+	_heap.clear();
+}
+
+void DefaultTimerManager::siftUp(uint index) {
+	TimerSlot *slot = _heap[index];
+
+	while (index > 0) {
+		const uint parent = (index - 1) / 2;
+		if (!firesBefore(slot, _heap[parent]))
+			break;
+		_heap[index] = _heap[parent];
+		index = parent;
+	}
+
+	_heap[index] = slot;
+}
+
+void DefaultTimerManager::siftDown(uint index) {
+	TimerSlot *slot = _heap[index];
+	const uint size = _heap.size();
+
+	while (true) {
+		uint child = index * 2 + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && firesBefore(_heap[child + 1], _heap[child]))
+			++child;
+		if (!firesBefore(_heap[child], slot))
+			break;
+		_heap[index] = _heap[child];
+		index = child;
+	}
+
+	_heap[index] = slot;
+}
+
+void DefaultTimerManager::removeAt(uint index) {
+	if (_heap[index] == _runningSlot)
+		_runningSlot = 0;
+	delete _heap[index];
+
+	// Move the last slot into the gap and restore the heap property
+	TimerSlot *last = _heap.back();
+	_heap.pop_back();
+	if (index < _heap.size()) {
+		_heap[index] = last;
+		siftUp(index);
+		siftDown(index);
 	}
-	_head = 0;
 }
 
 void DefaultTimerManager::handler() {
@@ -84,28 +125,45 @@ void DefaultTimerManager::handler() {
 	uint32 curTime = g_system->getMillis(true);
 
 	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
-
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
+	while (!_heap.empty() && (int32)(_heap[0]->nextFireTime - curTime) < 0) {
+		TimerSlot *slot = _heap[0];
+
+		// Keep track of how late this invocation is. Note that timers with
+		// intervals below the backend's timer resolution are always late.
+		const uint32 lateMillis = curTime - slot->nextFireTime;
+		const uint32 lateness = (lateMillis < 0xFFFFFFFF / 1000) ? lateMillis * 1000 - slot->nextFireTimeMicro : 0xFFFFFFFF;
+		slot->stats.totalLateness += lateness;
+		slot->stats.maxLateness = MAX(slot->stats.maxLateness, lateness);
+
+		// Update the fire time and move the TimerSlot to its new place in
+		// the priority queue. The microseconds part is carried over, so
+		// intervals which are not a multiple of one millisecond do not drift.
 		assert(slot->interval > 0);
 		slot->nextFireTime += (slot->interval / 1000);
 		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
+		if (slot->nextFireTimeMicro >= 1000) {
 			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
 			slot->nextFireTimeMicro %= 1000;
 		}
-		insertPrioQueue(_head, slot);
+		siftDown(0);
 
-		// Invoke the timer callback
+		// Invoke the timer callback. The callback may remove its own timer,
+		// in which case removeAt() resets _runningSlot and the statistics
+		// are not updated.
 		assert(slot->callback);
+		_runningSlot = slot;
+		const uint32 startTime = g_system->getMillis(true);
 		slot->callback(slot->refCon);
-
-		// Look at the next scheduled timer
-		slot = _head->next;
+		const uint32 duration = g_system->getMillis(true) - startTime;
+
+		if (_runningSlot == slot) {
+			slot->stats.calls++;
+			slot->stats.totalDuration += duration;
+			slot->stats.maxDuration = MAX(slot->stats.maxDuration, duration);
+			if (duration * 1000 > slot->interval)
+				slot->stats.overruns++;
+		}
+		_runningSlot = 0;
 	}
 }
 
@@ -134,9 +192,10 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	slot->interval = interval;
 	slot->nextFireTime = g_system->getMillis() + interval / 1000;
 	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = 0;
+	resetStats(slot);
 
-	insertPrioQueue(_head, slot);
+	_heap.push_back(slot);
+	siftUp(_heap.size() - 1);
 
 	return true;
 }
@@ -144,16 +203,11 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
-		} else {
-			slot = slot->next;
-		}
+	for (uint i = 0; i < _heap.size(); ) {
+		if (_heap[i]->callback == callback)
+			removeAt(i);
+		else
+			++i;
 	}
 
 	// We need to remove all names referencing the timer proc here.
@@ -173,3 +227,18 @@ void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 			_callbacks.erase(i);
 	}
 }
+
+void DefaultTimerManager::getTimerStats(TimerStatsList &stats) {
+	Common::StackLock lock(_mutex);
+
+	stats.clear();
+	for (uint i = 0; i < _heap.size(); ++i)
+		stats.push_back(_heap[i]->stats);
+}
+
+void DefaultTimerManager::resetTimerStats() {
+	Common::StackLock lock(_mutex);
+
+	for (uint i = 0; i < _heap.size(); ++i)
+		resetStats(_heap[i]);
+}
@@ -23,6 +23,7 @@
 #ifndef BACKENDS_TIMER_DEFAULT_H
 #define BACKENDS_TIMER_DEFAULT_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/hash-str.h"
 #include "common/timer.h"
@@ -35,14 +36,28 @@ private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
 	Common::Mutex _mutex;
-	TimerSlot *_head;
+
+	/**
+	 * The installed timers, organized as a binary min-heap on their next
+	 * fire time. The timer to fire next is always at index 0.
+	 */
+	Common::Array<TimerSlot *> _heap;
 	TimerSlotMap _callbacks;
 
+	/** The slot whose callback is being invoked by handler(), if any */
+	TimerSlot *_runningSlot;
+
+	void siftUp(uint index);
+	void siftDown(uint index);
+	void removeAt(uint index);
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
 	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon, const Common::String &id);
 	virtual void removeTimerProc(TimerProc proc);
+	virtual void getTimerStats(TimerStatsList &stats);
+	virtual void resetTimerStats();
 
 	/**
 	 * Timer callback, to be invoked at regular time intervals by the backend.
@@ -0,0 +1,75 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_ATOMIC_H
+#define COMMON_ATOMIC_H
+
+#include "common/scummsys.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Common {
+
+/**
+ * Issue a full memory barrier: no memory access is reordered across it, by
+ * either the compiler or the CPU.
+ *
+ * On toolchains for which no barrier primitive is known, this only relies on
+ * the compiler not reordering accesses to volatile variables. That suffices
+ * for the single core targets those toolchains are used for.
+ */
+inline void memoryBarrier() {
+#if defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1))
+	__sync_synchronize();
+#elif defined(_MSC_VER)
+	_ReadWriteBarrier();
+	MemoryBarrier();
+#endif
+}
+
+/**
+ * Read a variable shared with another thread. Memory accesses after the load
+ * are not moved before it, so data published by a matching atomicStore() in
+ * the other thread is visible once the stored value has been seen.
+ */
+template<typename T>
+inline T atomicLoad(const volatile T &var) {
+	T value = var;
+	memoryBarrier();
+	return value;
+}
+
+/**
+ * Write a variable shared with another thread. Memory accesses before the
+ * store are completed before the new value becomes visible.
+ */
+template<typename T>
+inline void atomicStore(volatile T &var, T value) {
+	memoryBarrier();
+	var = value;
+}
+
+} // End of namespace Common
+
+#endif
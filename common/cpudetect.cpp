@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/cpudetect.h"
+
+#if defined(_MSC_VER) && defined(SCUMMVM_SSE2)
+#include <intrin.h>
+#endif
+
+namespace Common {
+
+namespace {
+
+#if defined(SCUMMVM_SSE2)
+
+enum {
+	kUnknown = -1
+};
+
+int s_hasSSE2 = kUnknown;
+int s_hasAVX2 = kUnknown;
+
+void detectX86Features() {
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	const int maxLeaf = info[0];
+
+	__cpuid(info, 1);
+	s_hasSSE2 = (info[3] >> 26) & 1;
+
+	// AVX2 also requires the OS to save the YMM registers
+	s_hasAVX2 = 0;
+	const bool osxsave = (info[2] >> 27) & 1;
+	if (maxLeaf >= 7 && osxsave && (_xgetbv(0) & 6) == 6) {
+		__cpuidex(info, 7, 0);
+		s_hasAVX2 = (info[1] >> 5) & 1;
+	}
+#else
+	// This takes care of the OS support check for AVX2, too
+	__builtin_cpu_init();
+	s_hasSSE2 = __builtin_cpu_supports("sse2") ? 1 : 0;
+	s_hasAVX2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+#endif
+}
+
+#endif
+
+} // End of anonymous namespace
+
+bool hasCpuFeature(CpuFeature feature) {
+	switch (feature) {
+#if defined(SCUMMVM_SSE2)
+	case kCpuFeatureSSE2:
+		if (s_hasSSE2 == kUnknown)
+			detectX86Features();
+		return s_hasSSE2 != 0;
+
+	case kCpuFeatureAVX2:
+		if (s_hasAVX2 == kUnknown)
+			detectX86Features();
+		return s_hasAVX2 != 0;
+#endif
+
+#if defined(SCUMMVM_NEON)
+	case kCpuFeatureNEON:
+		// Only enabled if the whole build targets NEON
+		return true;
+#endif
+
+	default:
+		return false;
+	}
+}
+
+} // End of namespace Common
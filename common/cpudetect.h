@@ -0,0 +1,75 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_CPUDETECT_H
+#define COMMON_CPUDETECT_H
+
+#include "common/scummsys.h"
+
+/**
+ * @file
+ * Support for code paths using SIMD instruction set extensions.
+ *
+ * SCUMMVM_SSE2, SCUMMVM_AVX2 and SCUMMVM_NEON are defined if the compiler
+ * can generate code for the respective extension. SSE2 and AVX2 functions
+ * are compiled for the extension on a per function basis, so they have to be
+ * marked with SCUMMVM_TARGET_SSE2 / SCUMMVM_TARGET_AVX2, and must only be
+ * called after Common::hasCpuFeature() confirmed the running CPU supports
+ * them. NEON code is only enabled when the whole build targets NEON.
+ */
+
+#if !defined(DISABLE_SIMD) && (defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64))
+	#if defined(_MSC_VER) && _MSC_VER >= 1700
+		#define SCUMMVM_SSE2
+		#define SCUMMVM_AVX2
+		#define SCUMMVM_TARGET_SSE2
+		#define SCUMMVM_TARGET_AVX2
+	#elif defined(__clang__) ? (__clang_major__ > 3 || (__clang_major__ == 3 && __clang_minor__ >= 8)) \
+	                         : (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+		#define SCUMMVM_SSE2
+		#define SCUMMVM_AVX2
+		#define SCUMMVM_TARGET_SSE2 __attribute__((target("sse2")))
+		#define SCUMMVM_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#endif
+
+#if !defined(DISABLE_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+	#define SCUMMVM_NEON
+#endif
+
+namespace Common {
+
+enum CpuFeature {
+	kCpuFeatureSSE2,
+	kCpuFeatureAVX2,
+	kCpuFeatureNEON
+};
+
+/**
+ * Check whether code for the given instruction set extension is part of this
+ * build, and the CPU (and operating system) we are running on supports it.
+ */
+bool hasCpuFeature(CpuFeature feature);
+
+} // End of namespace Common
+
+#endif
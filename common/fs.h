@@ -206,6 +206,15 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Returns the time the object referred by this node was last modified,
+	 * in seconds. Only differences between the returned values are
+	 * meaningful.
+	 *
+	 * @return the modification time, or 0 if the backend does not know it
+	 */
+	uint32 getModificationTime() const;
+
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
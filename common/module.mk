@@ -4,6 +4,7 @@ MODULE_OBJS := \
 	archive.o \
 	config-manager.o \
 	coroutines.o \
+	cpudetect.o \
 	dcl.o \
 	debug.o \
 	error.o \
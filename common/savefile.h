@@ -161,6 +161,41 @@ public:
 	 * @see Common::matchString()
 	 */
 	virtual StringArray listSavefiles(const String &pattern) = 0;
+
+	/**
+	 * Returns a counter which changes whenever a savefile is written or
+	 * removed. This allows to cache information read from savefiles, like
+	 * the meta infos shown in the save/load dialog.
+	 * @return the change counter, or 0 if changes are not tracked.
+	 */
+	virtual uint32 getChangeCounter() const { return 0; }
+
+	/**
+	 * Returns data which was stored for a savefile with
+	 * storeSavefileMetaData(), like the meta infos shown in the save/load
+	 * dialog, so that they do not have to be read from the savefile again.
+	 * Nothing is returned once the savefile was written or removed.
+	 * @param index		name of the index holding the data, e.g. the target
+	 * @param name		the name of the savefile
+	 * @return the stored data, or NULL if there is none
+	 */
+	virtual SeekableReadStream *loadSavefileMetaData(const String &index, const String &name) { return 0; }
+
+	/**
+	 * Stores data for a savefile, to be returned by loadSavefileMetaData().
+	 * The data is kept across sessions once flushSavefileMetaData() is
+	 * called.
+	 * @param index		name of the index holding the data, e.g. the target
+	 * @param name		the name of the savefile
+	 * @param data		the data to store
+	 * @param size		size of the data in bytes
+	 */
+	virtual void storeSavefileMetaData(const String &index, const String &name, const byte *data, uint32 size) {}
+
+	/**
+	 * Writes the savefile meta data stored since the last call to disk.
+	 */
+	virtual void flushSavefileMetaData() {}
 };
 
 } // End of namespace Common
@@ -0,0 +1,103 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_SPSCQUEUE_H
+#define COMMON_SPSCQUEUE_H
+
+#include "common/scummsys.h"
+#include "common/atomic.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * Fixed size, lock-free queue for passing items from exactly one producer
+ * thread to exactly one consumer thread.
+ *
+ * Neither push() nor pop() ever blocks; they fail instead when the queue is
+ * full or empty respectively. If several threads need to push, they have to
+ * serialize among themselves (e.g. with a Mutex), the consumer is still not
+ * affected by that.
+ *
+ * The queue holds up to SIZE - 1 items.
+ */
+template<class T, uint SIZE>
+class SPSCQueue : NonCopyable {
+public:
+	SPSCQueue() : _head(0), _tail(0) {}
+
+	/**
+	 * Append an item. May only be called from the producer thread.
+	 *
+	 * @return false if the queue is full
+	 */
+	bool push(const T &item) {
+		const uint tail = _tail;
+		const uint next = (tail + 1) % SIZE;
+		if (next == atomicLoad(_head))
+			return false;
+
+		_items[tail] = item;
+		atomicStore(_tail, next);
+		return true;
+	}
+
+	/**
+	 * Remove the oldest item. May only be called from the consumer thread.
+	 *
+	 * @return false if the queue is empty
+	 */
+	bool pop(T &item) {
+		const uint head = _head;
+		if (head == atomicLoad(_tail))
+			return false;
+
+		item = _items[head];
+		atomicStore(_head, (head + 1) % SIZE);
+		return true;
+	}
+
+	/**
+	 * Check whether the queue is empty. The result is only a snapshot if the
+	 * other thread is active.
+	 */
+	bool empty() const {
+		return atomicLoad(_head) == atomicLoad(_tail);
+	}
+
+	/**
+	 * Number of items in the queue. The result is only a snapshot if the
+	 * other thread is active.
+	 */
+	uint size() const {
+		return (atomicLoad(_tail) + SIZE - atomicLoad(_head)) % SIZE;
+	}
+
+private:
+	T _items[SIZE];
+	volatile uint _head; ///< Next item to pop, only written by the consumer
+	volatile uint _tail; ///< Next free slot, only written by the producer
+};
+
+} // End of namespace Common
+
+#endif
@@ -24,6 +24,7 @@
 #define COMMON_TIMER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/str.h"
 #include "common/noncopyable.h"
 
@@ -33,6 +34,22 @@ class TimerManager : NonCopyable {
 public:
 	typedef void (*TimerProc)(void *refCon);
 
+	/**
+	 * Usage statistics of an installed timer callback.
+	 */
+	struct TimerStats {
+		String id;
+		int32 interval;         ///< the interval of the timer (in microseconds)
+		uint32 calls;           ///< number of times the callback was invoked
+		uint32 totalDuration;   ///< time spent in the callback altogether (in milliseconds)
+		uint32 maxDuration;     ///< longest single invocation (in milliseconds)
+		uint32 totalLateness;   ///< sum of the invocation delays (in microseconds)
+		uint32 maxLateness;     ///< largest invocation delay (in microseconds)
+		uint32 overruns;        ///< invocations which took longer than the interval
+	};
+
+	typedef Array<TimerStats> TimerStatsList;
+
 	virtual ~TimerManager() {}
 
 	/**
@@ -55,6 +72,17 @@ public:
 	 * and no instance of this callback will be running anymore.
 	 */
 	virtual void removeTimerProc(TimerProc proc) = 0;
+
+	/**
+	 * Get the usage statistics of all installed timer callbacks. Timer
+	 * managers which do not keep track of them return an empty list.
+	 */
+	virtual void getTimerStats(TimerStatsList &stats) { stats.clear(); }
+
+	/**
+	 * Reset the usage statistics of all installed timer callbacks.
+	 */
+	virtual void resetTimerStats() {}
 };
 
 } // End of namespace Common
@@ -106,6 +106,10 @@ typedef struct {
 #include "common/fs.h"
 #include "common/unzip.h"
 #include "common/memstream.h"
+#include "common/substream.h"
+#include "common/array.h"
+#include "common/ptr.h"
+#include "common/textconsole.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -1420,6 +1424,212 @@ int unzGetGlobalComment(unzFile file, char *szComment, uLong uSizeBuf) {
 namespace Common {
 
 
+#ifdef USE_ZLIB
+
+/**
+ * A read stream which inflates a deflated archive member on demand.
+ *
+ * Every ZipStream keeps its own inflate state and its own position in the
+ * archive file, so any number of members may be open and read independently.
+ * While decompressing, a copy of the inflate state is stored roughly every
+ * CHECKPOINT_INTERVAL bytes of output; seek() restarts from the closest such
+ * checkpoint instead of from the start of the member.
+ *
+ * The stream reads from the archive file, so it must not outlive the
+ * ZipArchive it was created by.
+ */
+class ZipStream : public SeekableReadStream {
+private:
+	enum {
+		CHECKPOINT_INTERVAL = 1024 * 1024
+	};
+
+	struct Checkpoint {
+		uint32 uncompressedPos;
+		uint32 compressedPos;
+		z_stream state;
+	};
+
+	ScopedPtr<SeekableReadStream> _compressed;
+	z_stream _stream;
+	byte _buf[UNZ_BUFSIZE];
+	// zlib keeps a back pointer to the z_stream, so checkpoints must not move
+	Array<Checkpoint *> _checkpoints;
+
+	int _zlibErr;
+	uint32 _size;
+	uint32 _crcWait;
+	uLong _crc;
+	bool _crcValid;
+	bool _eos;
+
+	uint32 nextCheckpointPos() const {
+		return (_checkpoints.empty() ? 0 : _checkpoints.back()->uncompressedPos) + CHECKPOINT_INTERVAL;
+	}
+
+	void addCheckpoint() {
+		// Input which is still buffered is simply read again after a restore,
+		// so the checkpoint refers to the first byte inflate has not consumed.
+		Checkpoint *checkpoint = new Checkpoint();
+		checkpoint->uncompressedPos = _stream.total_out;
+		checkpoint->compressedPos = _compressed->pos() - _stream.avail_in;
+		if (inflateCopy(&checkpoint->state, &_stream) == Z_OK)
+			_checkpoints.push_back(checkpoint);
+		else
+			delete checkpoint;
+	}
+
+	bool restoreCheckpoint(Checkpoint *checkpoint) {
+		inflateEnd(&_stream);
+
+		if (checkpoint) {
+			_zlibErr = inflateCopy(&_stream, &checkpoint->state);
+			_compressed->seek(checkpoint->compressedPos, SEEK_SET);
+		} else {
+			_stream.zalloc = Z_NULL;
+			_stream.zfree = Z_NULL;
+			_stream.opaque = Z_NULL;
+			_zlibErr = inflateInit2(&_stream, -MAX_WBITS);
+			_compressed->seek(0, SEEK_SET);
+
+			// Reading from the very start allows verifying the CRC again
+			_crc = 0;
+			_crcValid = true;
+		}
+
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+		return _zlibErr == Z_OK;
+	}
+
+public:
+	ZipStream(SeekableReadStream *compressed, uint32 uncompressedSize, uint32 crc)
+	    : _compressed(compressed), _stream(), _zlibErr(Z_OK), _size(uncompressedSize),
+	      _crcWait(crc), _crc(0), _crcValid(true), _eos(false) {
+		assert(compressed);
+		restoreCheckpoint(0);
+	}
+
+	~ZipStream() {
+		inflateEnd(&_stream);
+		for (uint i = 0; i < _checkpoints.size(); ++i) {
+			inflateEnd(&_checkpoints[i]->state);
+			delete _checkpoints[i];
+		}
+	}
+
+	bool err() const { return (_zlibErr != Z_OK) && (_zlibErr != Z_STREAM_END); }
+	void clearErr() {
+		// only reset _eos; inflate errors are not recoverable
+		_eos = false;
+	}
+
+	bool eos() const { return _eos; }
+	int32 pos() const { return _stream.total_out; }
+	int32 size() const { return _size; }
+
+	uint32 read(void *dataPtr, uint32 dataSize) {
+		if (err())
+			return 0;
+
+		const uint32 available = _size - _stream.total_out;
+		if (dataSize > available) {
+			dataSize = available;
+			_eos = true;
+		}
+
+		byte *out = (byte *)dataPtr;
+		uint32 remaining = dataSize;
+
+		while (_zlibErr == Z_OK && remaining) {
+			if (_stream.total_out >= nextCheckpointPos())
+				addCheckpoint();
+
+			if (_stream.avail_in == 0) {
+				_stream.next_in = _buf;
+				_stream.avail_in = _compressed->read(_buf, UNZ_BUFSIZE);
+				if (_stream.avail_in == 0) {
+					// The member ended before we got all the data we expected
+					_zlibErr = _compressed->err() ? Z_ERRNO : Z_DATA_ERROR;
+					break;
+				}
+			}
+
+			// Never inflate past the next checkpoint position in one go, so
+			// checkpoints are spaced evenly even for highly compressed data.
+			const uint32 chunk = MIN(remaining, nextCheckpointPos() - (uint32)_stream.total_out);
+			_stream.next_out = out;
+			_stream.avail_out = chunk;
+			_zlibErr = inflate(&_stream, Z_SYNC_FLUSH);
+
+			const uint32 produced = chunk - _stream.avail_out;
+			if (_crcValid)
+				_crc = crc32(_crc, out, produced);
+			out += produced;
+			remaining -= produced;
+		}
+
+		if (_zlibErr == Z_STREAM_END && remaining > 0)
+			_eos = true;
+
+		if (_crcValid && _stream.total_out == _size && _crc != _crcWait) {
+			warning("ZipStream: CRC mismatch");
+			_crcValid = false;
+			_zlibErr = Z_DATA_ERROR;
+		}
+
+		return dataSize - remaining;
+	}
+
+	bool seek(int32 offset, int whence = SEEK_SET) {
+		int32 newPos = 0;
+		switch (whence) {
+		case SEEK_SET:
+			newPos = offset;
+			break;
+		case SEEK_CUR:
+			newPos = pos() + offset;
+			break;
+		case SEEK_END:
+			newPos = size() + offset;
+			break;
+		}
+
+		if (newPos < 0 || newPos > size())
+			return false;
+
+		// Find the last checkpoint at or before the target
+		Checkpoint *checkpoint = 0;
+		for (uint i = 0; i < _checkpoints.size() && _checkpoints[i]->uncompressedPos <= (uint32)newPos; ++i)
+			checkpoint = _checkpoints[i];
+
+		const uint32 checkpointPos = checkpoint ? checkpoint->uncompressedPos : 0;
+		if ((uint32)newPos < _stream.total_out || checkpointPos > _stream.total_out) {
+			if (!restoreCheckpoint(checkpoint))
+				return false;
+		}
+
+		// The CRC can only be verified when the member is read front to back
+		if ((uint32)newPos != _stream.total_out)
+			_crcValid = false;
+
+		// Inflate the remaining distance into a scratch buffer
+		byte tmpBuf[4096];
+		uint32 remaining = newPos - _stream.total_out;
+		while (!err() && remaining > 0) {
+			const uint32 skipped = read(tmpBuf, MIN<uint32>(sizeof(tmpBuf), remaining));
+			if (!skipped)
+				break;
+			remaining -= skipped;
+		}
+
+		_eos = false;
+		return !err() && remaining == 0;
+	}
+};
+
+#endif // USE_ZLIB
+
 class ZipArchive : public Archive {
 	unzFile _zipFile;
 
@@ -1489,32 +1699,44 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	if (unzLocateFile(_zipFile, name.c_str(), 2) != UNZ_OK)
 		return 0;
 
-	unz_file_info fileInfo;
+	// Let unzOpenCurrentFile validate the local file header and compute where
+	// the member data starts. We do not read through it, the returned stream
+	// does that on demand.
 	if (unzOpenCurrentFile(_zipFile) != UNZ_OK)
 		return 0;
 
-	if (unzGetCurrentFileInfo(_zipFile, &fileInfo, NULL, 0, NULL, 0, NULL, 0) != UNZ_OK)
-		return 0;
+	unz_s *const archive = (unz_s *)_zipFile;
+	const file_in_zip_read_info_s *const info = archive->pfile_in_zip_read;
 
-	byte *buffer = (byte *)malloc(fileInfo.uncompressed_size);
-	assert(buffer);
+	const uint32 dataStart = info->pos_in_zipfile + info->byte_before_the_zipfile;
+	const uint32 compressedSize = archive->cur_file_info.compressed_size;
+	const uint32 uncompressedSize = archive->cur_file_info.uncompressed_size;
+	const uint32 crc = archive->cur_file_info.crc;
+	const bool stored = (info->compression_method == 0);
 
-	if (unzReadCurrentFile(_zipFile, buffer, fileInfo.uncompressed_size) != (int)fileInfo.uncompressed_size) {
-		free(buffer);
+	// Nothing has been read yet, so this cannot report a CRC error (except
+	// for empty members, where crc32 of nothing is checked against the
+	// header).
+	if (unzCloseCurrentFile(_zipFile) != UNZ_OK)
 		return 0;
-	}
 
-	if (unzCloseCurrentFile(_zipFile) != UNZ_OK) {
-		free(buffer);
-		return 0;
-	}
+	if (stored) {
+		if (compressedSize != uncompressedSize)
+			return 0;
 
-	return new MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
+		// Stored members can be handed out directly as a window into the
+		// archive file. The safe variant seeks the shared archive stream
+		// before each read, so several members can be in use at once.
+		return new SafeSeekableSubReadStream(archive->_stream, dataStart, dataStart + uncompressedSize);
+	}
 
-	// FIXME: instead of reading all into a memory stream, we could
-	// instead create a new ZipStream class. But then we have to be
-	// careful to handle the case where the client code opens multiple
-	// files in the archive and tries to use them independently.
+#ifdef USE_ZLIB
+	return new ZipStream(new SafeSeekableSubReadStream(archive->_stream, dataStart, dataStart + compressedSize),
+	                     uncompressedSize, crc);
+#else
+	// unzOpenCurrentFile() already refuses compressed members without zlib.
+	return 0;
+#endif
 }
 
 Archive *makeZipArchive(const String &name) {
@@ -31,6 +31,12 @@ class Archive;
 class FSNode;
 class SeekableReadStream;
 
+/*
+ * Streams returned by the archive's createReadStreamForMember() read from the
+ * ZIP file on demand. They may be used concurrently, but must be deleted
+ * before the archive itself.
+ */
+
 /**
  * This factory method creates an Archive instance corresponding to the content
  * of the ZIP compressed file with the given name.
@@ -26,6 +26,7 @@
 #include "common/macresman.h"
 #include "common/md5.h"
 #include "common/config-manager.h"
+#include "common/savefile.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
@@ -392,7 +393,11 @@ bool AdvancedMetaEngine::getFileProperties(const Common::FSNode &parent, const F
 		return false;
 
 	fileProps.size = (int32)testFile.size();
-	fileProps.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
+
+	if (!ADDetectionCacheMan.lookup(allFiles[fname], _md5Bytes, fileProps.size, fileProps.md5)) {
+		fileProps.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
+		ADDetectionCacheMan.store(allFiles[fname], _md5Bytes, fileProps.size, fileProps.md5);
+	}
 	return true;
 }
 
@@ -615,3 +620,121 @@ void AdvancedMetaEngine::initSubSystems(const ADGameDescription *gameDesc) const
 	}
 #endif
 }
+
+namespace Common {
+DECLARE_SINGLETON(ADDetectionCache);
+}
+
+static const char *const kDetectionCacheFile = "detection.cache";
+
+ADDetectionCache::ADDetectionCache() : _loaded(false), _dirty(false) {
+}
+
+Common::String ADDetectionCache::makeKey(const Common::String &path, uint32 md5Bytes) {
+	return Common::String::format("%u:", md5Bytes) + path;
+}
+
+bool ADDetectionCache::isEnabled() const {
+	return ConfMan.getBool("detection_cache");
+}
+
+void ADDetectionCache::load() {
+	_loaded = true;
+
+	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(kDetectionCacheFile);
+	if (!in)
+		return;
+
+	// Every line is "<md5> <size> <modification time> <md5 bytes>:<path>".
+	// Lines in the older format without the time are skipped.
+	while (!in->eos() && !in->err()) {
+		Common::String line = in->readLine();
+
+		const char *sep = strchr(line.c_str(), ' ');
+		if (!sep || sep == line.c_str())
+			continue;
+
+		Entry entry;
+		entry.md5 = Common::String(line.c_str(), sep);
+
+		char *end;
+		entry.size = (int32)strtol(sep + 1, &end, 10);
+		if (*end != ' ')
+			continue;
+
+		entry.modificationTime = (uint32)strtoul(end + 1, &end, 10);
+		if (*end != ' ' || !end[1])
+			continue;
+
+		_entries[end + 1] = entry;
+	}
+
+	delete in;
+}
+
+bool ADDetectionCache::lookup(const Common::FSNode &node, uint32 md5Bytes, int32 size, Common::String &md5) {
+	if (!isEnabled())
+		return false;
+
+	if (!_loaded)
+		load();
+
+	EntryMap::const_iterator i = _entries.find(makeKey(node.getPath(), md5Bytes));
+	if (i == _entries.end() || i->_value.size != size || i->_value.modificationTime != node.getModificationTime())
+		return false;
+
+	md5 = i->_value.md5;
+	return true;
+}
+
+void ADDetectionCache::store(const Common::FSNode &node, uint32 md5Bytes, int32 size, const Common::String &md5) {
+	if (!isEnabled())
+		return;
+
+	if (!_loaded)
+		load();
+
+	if (_entries.size() >= kMaxEntries)
+		_entries.clear();
+
+	Entry &entry = _entries[makeKey(node.getPath(), md5Bytes)];
+	entry.size = size;
+	entry.modificationTime = node.getModificationTime();
+	entry.md5 = md5;
+	_dirty = true;
+}
+
+void ADDetectionCache::clear() {
+	_entries.clear();
+	_loaded = true;
+	_dirty = false;
+	g_system->getSavefileManager()->removeSavefile(kDetectionCacheFile);
+}
+
+void ADDetectionCache::flush() {
+	// Do not leave a cache behind which would be outdated once it is
+	// enabled again
+	if (!isEnabled()) {
+		clear();
+		return;
+	}
+
+	if (!_dirty)
+		return;
+
+	Common::OutSaveFile *out = g_system->getSavefileManager()->openForSaving(kDetectionCacheFile, false);
+	if (!out) {
+		warning("Could not write the detection cache");
+		return;
+	}
+
+	for (EntryMap::const_iterator i = _entries.begin(); i != _entries.end(); ++i)
+		out->writeString(Common::String::format("%s %d %u ", i->_value.md5.c_str(), i->_value.size, i->_value.modificationTime) + i->_key + "\n");
+
+	out->finalize();
+	if (out->err())
+		warning("Could not write the detection cache");
+
+	delete out;
+	_dirty = false;
+}
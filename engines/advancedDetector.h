@@ -27,6 +27,7 @@
 #include "engines/engine.h"
 
 #include "common/hash-str.h"
+#include "common/singleton.h"
 
 #include "common/gui_options.h" // FIXME: Temporary hack?
 
@@ -331,4 +332,60 @@ protected:
 	bool getFileProperties(const Common::FSNode &parent, const FileMap &allFiles, const ADGameDescription &game, const Common::String fname, ADFileProperties &fileProps) const;
 };
 
+/**
+ * Singleton class which remembers the MD5s computed by the advanced detector,
+ * so detecting the same directories again (e.g. in the mass add dialog) does
+ * not need to read the files again.
+ *
+ * Entries are keyed by the path of the file and the number of hashed bytes,
+ * and are only used if the file size and, where the file system provides
+ * it, the modification time still match. The cache is stored in the save
+ * directory when flush() is called. Setting the "detection_cache" config
+ * key to false disables it.
+ */
+class ADDetectionCache : public Common::Singleton<ADDetectionCache> {
+public:
+	ADDetectionCache();
+
+	/**
+	 * Look up the MD5 of the first md5Bytes bytes of the given file.
+	 * @return true if a valid entry was found
+	 */
+	bool lookup(const Common::FSNode &node, uint32 md5Bytes, int32 size, Common::String &md5);
+
+	/** Store the MD5 of the first md5Bytes bytes of the given file. */
+	void store(const Common::FSNode &node, uint32 md5Bytes, int32 size, const Common::String &md5);
+
+	/** Write the cache to disk, if it has changed. */
+	void flush();
+
+	/** Forget all entries and remove the cache from disk. */
+	void clear();
+
+private:
+	enum {
+		/** Entries are dropped when there are more than this, to keep stale paths from piling up. */
+		kMaxEntries = 32768
+	};
+
+	struct Entry {
+		int32 size;
+		uint32 modificationTime;	// 0 if not known
+		Common::String md5;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	EntryMap _entries;
+	bool _loaded;
+	bool _dirty;
+
+	bool isEnabled() const;
+	void load();
+	static Common::String makeKey(const Common::String &path, uint32 md5Bytes);
+};
+
+/** Convenience shortcut for accessing the detection cache. */
+#define ADDetectionCacheMan ADDetectionCache::instance()
+
 #endif
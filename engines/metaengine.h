@@ -170,6 +170,21 @@ public:
 		return SaveStateDescriptor();
 	}
 
+	/**
+	 * Returns the name of the savefile which holds the specified save state.
+	 *
+	 * This allows the meta infos of the save state to be cached across
+	 * sessions, as the savefile manager can tell when the savefile changes.
+	 * The default implementation returns an empty string, in which case
+	 * they are not cached.
+	 *
+	 * @param target	name of a config manager target
+	 * @param slot		slot number of the save state
+	 */
+	virtual Common::String getSavegameFile(const char *target, int slot) const {
+		return Common::String();
+	}
+
 	/** @name MetaEngineFeature flags */
 	//@{
 
@@ -22,6 +22,8 @@
 
 #include "engines/savestate.h"
 #include "graphics/surface.h"
+#include "graphics/thumbnail.h"
+#include "common/stream.h"
 #include "common/textconsole.h"
 
 SaveStateDescriptor::SaveStateDescriptor()
@@ -58,3 +60,63 @@ void SaveStateDescriptor::setPlayTime(uint32 msecs) {
 	uint minutes = msecs / 60000;
 	setPlayTime(minutes / 60, minutes % 60);
 }
+
+namespace {
+
+enum {
+	kSaveStateDescriptorVersion = 1
+};
+
+void writeString(Common::WriteStream &out, const Common::String &str) {
+	out.writeUint16BE(str.size());
+	out.writeString(str);
+}
+
+Common::String readString(Common::SeekableReadStream &in) {
+	Common::String str;
+	const uint16 size = in.readUint16BE();
+	for (uint16 i = 0; i < size && !in.eos(); i++)
+		str += (char)in.readByte();
+	return str;
+}
+
+} // End of anonymous namespace
+
+void SaveStateDescriptor::saveToStream(Common::WriteStream &out) const {
+	out.writeByte(kSaveStateDescriptorVersion);
+	out.writeSint32BE(_slot);
+	writeString(out, _description);
+	out.writeByte(_isDeletable);
+	out.writeByte(_isWriteProtected);
+	writeString(out, _saveDate);
+	writeString(out, _saveTime);
+	writeString(out, _playTime);
+
+	out.writeByte(_thumbnail ? 1 : 0);
+	if (_thumbnail)
+		Graphics::saveThumbnail(out, *_thumbnail);
+}
+
+bool SaveStateDescriptor::loadFromStream(Common::SeekableReadStream &in) {
+	if (in.readByte() != kSaveStateDescriptorVersion)
+		return false;
+
+	_slot = in.readSint32BE();
+	_description = readString(in);
+	_isDeletable = in.readByte() != 0;
+	_isWriteProtected = in.readByte() != 0;
+	_saveDate = readString(in);
+	_saveTime = readString(in);
+	_playTime = readString(in);
+
+	if (in.readByte()) {
+		Graphics::Surface *thumbnail = Graphics::loadThumbnail(in);
+		if (!thumbnail)
+			return false;
+		setThumbnail(thumbnail);
+	} else {
+		_thumbnail.reset();
+	}
+
+	return !in.eos() && !in.err();
+}
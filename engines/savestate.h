@@ -28,6 +28,11 @@
 #include "common/ptr.h"
 
 
+namespace Common {
+class SeekableReadStream;
+class WriteStream;
+}
+
 namespace Graphics {
 struct Surface;
 }
@@ -159,6 +164,19 @@ public:
 	 */
 	const Common::String &getPlayTime() const { return _playTime; }
 
+	/**
+	 * Writes all infos, including the thumbnail, to a stream. This allows
+	 * to cache them outside of the save state.
+	 */
+	void saveToStream(Common::WriteStream &out) const;
+
+	/**
+	 * Reads infos written by saveToStream().
+	 *
+	 * @return true on success, false if the data is invalid
+	 */
+	bool loadFromStream(Common::SeekableReadStream &in);
+
 private:
 	/**
 	 * The saveslot id, as it would be passed to the "-x" command line switch.
@@ -112,6 +112,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_id",		WRAP_METHOD(Console, cmdResourceId));
 	registerCmd("resource_info",		WRAP_METHOD(Console, cmdResourceInfo));
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	registerCmd("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
@@ -150,6 +151,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("segkill",			WRAP_METHOD(Console, cmdKillSegment));			// alias
 	// Garbage collection
 	registerCmd("gc",					WRAP_METHOD(Console, cmdGCInvoke));
+	registerCmd("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	registerCmd("gc_objects",			WRAP_METHOD(Console, cmdGCObjects));
 	registerCmd("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	registerCmd("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
@@ -209,6 +211,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("vm_benchmark",		WRAP_METHOD(Console, cmdVMBenchmark));
 	registerCmd("vm_varlist",			WRAP_METHOD(Console, cmdVMVarlist));
 	registerCmd("vmvarlist",			WRAP_METHOD(Console, cmdVMVarlist));				// alias
 	registerCmd("vl",					WRAP_METHOD(Console, cmdVMVarlist));				// alias
@@ -233,12 +236,24 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	_debugState.breakpointWasHit = false;
 	_debugState._breakpoints.clear(); // No breakpoints defined
 	_debugState._activeBreakpointTypes = 0;
+	_debugState.benchmarking = false;
+	_debugState.benchmarkStartStep = 0;
+	_debugState.benchmarkTime = 0;
+	_debugState.benchmarkClock = 0;
+	_debugState.benchmarkClockRunning = false;
+	_debugState.benchmarkKernelCalls = 0;
 }
 
 Console::~Console() {
 }
 
 void Console::preEnter() {
+	// Don't count the time spent in the console as script execution time.
+	// The clock is only running if the console was entered while bytecode
+	// was being interpreted, and not from within a kernel call.
+	if (_debugState.benchmarking && _debugState.benchmarkClockRunning)
+		_debugState.benchmarkTime += g_system->getMillis() - _debugState.benchmarkClock;
+
 	_engine->pauseEngine(true);
 }
 
@@ -307,6 +322,9 @@ void Console::postEnter() {
 	}
 
 	_engine->pauseEngine(false);
+
+	if (_debugState.benchmarking && _debugState.benchmarkClockRunning)
+		_debugState.benchmarkClock = g_system->getMillis();
 }
 
 bool Console::cmdHelp(int argc, const char **argv) {
@@ -351,6 +369,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_id - Identifies a resource number by splitting it up in resource type and resource number\n");
 	debugPrintf(" resource_info - Shows info about a resource\n");
 	debugPrintf(" resource_types - Shows the valid resource types\n");
+	debugPrintf(" resource_cache - Shows the resource cache usage and statistics\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	debugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
@@ -386,6 +405,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("Garbage collection:\n");
 	debugPrintf(" gc - Invokes the garbage collector\n");
+	debugPrintf(" gc_stats - Shows the pause times of the garbage collector\n");
 	debugPrintf(" gc_objects - Lists all reachable objects, normalized\n");
 	debugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	debugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
@@ -431,6 +451,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" vm_benchmark - Measures the number of SCI operations executed per second\n");
 	debugPrintf(" vm_varlist / vmvarlist / vl - Shows the addresses of variables in the VM\n");
 	debugPrintf(" vm_vars / vmvars / vv - Displays or changes variables in the VM\n");
 	debugPrintf(" stack - Lists the specified number of stack elements\n");
@@ -812,6 +833,46 @@ bool Console::cmdResourceTypes(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			resMan->resetCacheStats();
+			debugPrintf("Resource cache statistics reset\n");
+			return true;
+		} else if (!scumm_stricmp(argv[1], "limit") && argc > 2) {
+			int limit = 0;
+			if (!parseInteger(argv[2], limit) || limit < 0)
+				return true;
+			resMan->setCacheLimit(limit * 1024);
+			debugPrintf("Resource cache limit set to %d KB\n", limit);
+			return true;
+		}
+
+		debugPrintf("Shows the usage of the cache for unlocked resources.\n");
+		debugPrintf("Usage: %s [reset | limit <KB>]\n", argv[0]);
+		return true;
+	}
+
+	static const char *const priorityNames[] = { "low", "normal", "high" };
+
+	debugPrintf("Limit: %d KB, locked resources: %d KB\n", resMan->getCacheLimit() / 1024, resMan->getLockedMemory() / 1024);
+	for (int i = ResourceManager::kCachePriorityCount - 1; i >= 0; i--) {
+		const ResourceManager::CachePriority priority = (ResourceManager::CachePriority)i;
+		debugPrintf("Priority %-6s: %d resources, %d KB\n", priorityNames[i],
+		            resMan->getCacheEntries(priority), resMan->getCacheMemory(priority) / 1024);
+	}
+
+	const ResourceManager::CacheStats &stats = resMan->getCacheStats();
+	const uint32 lookups = stats.hits + stats.misses;
+	debugPrintf("Hits: %d, misses: %d (%d%% hit rate)\n", stats.hits, stats.misses,
+	            lookups ? stats.hits * 100 / lookups : 0);
+	debugPrintf("Evictions: %d (%d KB), prefetched: %d\n", stats.evictions, stats.evictedBytes / 1024, stats.prefetches);
+
+	return true;
+}
+
 bool Console::cmdHexgrep(int argc, const char **argv) {
 	if (argc < 4) {
 		debugPrintf("Searches some resources for a particular sequence of bytes, represented as decimal or hexadecimal numbers.\n");
@@ -2256,19 +2317,43 @@ bool Console::cmdIsSample(int argc, const char **argv) {
 bool Console::cmdGCInvoke(int argc, const char **argv) {
 	debugPrintf("Performing garbage collection...\n");
 	run_gc(_engine->_gamestate);
+	const GCStats &stats = _engine->_gamestate->_gc->getStats();
+	debugPrintf("Done after %d ms, %d objects freed\n", stats.lastPause, stats.lastFreed);
+	return true;
+}
+
+bool Console::cmdGCStats(int argc, const char **argv) {
+	GarbageCollector *gc = _engine->_gamestate->_gc;
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			gc->resetStats();
+			debugPrintf("Garbage collection statistics reset\n");
+		} else {
+			debugPrintf("Shows the pause times of the garbage collector.\n");
+			debugPrintf("Usage: %s [reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	const GCStats &stats = gc->getStats();
+	debugPrintf("Runs: %d, interval: %d kernel calls\n", stats.runs, _engine->_gamestate->scriptGCInterval);
+	debugPrintf("Pause: last %d ms, max %d ms, average %d ms\n", stats.lastPause, stats.maxPause,
+	            stats.runs + stats.sweepSlices ? stats.totalPause / (stats.runs + stats.sweepSlices) : 0);
+	debugPrintf("Sweep slices: %d, objects pending: %d\n", stats.sweepSlices, gc->getPendingCount());
+	debugPrintf("Last run: %d references reachable, %d objects freed\n", stats.lastReachable, stats.lastFreed);
+	debugPrintf("Objects freed in total: %d\n", stats.totalFreed);
 	return true;
 }
 
 bool Console::cmdGCObjects(int argc, const char **argv) {
-	AddrSet *use_map = findAllActiveReferences(_engine->_gamestate);
+	const AddrSet &use_map = findAllActiveReferences(_engine->_gamestate);
 
 	debugPrintf("Reachable object references (normalised):\n");
-	for (AddrSet::iterator i = use_map->begin(); i != use_map->end(); ++i) {
+	for (AddrSet::const_iterator i = use_map.begin(); i != use_map.end(); ++i) {
 		debugPrintf(" - %04x:%04x\n", PRINT_REG(i->_key));
 	}
 
-	delete use_map;
-
 	return true;
 }
 
@@ -2732,6 +2817,47 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdVMBenchmark(int argc, const char **argv) {
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "start")) {
+			_debugState.benchmarking = true;
+			_debugState.benchmarkStartStep = _engine->_gamestate->scriptStepCounter;
+			_debugState.benchmarkTime = 0;
+			_debugState.benchmarkKernelCalls = 0;
+			debugPrintf("Benchmark started, play the scene to measure and run \"%s\" again to see the results\n", argv[0]);
+		} else if (!scumm_stricmp(argv[1], "stop")) {
+			_debugState.benchmarking = false;
+			debugPrintf("Benchmark stopped\n");
+		} else {
+			debugPrintf("Measures the speed of the script interpreter while the game is running.\n");
+			debugPrintf("Kernel calls are not included in the measured time.\n");
+			debugPrintf("Usage: %s [start | stop]\n", argv[0]);
+		}
+		return true;
+	}
+
+	if (!_debugState.benchmarking) {
+		debugPrintf("No benchmark is running, use \"%s start\" to start one\n", argv[0]);
+		return true;
+	}
+
+	const uint32 steps = _engine->_gamestate->scriptStepCounter - _debugState.benchmarkStartStep;
+	const uint32 time = _debugState.benchmarkTime;
+	debugPrintf("Operations executed: %d, kernel calls: %d\n", steps, _debugState.benchmarkKernelCalls);
+	debugPrintf("Interpreter time: %d ms\n", time);
+	if (time)
+		debugPrintf("Operations per second: %d\n", (uint32)((uint64)steps * 1000 / time));
+
+	uint decoded = 0;
+	const Common::Array<SegmentObj *> &segments = _engine->_gamestate->_segMan->getSegments();
+	for (uint i = 0; i < segments.size(); i++) {
+		if (segments[i] && segments[i]->getType() == SEG_TYPE_SCRIPT)
+			decoded += ((Script *)segments[i])->getDecodedInstructionCount();
+	}
+	debugPrintf("Decoded instructions cached: %d\n", decoded);
+	return true;
+}
+
 bool Console::cmdBacktrace(int argc, const char **argv) {
 	debugPrintf("Call stack (current base: 0x%x):\n", _engine->_gamestate->executionStackBase);
 	Common::List<ExecStack>::const_iterator iter;
@@ -72,6 +72,15 @@ struct DebugState {
 	StackPtr old_sp;
 	Common::List<Breakpoint> _breakpoints;   //< List of breakpoints
 	int _activeBreakpointTypes;  //< Bit mask specifying which types of breakpoints are active
+
+	// Counters for the vm_benchmark command. The clock only runs while
+	// bytecode is being interpreted, i.e. kernel calls are excluded.
+	bool benchmarking;			// Set while a benchmark is running
+	int benchmarkStartStep;		// Value of scriptStepCounter when the benchmark was started
+	uint32 benchmarkTime;		// Accumulated interpreter time in ms
+	uint32 benchmarkClock;		// Time at which the clock was last started
+	bool benchmarkClockRunning;	// Set while bytecode is interpreted, even if no benchmark is running
+	uint32 benchmarkKernelCalls;	// Number of kernel calls made
 };
 
 // Various global variables used for debugging are declared here
@@ -485,6 +485,7 @@ public:
 	virtual int getMaximumSaveSlot() const;
 	virtual void removeSaveState(const char *target, int slot) const;
 	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const;
+	virtual Common::String getSavegameFile(const char *target, int slot) const;
 };
 
 Common::Language charToScummVMLanguage(const char c) {
@@ -785,6 +786,10 @@ SaveStateDescriptor SciMetaEngine::querySaveMetaInfos(const char *target, int sl
 
 int SciMetaEngine::getMaximumSaveSlot() const { return 99; }
 
+Common::String SciMetaEngine::getSavegameFile(const char *target, int slot) const {
+	return Common::String::format("%s.%03d", target, slot);
+}
+
 void SciMetaEngine::removeSaveState(const char *target, int slot) const {
 	Common::String fileName = Common::String::format("%s.%03d", target, slot);
 	g_system->getSavefileManager()->removeSavefile(fileName);
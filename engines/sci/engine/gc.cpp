@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 namespace Sci {
@@ -64,20 +65,16 @@ void WorklistManager::pushArray(const Common::Array<reg_t> &tmp) {
 		push(*it);
 }
 
-static AddrSet *normalizeAddresses(SegManager *segMan, const AddrSet &nonnormal_map) {
-	AddrSet *normal_map = new AddrSet();
-
+static void normalizeAddresses(SegManager *segMan, const AddrSet &nonnormal_map, AddrSet &normal_map) {
 	for (AddrSet::const_iterator i = nonnormal_map.begin(); i != nonnormal_map.end(); ++i) {
 		reg_t reg = i->_key;
 		SegmentObj *mobj = segMan->getSegmentObj(reg.getSegment());
 
 		if (mobj) {
 			reg = mobj->findCanonicAddress(segMan, reg);
-			normal_map->setVal(reg, true);
+			normal_map.setVal(reg, true);
 		}
 	}
-
-	return normal_map;
 }
 
 static void processWorkList(SegManager *segMan, WorklistManager &wm, const Common::Array<SegmentObj *> &heap) {
@@ -95,10 +92,26 @@ static void processWorkList(SegManager *segMan, WorklistManager &wm, const Commo
 	}
 }
 
-AddrSet *findAllActiveReferences(EngineState *s) {
+GarbageCollector::GarbageCollector() : _pendingPos(0) {
+	resetStats();
+}
+
+void GarbageCollector::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+void GarbageCollector::discardPending() {
+	_pending.clear();
+	_pendingPos = 0;
+}
+
+const AddrSet &GarbageCollector::findAllActiveReferences(EngineState *s) {
 	assert(!s->_executionStack.empty());
 
-	WorklistManager wm;
+	// Clear the sets from the last run, but keep their storage around
+	WorklistManager &wm = _worklist;
+	wm._map.clear();
+	_activeRefs.clear();
 
 	// Initialize registers
 	wm.push(s->r_acc);
@@ -157,11 +170,42 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	if (g_sci->_gfxPorts)
 		g_sci->_gfxPorts->processEngineHunkList(wm);
 
-	return normalizeAddresses(s->_segMan, wm._map);
+	normalizeAddresses(s->_segMan, wm._map, _activeRefs);
+	return _activeRefs;
 }
 
-void run_gc(EngineState *s) {
+void GarbageCollector::run(EngineState *s) {
+	mark(s, true);
+}
+
+void GarbageCollector::kernelCall(EngineState *s, bool gameCycleEnd) {
+	// A due collection waits for the end of the game cycle, unless the
+	// game does not get there within another interval
+	if (s->gcCountDown-- <= 0 && (gameCycleEnd || s->gcCountDown < -s->scriptGCInterval)) {
+		s->gcCountDown = s->scriptGCInterval;
+		mark(s, false);
+	} else if (gameCycleEnd && getPendingCount()) {
+		const uint32 startTime = g_system->getMillis();
+		const uint freed = sweep(s->_segMan, kSweepSlice);
+		const uint32 pause = g_system->getMillis() - startTime;
+
+		_stats.sweepSlices++;
+		_stats.maxPause = MAX(_stats.maxPause, pause);
+		_stats.totalPause += pause;
+		_stats.lastFreed += freed;
+		_stats.totalFreed += freed;
+		debugC(kDebugLevelGC, "[GC] Sweep slice done after %d ms, %d objects freed, %d pending", pause, freed, getPendingCount());
+	}
+}
+
+void GarbageCollector::mark(EngineState *s, bool sweepAll) {
 	SegManager *segMan = s->_segMan;
+	const uint32 startTime = g_system->getMillis();
+	uint32 freed = 0;
+
+	// Objects left over from the last run are unreachable still, and are
+	// found again below
+	discardPending();
 
 	// Some debug stuff
 	debugC(kDebugLevelGC, "[GC] Running...");
@@ -173,7 +217,7 @@ void run_gc(EngineState *s) {
 #endif
 
 	// Compute the set of all segments references currently in use.
-	AddrSet *activeRefs = findAllActiveReferences(s);
+	const AddrSet &activeRefs = findAllActiveReferences(s);
 
 	// Iterate over all segments, and check for each whether it
 	// contains stuff that can be collected.
@@ -182,8 +226,8 @@ void run_gc(EngineState *s) {
 		SegmentObj *mobj = heap[seg];
 
 		if (mobj != NULL) {
-#ifdef GC_DEBUG_CODE
 			const SegmentType type = mobj->getType();
+#ifdef GC_DEBUG_CODE
 			segnames[type] = segmentTypeNames[type];
 #endif
 
@@ -192,10 +236,16 @@ void run_gc(EngineState *s) {
 			const Common::Array<reg_t> tmp = mobj->listAllDeallocatable(seg);
 			for (Common::Array<reg_t>::const_iterator it = tmp.begin(); it != tmp.end(); ++it) {
 				const reg_t addr = *it;
-				if (!activeRefs->contains(addr)) {
-					// Not found -> we can free it
-					mobj->freeAtAddress(segMan, addr);
-					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+				if (!activeRefs.contains(addr)) {
+					// Not found -> we can free it. Scripts go right away, as
+					// they can be reloaded by number rather than by reference.
+					if (type == SEG_TYPE_SCRIPT) {
+						mobj->freeAtAddress(segMan, addr);
+						freed++;
+						debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+					} else {
+						_pending.push_back(addr);
+					}
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
 #endif
@@ -205,7 +255,17 @@ void run_gc(EngineState *s) {
 		}
 	}
 
-	delete activeRefs;
+	freed += sweep(segMan, sweepAll ? _pending.size() : (uint)kSweepSlice);
+
+	const uint32 pause = g_system->getMillis() - startTime;
+	_stats.runs++;
+	_stats.lastPause = pause;
+	_stats.maxPause = MAX(_stats.maxPause, pause);
+	_stats.totalPause += pause;
+	_stats.lastReachable = activeRefs.size();
+	_stats.lastFreed = freed;
+	_stats.totalFreed += freed;
+	debugC(kDebugLevelGC, "[GC] Done after %d ms, %d objects freed, %d pending", pause, freed, getPendingCount());
 
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
@@ -216,4 +276,33 @@ void run_gc(EngineState *s) {
 #endif
 }
 
+uint GarbageCollector::sweep(SegManager *segMan, uint limit) {
+	uint freed = 0;
+
+	while (freed < limit && _pendingPos < _pending.size()) {
+		const reg_t addr = _pending[_pendingPos++];
+		SegmentObj *mobj = segMan->getSegmentObj(addr.getSegment());
+
+		// Nothing can reach the object anymore, so its entry is still in use
+		if (mobj && mobj->isValidOffset(addr.getOffset())) {
+			mobj->freeAtAddress(segMan, addr);
+			freed++;
+			debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+		}
+	}
+
+	if (_pendingPos == _pending.size())
+		discardPending();
+
+	return freed;
+}
+
+const AddrSet &findAllActiveReferences(EngineState *s) {
+	return s->_gc->findAllActiveReferences(s);
+}
+
+void run_gc(EngineState *s) {
+	s->_gc->run(s);
+}
+
 } // End of namespace Sci
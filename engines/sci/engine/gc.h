@@ -42,12 +42,97 @@ struct reg_t_Hash {
  */
 typedef Common::HashMap<reg_t, bool, reg_t_Hash> AddrSet;
 
+struct WorklistManager {
+	Common::Array<reg_t> _worklist;
+	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
+
+	void push(reg_t reg);
+	void pushArray(const Common::Array<reg_t> &tmp);
+};
+
+/** Timing information about the garbage collection runs */
+struct GCStats {
+	uint32 runs;
+	uint32 lastPause;	///< Duration of the last run, in milliseconds
+	uint32 maxPause;	///< Duration of the longest run, in milliseconds
+	uint32 totalPause;	///< Time spent in all runs, in milliseconds
+	uint32 lastReachable;	///< Number of references found reachable in the last run
+	uint32 lastFreed;	///< Number of objects freed in the last run, including its sweep slices
+	uint32 totalFreed;
+	uint32 sweepSlices;	///< Number of deferred sweep slices, their time is part of totalPause
+};
+
+/**
+ * Holds the mark structures of the garbage collector between runs, so that
+ * their memory is reused instead of being allocated again on every run.
+ *
+ * Collections triggered by the VM are scheduled at the end of a game cycle,
+ * i.e. the next kGetEvent call, and only free a slice of the unreachable
+ * objects right away. The rest is freed in further slices at the following
+ * kGetEvent calls. Objects which were unreachable once stay unreachable, so
+ * this is safe as long as the segments are not replaced in the meantime, see
+ * discardPending().
+ */
+class GarbageCollector {
+public:
+	enum {
+		kSweepSlice = 1024	///< Maximum number of objects freed per kernel call
+	};
+
+	GarbageCollector();
+
+	/**
+	 * Finds all used references and normalises them to their memory addresses
+	 * @param s The state to gather all information from
+	 * @return A hash map containing entries for all used references. It is
+	 *         only valid until the next garbage collection.
+	 */
+	const AddrSet &findAllActiveReferences(EngineState *s);
+
+	/**
+	 * Runs garbage collection on the current system state
+	 * @param s The state in which we should gc
+	 */
+	void run(EngineState *s);
+
+	/**
+	 * Called by the VM before every kernel call. Runs a collection once one
+	 * is due and a game cycle ends, or once another full interval has passed
+	 * without one. Frees the next slice of pending objects at the end of a
+	 * game cycle.
+	 * @param s              The state in which we should gc
+	 * @param gameCycleEnd   Whether the kernel call is kGetEvent
+	 */
+	void kernelCall(EngineState *s, bool gameCycleEnd);
+
+	/**
+	 * Forgets the objects still waiting to be freed. This has to be called
+	 * whenever the segments are replaced, e.g. when a game is restored.
+	 */
+	void discardPending();
+
+	uint getPendingCount() const { return _pending.size() - _pendingPos; }
+
+	const GCStats &getStats() const { return _stats; }
+	void resetStats();
+
+private:
+	void mark(EngineState *s, bool sweepAll);
+	uint sweep(SegManager *segMan, uint limit);
+
+	WorklistManager _worklist;
+	AddrSet _activeRefs;
+	Common::Array<reg_t> _pending;	///< Unreachable objects not freed yet
+	uint _pendingPos;	///< Index of the first entry of _pending not freed yet
+	GCStats _stats;
+};
+
 /**
  * Finds all used references and normalises them to their memory addresses
  * @param s The state to gather all information from
  * @return A hash map containing entries for all used references
  */
-AddrSet *findAllActiveReferences(EngineState *s);
+const AddrSet &findAllActiveReferences(EngineState *s);
 
 /**
  * Runs garbage collection on the current system state
@@ -55,14 +140,6 @@ AddrSet *findAllActiveReferences(EngineState *s);
  */
 void run_gc(EngineState *s);
 
-struct WorklistManager {
-	Common::Array<reg_t> _worklist;
-	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
-
-	void push(reg_t reg);
-	void pushArray(const Common::Array<reg_t> &tmp);
-};
-
 
 } // End of namespace Sci
 
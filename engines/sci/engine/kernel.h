@@ -263,6 +263,13 @@ private:
 	const Common::String _invalid;
 };
 
+class PathfindingCache;
+
+/**
+ * Frees the visibility graphs which kAvoidPath keeps for the current room.
+ */
+void freePathfindingCache(PathfindingCache *cache);
+
 /******************** Kernel functions ********************/
 
 reg_t kStrLen(EngineState *s, int argc, reg_t *argv);
@@ -111,21 +111,18 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Position in PathfindingState::vertex_index
+	int index;
+
+	// Vertex number in the visibility graph, -1 if not part of it
+	int graphIndex;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
-	}
-};
-
-class VertexList: public Common::List<Vertex *> {
-public:
-	bool contains(Vertex *v) {
-		for (iterator it = begin(); it != end(); ++it) {
-			if (v == *it)
-				return true;
-		}
-		return false;
+		index = -1;
+		graphIndex = -1;
 	}
 };
 
@@ -236,6 +233,8 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+class VisibilityGraph;
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
@@ -257,6 +256,11 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Visibility graph of the polygon set, either owned by this state or
+	// by the pathfinding cache
+	VisibilityGraph *_graph;
+	bool _ownsGraph;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = NULL;
 		vertex_end = NULL;
@@ -264,18 +268,11 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		_graph = NULL;
+		_ownsGraph = false;
 	}
 
-	~PathfindingState() {
-		free(vertex_index);
-
-		delete _prependPoint;
-		delete _appendPoint;
-
-		for (PolygonList::iterator it = polygons.begin(); it != polygons.end(); ++it) {
-			delete *it;
-		}
-	}
+	~PathfindingState();
 
 	bool pointOnScreenBorder(const Common::Point &p);
 	bool edgeOnScreenBorder(const Common::Point &p, const Common::Point &q);
@@ -660,45 +657,362 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 }
 
 /**
- * Returns a list of all vertices that are visible from a particular vertex.
- * @param s				the pathfinding state
- * @param vertex_cur	the vertex
- * @return list of vertices that are visible from vert
+ * Visibility graph of a polygon set. Visibility between two vertices is
+ * determined on first use and remembered, so that later path requests on
+ * the same polygon set can reuse the results. Edges are kept in a uniform
+ * grid, so that a visibility test only has to look at the edges near the
+ * line of sight.
  */
-static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
-	VertexList *visVerts = new VertexList();
+class VisibilityGraph {
+public:
+	/**
+	 * Builds the graph for the given polygon set. The vertices are numbered
+	 * in the order in which they appear in the set.
+	 */
+	VisibilityGraph(const PolygonList &polygons);
 
-	for (int i = 0; i < s->vertices; i++) {
-		Vertex *vertex = s->vertex_index[i];
+	uint getVertexCount() const { return _points.size(); }
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
-			continue;
+	/**
+	 * Checks whether the graph was built for the given polygon set.
+	 */
+	bool matches(const PolygonList &polygons) const;
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
+	/**
+	 * Determines whether or not two vertices of the graph can see each other.
+	 */
+	bool isVisible(int a, int b);
+
+	/**
+	 * Determines whether or not two points can see each other. Points that
+	 * are not a vertex of the graph must be passed with index -1.
+	 */
+	bool isVisible(const Common::Point &a, int aIndex, const Common::Point &b, int bIndex);
+
+private:
+	enum {
+		kCellSize = 16
+	};
+
+	enum {
+		kVisibilityUnknown = 0,
+		kVisible = 1,
+		kNotVisible = 2
+	};
+
+	bool insideAt(const Common::Point &p, int vertex) const;
+	bool isEdgeBlocking(const Common::Point &a, const Common::Point &b, int edge) const;
+
+	Common::Array<uint16> _polygonSizes;
+	Common::Array<Common::Point> _points;
+	Common::Array<int> _next; // Next vertex in the polygon, the vertex itself for single-vertex polygons
+	Common::Array<int> _prev;
+	Common::Array<byte> _visibility;
+
+	// Edge grid: the edges touching cell i are stored in
+	// _cellEdges[_cellStart[i] .. _cellStart[i + 1] - 1]
+	int16 _gridLeft, _gridTop;
+	int _gridWidth, _gridHeight;
+	Common::Array<uint> _cellStart;
+	Common::Array<int> _cellEdges;
+	Common::Array<uint32> _edgeStamp;
+	uint32 _stamp;
+};
+
+VisibilityGraph::VisibilityGraph(const PolygonList &polygons) : _stamp(0) {
+	for (PolygonList::const_iterator it = polygons.begin(); it != polygons.end(); ++it) {
+		const int first = _points.size();
+		Vertex *vertex;
+
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			const int index = _points.size();
+			_points.push_back(vertex->v);
+			_next.push_back(index + 1);
+			_prev.push_back(index - 1);
+		}
+
+		const int last = _points.size() - 1;
+		_next[last] = first;
+		_prev[first] = last;
+		_polygonSizes.push_back(last - first + 1);
+	}
+
+	const int count = _points.size();
+	_visibility.resize(count * count);
+	_edgeStamp.resize(count);
+
+	if (!count) {
+		_gridLeft = _gridTop = 0;
+		_gridWidth = _gridHeight = 0;
+		_cellStart.push_back(0);
+		return;
+	}
+
+	int16 right = _points[0].x, bottom = _points[0].y;
+	_gridLeft = right;
+	_gridTop = bottom;
+	for (int i = 1; i < count; i++) {
+		_gridLeft = MIN(_gridLeft, _points[i].x);
+		_gridTop = MIN(_gridTop, _points[i].y);
+		right = MAX(right, _points[i].x);
+		bottom = MAX(bottom, _points[i].y);
+	}
+	_gridWidth = (right - _gridLeft) / kCellSize + 1;
+	_gridHeight = (bottom - _gridTop) / kCellSize + 1;
+
+	// Count the edges per cell first, then fill in the edge lists
+	_cellStart.resize(_gridWidth * _gridHeight + 1);
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 0; i < count; i++) {
+			if (_next[i] == i)
+				continue;
+
+			const Common::Point &p = _points[i];
+			const Common::Point &q = _points[_next[i]];
+			const int x1 = (MIN(p.x, q.x) - _gridLeft) / kCellSize;
+			const int x2 = (MAX(p.x, q.x) - _gridLeft) / kCellSize;
+			const int y1 = (MIN(p.y, q.y) - _gridTop) / kCellSize;
+			const int y2 = (MAX(p.y, q.y) - _gridTop) / kCellSize;
+
+			for (int y = y1; y <= y2; y++) {
+				for (int x = x1; x <= x2; x++) {
+					const int cell = y * _gridWidth + x;
+					if (pass == 0)
+						_cellStart[cell + 1]++;
+					else
+						_cellEdges[_cellStart[cell]++] = i;
 				}
+			}
+		}
 
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
+		if (pass == 0) {
+			for (uint cell = 1; cell < _cellStart.size(); cell++)
+				_cellStart[cell] += _cellStart[cell - 1];
+			_cellEdges.resize(_cellStart.back());
+		} else {
+			// Filling advanced each start to the start of the next cell
+			for (uint cell = _cellStart.size() - 1; cell > 0; cell--)
+				_cellStart[cell] = _cellStart[cell - 1];
+			_cellStart[0] = 0;
+		}
+	}
+}
+
+bool VisibilityGraph::matches(const PolygonList &polygons) const {
+	if (polygons.size() != _polygonSizes.size())
+		return false;
+
+	uint index = 0;
+	uint polygon = 0;
+	for (PolygonList::const_iterator it = polygons.begin(); it != polygons.end(); ++it, ++polygon) {
+		const uint first = index;
+		Vertex *vertex;
+
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			if (index >= _points.size() || _points[index] != vertex->v)
+				return false;
+			index++;
+		}
+
+		if (index - first != _polygonSizes[polygon])
+			return false;
+	}
+
+	return index == _points.size();
+}
+
+/**
+ * Same as inside(), for a vertex of the graph
+ */
+bool VisibilityGraph::insideAt(const Common::Point &p, int vertex) const {
+	if (_next[vertex] == vertex)
+		return false;
+
+	const Common::Point &prev = _points[_prev[vertex]];
+	const Common::Point &next = _points[_next[vertex]];
+	const Common::Point &cur = _points[vertex];
+
+	if (left(prev, cur, next))
+		return left(cur, next, p) && left(prev, cur, p);
+	else
+		return left(cur, next, p) || left(prev, cur, p);
+}
+
+bool VisibilityGraph::isEdgeBlocking(const Common::Point &a, const Common::Point &b, int edge) const {
+	const Common::Point &v = _points[edge];
+
+	if (between(a, b, v)) {
+		// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+		return insideAt(a, edge) || insideAt(b, edge);
+	}
+
+	return intersect_proper(a, b, v, _points[_next[edge]]);
+}
+
+bool VisibilityGraph::isVisible(int a, int b) {
+	if (a == b)
+		return false;
+
+	byte &visibility = _visibility[a * _points.size() + b];
+	if (visibility == kVisibilityUnknown) {
+		// The test is symmetric, so store the result for both directions
+		visibility = isVisible(_points[a], a, _points[b], b) ? kVisible : kNotVisible;
+		_visibility[b * _points.size() + a] = visibility;
+	}
+
+	return visibility == kVisible;
+}
+
+bool VisibilityGraph::isVisible(const Common::Point &a, int aIndex, const Common::Point &b, int bIndex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((bIndex >= 0 && insideAt(a, bIndex)) || (aIndex >= 0 && insideAt(b, aIndex)))
+		return false;
+
+	// between() matches every point on the same row for an empty segment,
+	// which the grid can't handle, so check all edges in that case
+	if (a == b) {
+		for (uint i = 0; i < _points.size(); i++) {
+			if (_next[i] != (int)i && isEdgeBlocking(a, b, i))
+				return false;
+		}
+		return true;
+	}
+
+	if (_cellEdges.empty())
+		return true;
+
+	// Edges can only block the line of sight inside the grid
+	const int x1 = CLIP<int>((MIN(a.x, b.x) - _gridLeft) / kCellSize, 0, _gridWidth - 1);
+	const int x2 = CLIP<int>((MAX(a.x, b.x) - _gridLeft) / kCellSize, 0, _gridWidth - 1);
+	const int y1 = CLIP<int>((MIN(a.y, b.y) - _gridTop) / kCellSize, 0, _gridHeight - 1);
+	const int y2 = CLIP<int>((MAX(a.y, b.y) - _gridTop) / kCellSize, 0, _gridHeight - 1);
+
+	// Every edge is tested at most once per query
+	if (++_stamp == 0) {
+		for (uint i = 0; i < _edgeStamp.size(); i++)
+			_edgeStamp[i] = 0;
+		_stamp = 1;
+	}
+
+	for (int y = y1; y <= y2; y++) {
+		for (int x = x1; x <= x2; x++) {
+			// Skip cells which the line doesn't pass through
+			const Common::Point topLeft(_gridLeft + x * kCellSize, _gridTop + y * kCellSize);
+			const Common::Point bottomRight(topLeft.x + kCellSize, topLeft.y + kCellSize);
+			const int a1 = area(a, b, topLeft);
+			const int a2 = area(a, b, bottomRight);
+			const int a3 = area(a, b, Common::Point(topLeft.x, bottomRight.y));
+			const int a4 = area(a, b, Common::Point(bottomRight.x, topLeft.y));
+			if ((a1 > 0 && a2 > 0 && a3 > 0 && a4 > 0) || (a1 < 0 && a2 < 0 && a3 < 0 && a4 < 0))
+				continue;
+
+			const int cell = y * _gridWidth + x;
+			for (uint i = _cellStart[cell]; i < _cellStart[cell + 1]; i++) {
+				const int edge = _cellEdges[i];
+				if (_edgeStamp[edge] == _stamp)
+					continue;
+				_edgeStamp[edge] = _stamp;
+
+				if (isEdgeBlocking(a, b, edge))
+					return false;
 			}
 		}
+	}
 
-		if (j == s->vertices)
-			visVerts->push_front(vertex);
+	return true;
+}
+
+/**
+ * Keeps the visibility graphs of the polygon sets used most recently in the
+ * current room.
+ */
+class PathfindingCache {
+public:
+	PathfindingCache() : _room(-1) {}
+	~PathfindingCache() { clear(); }
+
+	/**
+	 * Returns the visibility graph for the given polygon set, which is
+	 * built if it isn't cached yet. The graph remains owned by the cache.
+	 */
+	VisibilityGraph *getGraph(int room, const PolygonList &polygons);
+
+	void clear();
+
+private:
+	enum {
+		kMaxGraphs = 4
+	};
+
+	int _room;
+	Common::List<VisibilityGraph *> _graphs; // Most recently used first
+};
+
+VisibilityGraph *PathfindingCache::getGraph(int room, const PolygonList &polygons) {
+	if (room != _room) {
+		clear();
+		_room = room;
+	}
+
+	for (Common::List<VisibilityGraph *>::iterator it = _graphs.begin(); it != _graphs.end(); ++it) {
+		if ((*it)->matches(polygons)) {
+			VisibilityGraph *graph = *it;
+			_graphs.erase(it);
+			_graphs.push_front(graph);
+			debugC(kDebugLevelAvoidPath, "AvoidPath: Using cached visibility graph");
+			return graph;
+		}
 	}
 
-	return visVerts;
+	if (_graphs.size() >= kMaxGraphs) {
+		delete _graphs.back();
+		_graphs.pop_back();
+	}
+
+	VisibilityGraph *graph = new VisibilityGraph(polygons);
+	_graphs.push_front(graph);
+	return graph;
+}
+
+void PathfindingCache::clear() {
+	for (Common::List<VisibilityGraph *>::iterator it = _graphs.begin(); it != _graphs.end(); ++it)
+		delete *it;
+	_graphs.clear();
+}
+
+void freePathfindingCache(PathfindingCache *cache) {
+	delete cache;
+}
+
+PathfindingState::~PathfindingState() {
+	free(vertex_index);
+
+	delete _prependPoint;
+	delete _appendPoint;
+
+	if (_ownsGraph)
+		delete _graph;
+
+	for (PolygonList::iterator it = polygons.begin(); it != polygons.end(); ++it) {
+		delete *it;
+	}
+}
+
+/**
+ * Determines whether or not two vertices of the pathfinding state can see
+ * each other
+ * @param s		the pathfinding state
+ * @param a, b	the vertices
+ * @return true if a and b are visible from each other, false otherwise
+ */
+static bool visible(PathfindingState *s, Vertex *a, Vertex *b) {
+	if (a->graphIndex >= 0 && b->graphIndex >= 0)
+		return s->_graph->isVisible(a->graphIndex, b->graphIndex);
+
+	if (a == b)
+		return false;
+
+	return s->_graph->isVisible(a->v, a->graphIndex, b->v, b->graphIndex);
 }
 
 /**
@@ -1276,6 +1590,13 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	// Look up the visibility graph of the obstacles, before the start and
+	// end points are merged into the polygon set
+	if (!s->_pathfindingCache)
+		s->_pathfindingCache = new PathfindingCache();
+	VisibilityGraph *graph = s->_pathfindingCache->getGraph(s->currentRoomNumber(), pf_s->polygons);
+	const uint polygonCount = pf_s->polygons.size();
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
@@ -1293,15 +1614,95 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		Vertex *vertex;
 
 		CLIST_FOREACH(vertex, &polygon->vertices) {
+			vertex->index = count;
 			pf_s->vertex_index[count++] = vertex;
 		}
 	}
 
 	pf_s->vertices = count;
 
+	// Points which didn't match an existing vertex were either added as
+	// single-vertex polygons at the front of the list, which leaves the
+	// obstacles unchanged, or they split an edge. In the latter case the
+	// cached graph doesn't apply, and we build one for this request only.
+	const uint addedPolygons = pf_s->polygons.size() - polygonCount;
+
+	if (count - graph->getVertexCount() == addedPolygons) {
+		pf_s->_graph = graph;
+		for (int i = addedPolygons; i < count; i++)
+			pf_s->vertex_index[i]->graphIndex = i - addedPolygons;
+	} else {
+		pf_s->_graph = new VisibilityGraph(pf_s->polygons);
+		pf_s->_ownsGraph = true;
+		for (int i = 0; i < count; i++)
+			pf_s->vertex_index[i]->graphIndex = i;
+	}
+
 	return pf_s;
 }
 
+/**
+ * Entry of the AStar open set. Among vertices with the same F cost, the one
+ * added to the open set last is expanded first.
+ */
+struct OpenSetEntry {
+	uint32 costF;
+	uint32 order;
+	Vertex *vertex;
+
+	OpenSetEntry(uint32 f, uint32 o, Vertex *v) : costF(f), order(o), vertex(v) {}
+
+	bool operator<(const OpenSetEntry &e) const {
+		return costF < e.costF || (costF == e.costF && order > e.order);
+	}
+};
+
+/**
+ * Binary min-heap of open set entries
+ */
+class OpenSet {
+public:
+	bool empty() const { return _heap.empty(); }
+
+	void push(const OpenSetEntry &entry) {
+		uint i = _heap.size();
+		_heap.push_back(entry);
+
+		while (i > 0) {
+			uint parent = (i - 1) / 2;
+			if (!(_heap[i] < _heap[parent]))
+				break;
+			SWAP(_heap[i], _heap[parent]);
+			i = parent;
+		}
+	}
+
+	OpenSetEntry pop() {
+		OpenSetEntry top = _heap[0];
+		_heap[0] = _heap.back();
+		_heap.pop_back();
+
+		uint i = 0;
+		while (true) {
+			uint smallest = i;
+			uint l = 2 * i + 1, r = 2 * i + 2;
+			if (l < _heap.size() && _heap[l] < _heap[smallest])
+				smallest = l;
+			if (r < _heap.size() && _heap[r] < _heap[smallest])
+				smallest = r;
+			if (smallest == i)
+				break;
+			SWAP(_heap[i], _heap[smallest]);
+			i = smallest;
+		}
+
+		return top;
+	}
+
+private:
+	Common::Array<OpenSetEntry> _heap;
+};
+
 /**
  * Computes a shortest path from vertex_start to vertex_end. The caller can
  * construct the resulting path by following the path_prev links from
@@ -1310,52 +1711,68 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
  * Parameters: (PathfindingState *) s: The pathfinding state
  */
 static void AStar(PathfindingState *s) {
-	// Vertices of which the shortest path is known
-	VertexList closedSet;
+	enum {
+		kUnvisited = 0,
+		kOpen = 1,
+		kClosed = 2
+	};
+
+	// State of each vertex, and the order in which vertices entered the
+	// open set. The open set may contain outdated entries for vertices
+	// whose cost was lowered later on, these are skipped.
+	Common::Array<byte> state;
+	Common::Array<uint32> openOrder;
+	state.resize(s->vertices);
+	openOrder.resize(s->vertices);
+	uint32 nextOrder = 0;
+	bool found = false;
 
-	// The remaining vertices
-	VertexList openSet;
+	OpenSet openSet;
 
-	openSet.push_front(s->vertex_start);
 	s->vertex_start->costG = 0;
 	s->vertex_start->costF = (uint32)sqrt((float)s->vertex_start->v.sqrDist(s->vertex_end->v));
+	state[s->vertex_start->index] = kOpen;
+	openOrder[s->vertex_start->index] = nextOrder++;
+	openSet.push(OpenSetEntry(s->vertex_start->costF, openOrder[s->vertex_start->index], s->vertex_start));
+
+	// WORKAROUND: The screen edge penalty below fails in QFG1VGA, room 81 (bug report #3568452).
+	// However, it is needed in other SCI1.1 games, such as LB2. Therefore, we
+	// add this workaround for that scene in QFG1VGA, until our algorithm matches
+	// better what SSCI is doing. With this workaround, QFG1VGA no longer freezes
+	// in that scene.
+	bool qfg1VgaWorkaround = (g_sci->getGameId() == GID_QFG1VGA &&
+							  g_sci->getEngineState()->currentRoomNumber() == 81);
 
 	while (!openSet.empty()) {
 		// Find vertex in open set with lowest F cost
-		VertexList::iterator vertex_min_it = openSet.end();
-		Vertex *vertex_min = 0;
-		uint32 min = HUGE_DISTANCE;
-
-		for (VertexList::iterator it = openSet.begin(); it != openSet.end(); ++it) {
-			Vertex *vertex = *it;
-			if (vertex->costF < min) {
-				vertex_min_it = it;
-				vertex_min = *vertex_min_it;
-				min = vertex->costF;
-			}
-		}
+		OpenSetEntry entry = openSet.pop();
+		Vertex *vertex_min = entry.vertex;
 
-		assert(vertex_min != 0);	// the vertex cost should never be bigger than HUGE_DISTANCE
+		if (state[vertex_min->index] != kOpen || entry.costF != vertex_min->costF)
+			continue;
 
 		// Check if we are done
-		if (vertex_min == s->vertex_end)
+		if (vertex_min == s->vertex_end) {
+			found = true;
 			break;
+		}
 
 		// Move vertex from set open to set closed
-		closedSet.push_front(vertex_min);
-		openSet.erase(vertex_min_it);
+		state[vertex_min->index] = kClosed;
 
-		VertexList *visVerts = visible_vertices(s, vertex_min);
-
-		for (VertexList::iterator it = visVerts->begin(); it != visVerts->end(); ++it) {
+		// Visit the neighbours in the same order as the list-based
+		// implementation this replaces, so that ties are broken the same way
+		for (int i = s->vertices - 1; i >= 0; i--) {
 			uint32 new_dist;
-			Vertex *vertex = *it;
+			Vertex *vertex = s->vertex_index[i];
 
-			if (closedSet.contains(vertex))
+			if (state[i] == kClosed || !visible(s, vertex_min, vertex))
 				continue;
 
-			if (!openSet.contains(vertex))
-				openSet.push_front(vertex);
+			if (state[i] == kUnvisited) {
+				state[i] = kOpen;
+				openOrder[i] = nextOrder++;
+			}
 
 			new_dist = vertex_min->costG + (uint32)sqrt((float)vertex_min->v.sqrDist(vertex->v));
 
@@ -1366,15 +1783,6 @@ static void AStar(PathfindingState *s) {
 			// other, while we apply a penalty to paths traversing it.
 			// This difference might lead to problems, but none are
 			// known at the time of writing.
-
-			// WORKAROUND: This check fails in QFG1VGA, room 81 (bug report #3568452).
-			// However, it is needed in other SCI1.1 games, such as LB2. Therefore, we
-			// add this workaround for that scene in QFG1VGA, until our algorithm matches
-			// better what SSCI is doing. With this workaround, QFG1VGA no longer freezes
-			// in that scene.
-			bool qfg1VgaWorkaround = (g_sci->getGameId() == GID_QFG1VGA &&
-									  g_sci->getEngineState()->currentRoomNumber() == 81);
-
 			if (s->pointOnScreenBorder(vertex->v) && !qfg1VgaWorkaround)
 				new_dist += 10000;
 
@@ -1382,13 +1790,12 @@ static void AStar(PathfindingState *s) {
 				vertex->costG = new_dist;
 				vertex->costF = vertex->costG + (uint32)sqrt((float)vertex->v.sqrDist(s->vertex_end->v));
 				vertex->path_prev = vertex_min;
+				openSet.push(OpenSetEntry(vertex->costF, openOrder[i], vertex));
 			}
 		}
-
-		delete visVerts;
 	}
 
-	if (openSet.empty())
+	if (!found)
 		debugC(kDebugLevelAvoidPath, "AvoidPath: End point (%i, %i) is unreachable", s->vertex_end->v.x, s->vertex_end->v.y);
 }
 
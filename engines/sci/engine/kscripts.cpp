@@ -206,6 +206,11 @@ reg_t kScriptID(EngineState *s, int argc, reg_t *argv) {
 	if (argv[0].getSegment())
 		return argv[0];
 
+	// When a new room gets instantiated, fetch the resources it is going
+	// to need along with its script
+	if (script == s->currentRoomNumber() && !s->_segMan->getScriptSegment(script))
+		g_sci->getResMan()->prefetchRoomResources(script);
+
 	SegmentId scriptSeg = s->_segMan->getScriptSegment(script, SCRIPT_GET_LOAD);
 
 	if (!scriptSeg)
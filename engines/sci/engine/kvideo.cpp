@@ -52,6 +52,9 @@ void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState) {
 
 	videoDecoder->start();
 
+	// Keep a few frames decoded, so that expensive frames don't stall playback
+	videoDecoder->setDecodeAhead(4);
+
 	byte *scaleBuffer = 0;
 	byte bytesPerPixel = videoDecoder->getPixelFormat().bytesPerPixel;
 	uint16 width = videoDecoder->getWidth();
@@ -124,9 +127,13 @@ void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState) {
 				skipVideo = true;
 		}
 
+		// Use the time until the next frame to decode ahead
+		videoDecoder->updateDecodeAhead();
 		g_system->delayMillis(10);
 	}
 
+	debugC(kDebugLevelGraphics, "Video %s finished, %d frames were late", videoState.fileName.c_str(), videoDecoder->getLateFrameCount());
+
 	delete[] scaleBuffer;
 	delete videoDecoder;
 }
@@ -64,6 +64,8 @@ void Script::freeScript() {
 	_lockers = 1;
 	_markedAsDeleted = false;
 	_objects.clear();
+
+	invalidateInstructionCache();
 }
 
 void Script::load(int script_nr, ResourceManager *resMan, ScriptPatcher *scriptPatcher) {
@@ -464,9 +466,42 @@ void Script::mcpyInOut(int dst, const void *src, size_t n) {
 	if (_buf) {
 		assert(dst + n <= _bufSize);
 		memcpy(_buf + dst, src, n);
+		invalidateInstructionCache();
 	}
 }
 
+const DecodedInstruction &Script::getDecodedInstruction(uint32 offset) {
+	assert(offset < _bufSize);
+
+	// The index is allocated lazily, so that scripts which are only loaded
+	// for their objects don't pay for it
+	if (_instructionIndex.empty())
+		_instructionIndex.resize(_bufSize);
+
+	const uint16 index = _instructionIndex[offset];
+	if (index)
+		return _decodedInstructions[index - 1];
+
+	DecodedInstruction instr;
+	instr.size = readPMachineInstruction(_buf + offset, instr.extOpcode, instr.opparams);
+
+	if (_decodedInstructions.size() >= 0xFFFF) {
+		// The index is full, which can only happen with very large SCI3
+		// scripts. Keep decoding the remaining instructions on the fly.
+		_uncachedInstruction = instr;
+		return _uncachedInstruction;
+	}
+
+	_decodedInstructions.push_back(instr);
+	_instructionIndex[offset] = _decodedInstructions.size();
+	return _decodedInstructions.back();
+}
+
+void Script::invalidateInstructionCache() {
+	_instructionIndex.clear();
+	_decodedInstructions.clear();
+}
+
 bool Script::isValidOffset(uint16 offset) const {
 	return offset < _bufSize;
 }
@@ -49,6 +49,15 @@ enum ScriptObjectTypes {
 
 typedef Common::HashMap<uint16, Object> ObjMap;
 
+/**
+ * A decoded p-machine instruction, as returned by readPMachineInstruction().
+ */
+struct DecodedInstruction {
+	byte extOpcode; /**< Extended opcode, the lower bit selects the operand size */
+	uint16 size; /**< Size of the instruction in bytes, including its operands */
+	int16 opparams[4]; /**< Decoded operands */
+};
+
 class Script : public SegmentObj {
 private:
 	int _nr; /**< Script number */
@@ -75,6 +84,15 @@ private:
 
 	ObjMap _objects;	/**< Table for objects, contains property variables */
 
+	/**
+	 * Decoded instruction cache, indexed by script buffer offset. Each entry
+	 * holds the 1-based index of the instruction in _decodedInstructions, or
+	 * 0 if the instruction at that offset hasn't been decoded yet.
+	 */
+	Common::Array<uint16> _instructionIndex;
+	Common::Array<DecodedInstruction> _decodedInstructions;
+	DecodedInstruction _uncachedInstruction;
+
 public:
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
@@ -92,6 +110,25 @@ public:
 	const ObjMap &getObjectMap() const { return _objects; }
 	bool offsetIsObject(uint16 offset) const;
 
+	/**
+	 * Returns the decoded instruction at the given offset. Instructions are
+	 * decoded on first use and cached until the script is unloaded or its
+	 * buffer is modified. The returned reference is only valid until the
+	 * next call.
+	 */
+	const DecodedInstruction &getDecodedInstruction(uint32 offset);
+
+	/**
+	 * Discards all decoded instructions. Must be called whenever the code
+	 * in the script buffer is changed.
+	 */
+	void invalidateInstructionCache();
+
+	/**
+	 * Returns the number of instructions in the decoded instruction cache.
+	 */
+	uint getDecodedInstructionCount() const { return _decodedInstructions.size(); }
+
 public:
 	Script();
 	~Script();
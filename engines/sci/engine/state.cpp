@@ -33,6 +33,7 @@
 #include "sci/engine/vm.h"
 #include "sci/engine/script.h"
 #include "sci/engine/message.h"
+#include "sci/engine/gc.h"
 
 namespace Sci {
 
@@ -75,11 +76,15 @@ EngineState::EngineState(SegManager *segMan)
 #endif
 	_dirseeker() {
 
+	_gc = new GarbageCollector();
+	_pathfindingCache = 0;
 	reset(false);
 }
 
 EngineState::~EngineState() {
+	delete _gc;
 	delete _msgState;
+	freePathfindingCache(_pathfindingCache);
 #ifdef ENABLE_SCI32
 	delete _virtualIndexFile;
 #endif
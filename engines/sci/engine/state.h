@@ -47,6 +47,8 @@ class FileHandle;
 class DirSeeker;
 class EventManager;
 class MessageState;
+class GarbageCollector;
+class PathfindingCache;
 class SoundCommandParser;
 class VirtualIndexFile;
 
@@ -184,9 +186,12 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	GarbageCollector *_gc;
 
 	MessageState *_msgState;
 
+	PathfindingCache *_pathfindingCache; /**< Visibility graphs used by kAvoidPath, created on first use */
+
 	// MemorySegment provides access to a 256-byte block of memory that remains
 	// intact across restarts and restores
 	enum {
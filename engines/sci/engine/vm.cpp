@@ -22,6 +22,7 @@
 
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/system.h"
 
 #include "sci/sci.h"
 #include "sci/console.h"
@@ -535,9 +536,47 @@ int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4])
 	return offset;
 }
 
+/**
+ * Runs or stops the vm_benchmark clock while in scope, and restores its
+ * previous state afterwards. The clock runs while bytecode is interpreted
+ * and is stopped during kernel calls; VMs spawned by kernel functions
+ * restart it for their duration.
+ */
+class BenchmarkClockScope {
+public:
+	BenchmarkClockScope(bool run) : _wasRunning(g_sci->_debugState.benchmarkClockRunning) {
+		setRunning(run);
+	}
+
+	~BenchmarkClockScope() {
+		setRunning(_wasRunning);
+	}
+
+private:
+	static void setRunning(bool run) {
+		DebugState &debugState = g_sci->_debugState;
+		if (debugState.benchmarkClockRunning == run)
+			return;
+
+		debugState.benchmarkClockRunning = run;
+		if (!debugState.benchmarking)
+			return;
+
+		if (run)
+			debugState.benchmarkClock = g_system->getMillis();
+		else
+			debugState.benchmarkTime += g_system->getMillis() - debugState.benchmarkClock;
+	}
+
+	bool _wasRunning;
+};
+
 void run_vm(EngineState *s) {
 	assert(s);
 
+	BenchmarkClockScope benchmarkClock(true);
+	Console *con = g_sci->getSciDebugger();
+
 	int temp;
 	reg_t r_temp; // Temporary register
 	StackPtr s_temp; // Temporary stack pointer
@@ -608,7 +647,6 @@ void run_vm(EngineState *s) {
 			g_sci->scriptDebug();
 			g_sci->_debugState.breakpointWasHit = false;
 		}
-		Console *con = g_sci->getSciDebugger();
 		con->onFrame();
 
 		if (s->xs->sp < s->xs->fp)
@@ -621,9 +659,12 @@ void run_vm(EngineState *s) {
 			error("run_vm(): program counter gone astray, addr: %d, code buffer size: %d",
 			s->xs->addr.pc.getOffset(), scr->getBufSize());
 
-		// Get opcode
-		byte extOpcode;
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		// Get opcode. Instructions are only decoded once per script, later
+		// executions are served from the script's decoded instruction cache.
+		const DecodedInstruction &instr = scr->getDecodedInstruction(s->xs->addr.pc.getOffset());
+		const byte extOpcode = instr.extOpcode;
+		memcpy(opparams, instr.opparams, sizeof(opparams));
+		s->xs->addr.pc.incOffset(instr.size);
 		const byte opcode = extOpcode >> 1;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
@@ -845,10 +886,12 @@ void run_vm(EngineState *s) {
 		}
 
 		case op_callk: { // 0x21 (33)
-			// Run the garbage collector, if needed
-			if (s->gcCountDown-- <= 0) {
-				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+			// Run the garbage collector, if needed. kGetEvent is called once
+			// per game cycle, collecting there keeps it out of the cycle.
+			{
+				const Kernel *kernel = g_sci->getKernel();
+				s->_gc->kernelCall(s, (uint)opparams[0] < kernel->_kernelFuncs.size() &&
+				                      kernel->_kernelFuncs[opparams[0]].function == kGetEvent);
 			}
 
 			// Call kernel function
@@ -863,7 +906,11 @@ void run_vm(EngineState *s) {
 			if (!oldScriptHeader)
 				argc += s->r_rest;
 
-			callKernelFunc(s, opparams[0], argc);
+			{
+				BenchmarkClockScope kernelClock(false);
+				callKernelFunc(s, opparams[0], argc);
+			}
+			++g_sci->_debugState.benchmarkKernelCalls;
 
 			if (!oldScriptHeader)
 				s->r_rest = 0;
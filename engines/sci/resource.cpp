@@ -22,6 +22,7 @@
 
 // Resource library
 
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
@@ -861,9 +862,7 @@ ResourceManager::ResourceManager() {
 }
 
 void ResourceManager::init() {
-	_memoryLocked = 0;
-	_memoryLRU = 0;
-	_LRU.clear();
+	initCache();
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 
@@ -914,6 +913,15 @@ void ResourceManager::init() {
 
 	debugC(1, kDebugLevelResMan, "resMan: Detected %s", getSciVersionDesc(getSciVersion()));
 
+	// SCI32 games come with far bigger resources, so give them more room
+	if (ConfMan.hasKey("resource_cache_size"))
+		_maxMemoryLRU = MAX(ConfMan.getInt("resource_cache_size"), 0) * 1024;
+	else if (getSciVersion() >= SCI_VERSION_2)
+		_maxMemoryLRU = DEFAULT_MAX_MEMORY_SCI32;
+	_prefetchRoomResources = ConfMan.getBool("prefetch_room_resources");
+
+	debugC(1, kDebugLevelResMan, "resMan: Caching up to %d KB of unlocked resources", _maxMemoryLRU / 1024);
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -947,9 +955,7 @@ void ResourceManager::init() {
 void ResourceManager::initForDetection() {
 	assert(!g_sci);
 
-	_memoryLocked = 0;
-	_memoryLRU = 0;
-	_LRU.clear();
+	initCache();
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 
@@ -976,13 +982,60 @@ ResourceManager::~ResourceManager() {
 	}
 }
 
+void ResourceManager::initCache() {
+	_memoryLocked = 0;
+	_memoryLRU = 0;
+	_maxMemoryLRU = DEFAULT_MAX_MEMORY;
+	for (int i = 0; i < kCachePriorityCount; i++) {
+		_memoryLRUPriority[i] = 0;
+		_LRU[i].clear();
+	}
+	_prefetchRoomResources = false;
+	resetCacheStats();
+}
+
+ResourceManager::CachePriority ResourceManager::getCachePriority(ResourceType type) {
+	switch (type) {
+	case kResourceTypeView:
+	case kResourceTypePic:
+	case kResourceTypePalette:
+	case kResourceTypeFont:
+	case kResourceTypeCursor:
+	case kResourceTypeVocab:
+		return kCachePriorityHigh;
+	case kResourceTypeAudio:
+	case kResourceTypeAudio36:
+	case kResourceTypeSync:
+	case kResourceTypeSync36:
+	case kResourceTypeCdAudio:
+	case kResourceTypeRobot:
+	case kResourceTypeVMD:
+	case kResourceTypeDuck:
+	case kResourceTypeRave:
+		return kCachePriorityLow;
+	default:
+		return kCachePriorityNormal;
+	}
+}
+
+void ResourceManager::resetCacheStats() {
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
+}
+
+void ResourceManager::setCacheLimit(uint32 bytes) {
+	_maxMemoryLRU = bytes;
+	freeOldResources();
+}
+
 void ResourceManager::removeFromLRU(Resource *res) {
 	if (res->_status != kResStatusEnqueued) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
+	const CachePriority priority = getCachePriority(res->getType());
+	_LRU[priority].remove(res);
 	_memoryLRU -= res->size;
+	_memoryLRUPriority[priority] -= res->size;
 	res->_status = kResStatusAllocated;
 }
 
@@ -991,8 +1044,10 @@ void ResourceManager::addToLRU(Resource *res) {
 		warning("resMan: trying to enqueue resource with state %d", res->_status);
 		return;
 	}
-	_LRU.push_front(res);
+	const CachePriority priority = getCachePriority(res->getType());
+	_LRU[priority].push_front(res);
 	_memoryLRU += res->size;
+	_memoryLRUPriority[priority] += res->size;
 #if SCI_VERBOSE_RESMAN
 	debug("Adding %s.%03d (%d bytes) to lru control: %d bytes total",
 	      getResourceTypeName(res->type), res->number, res->size,
@@ -1004,24 +1059,34 @@ void ResourceManager::addToLRU(Resource *res) {
 void ResourceManager::printLRU() {
 	int mem = 0;
 	int entries = 0;
-	Common::List<Resource *>::iterator it = _LRU.begin();
 	Resource *res;
 
-	while (it != _LRU.end()) {
-		res = *it;
-		debug("\t%s: %d bytes", res->_id.toString().c_str(), res->size);
-		mem += res->size;
-		++entries;
-		++it;
+	for (int i = kCachePriorityCount - 1; i >= 0; i--) {
+		Common::List<Resource *>::iterator it = _LRU[i].begin();
+
+		while (it != _LRU[i].end()) {
+			res = *it;
+			debug("\t%s: %d bytes", res->_id.toString().c_str(), res->size);
+			mem += res->size;
+			++entries;
+			++it;
+		}
 	}
 
 	debug("Total: %d entries, %d bytes (mgr says %d)", entries, mem, _memoryLRU);
 }
 
 void ResourceManager::freeOldResources() {
-	while (MAX_MEMORY < _memoryLRU) {
-		assert(!_LRU.empty());
-		Resource *goner = *_LRU.reverse_begin();
+	while (_maxMemoryLRU < (uint32)_memoryLRU) {
+		// Free the least recently used resource of the lowest priority
+		int priority = 0;
+		while (_LRU[priority].empty()) {
+			priority++;
+			assert(priority < kCachePriorityCount);
+		}
+		Resource *goner = *_LRU[priority].reverse_begin();
+		_cacheStats.evictions++;
+		_cacheStats.evictedBytes += goner->size;
 		removeFromLRU(goner);
 		goner->unalloc();
 #ifdef SCI_VERBOSE_RESMAN
@@ -1049,10 +1114,14 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (retval->_status == kResStatusNoMalloc) {
+		_cacheStats.misses++;
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
-		removeFromLRU(retval);
+	} else {
+		_cacheStats.hits++;
+		if (retval->_status == kResStatusEnqueued)
+			removeFromLRU(retval);
+	}
 	// Unless an error occurred, the resource is now either
 	// locked or allocated, but never queued or freed.
 
@@ -1078,6 +1147,31 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	}
 }
 
+void ResourceManager::prefetchRoomResources(uint16 roomNumber) {
+	if (!_prefetchRoomResources)
+		return;
+
+	static const ResourceType prefetchTypes[] = {
+		kResourceTypePic, kResourceTypeView, kResourceTypePalette,
+		kResourceTypeText, kResourceTypeMessage, kResourceTypeHeap
+	};
+
+	for (int i = 0; i < ARRAYSIZE(prefetchTypes); i++) {
+		Resource *res = testResource(ResourceId(prefetchTypes[i], roomNumber));
+		if (!res || res->_status != kResStatusNoMalloc)
+			continue;
+
+		loadResource(res);
+		if (res->_status != kResStatusAllocated)
+			continue;
+
+		debugC(2, kDebugLevelResMan, "[resMan] Prefetched %s for room %d", res->_id.toString().c_str(), roomNumber);
+		_cacheStats.prefetches++;
+		addToLRU(res);
+		freeOldResources();
+	}
+}
+
 void ResourceManager::unlockResource(Resource *res) {
 	assert(res);
 
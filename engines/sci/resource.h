@@ -367,6 +367,50 @@ public:
 	 */
 	Common::List<ResourceId> listResources(ResourceType type, int mapNumber = -1);
 
+	/**
+	 * Priorities of the resources kept in memory after they were unlocked.
+	 * When memory runs short, the resources with the lowest priority are
+	 * freed first.
+	 */
+	enum CachePriority {
+		kCachePriorityLow,      ///< Audio and video, usually played only once
+		kCachePriorityNormal,
+		kCachePriorityHigh,     ///< Pics, views, palettes and fonts
+		kCachePriorityCount
+	};
+
+	/** Statistics about the resource cache */
+	struct CacheStats {
+		uint32 hits;            ///< Lookups of resources which were in memory
+		uint32 misses;          ///< Lookups which had to load the resource
+		uint32 evictions;       ///< Resources freed to stay within the limit
+		uint32 evictedBytes;    ///< Total size of the freed resources
+		uint32 prefetches;      ///< Resources loaded by prefetchRoomResources()
+	};
+
+	const CacheStats &getCacheStats() const { return _cacheStats; }
+	void resetCacheStats();
+
+	/**
+	 * Returns the number of bytes which may be used by resources which are
+	 * not locked.
+	 */
+	uint32 getCacheLimit() const { return _maxMemoryLRU; }
+	void setCacheLimit(uint32 bytes);
+
+	/** Returns the number of bytes used by unlocked resources of a priority */
+	uint32 getCacheMemory(CachePriority priority) const { return _memoryLRUPriority[priority]; }
+	uint32 getCacheEntries(CachePriority priority) const { return _LRU[priority].size(); }
+	uint32 getLockedMemory() const { return _memoryLocked; }
+
+	/**
+	 * Loads the resources that belong to a room into the cache, so that
+	 * they are not read from disk while the room is being set up. These are
+	 * the resources which share the number of the room script.
+	 * Does nothing if prefetching has not been enabled.
+	 */
+	void prefetchRoomResources(uint16 roomNumber);
+
 	void setAudioLanguage(int language);
 	int getAudioLanguage() const;
 	void changeAudioDirectory(Common::String path);
@@ -422,19 +466,24 @@ public:
 	ResourceType convertResType(byte type);
 
 protected:
-	// Maximum number of bytes to allow being allocated for resources
-	// Note: maxMemory will not be interpreted as a hard limit, only as a restriction
-	// for resources which are not explicitly locked. However, a warning will be
-	// issued whenever this limit is exceeded.
+	// Default number of bytes to allow being allocated for resources, unless
+	// overridden by the "resource_cache_size" setting.
+	// Note: the limit will not be interpreted as a hard limit, only as a restriction
+	// for resources which are not explicitly locked.
 	enum {
-		MAX_MEMORY = 256 * 1024	// 256KB
+		DEFAULT_MAX_MEMORY = 256 * 1024,	// 256KB
+		DEFAULT_MAX_MEMORY_SCI32 = 8 * 1024 * 1024	// 8MB
 	};
 
 	ViewType _viewType; // Used to determine if the game has EGA or VGA graphics
 	Common::List<ResourceSource *> _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
-	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	uint32 _maxMemoryLRU;	///< Limit for the resource bytes under LRU control
+	uint32 _memoryLRUPriority[kCachePriorityCount];	///< Resource bytes under LRU control per priority
+	Common::List<Resource *> _LRU[kCachePriorityCount]; ///< Last Resource Used lists, per priority
+	CacheStats _cacheStats;
+	bool _prefetchRoomResources;
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -554,6 +603,8 @@ protected:
 	void printLRU();
 	void addToLRU(Resource *res);
 	void removeFromLRU(Resource *res);
+	void initCache();
+	static CachePriority getCachePriority(ResourceType type);
 
 	ResourceCompression getViewCompression();
 	ViewType detectViewType();
@@ -33,6 +33,7 @@
 #include "sci/event.h"
 
 #include "sci/engine/features.h"
+#include "sci/engine/gc.h"
 #include "sci/engine/message.h"
 #include "sci/engine/object.h"
 #include "sci/engine/state.h"
@@ -198,6 +199,7 @@ Common::Error SciEngine::run() {
 	ConfMan.registerDefault("native_fb01", "false");
 	ConfMan.registerDefault("windows_cursors", "false");	// Windows cursors for KQ6 Windows
 	ConfMan.registerDefault("silver_cursors", "false");	// Silver cursors for SQ4 CD
+	ConfMan.registerDefault("prefetch_room_resources", "false");
 
 	_resMan = new ResourceManager();
 	assert(_resMan);
@@ -579,6 +581,7 @@ bool SciEngine::initGame() {
 
 	_gamestate->_msgState = new MessageState(_gamestate->_segMan);
 	_gamestate->gcCountDown = GC_INTERVAL - 1;
+	_gamestate->_gc->discardPending();
 
 	// Script 0 should always be at segment 1
 	if (script0Segment != 1) {
@@ -957,6 +957,7 @@ public:
 	virtual int getMaximumSaveSlot() const;
 	virtual void removeSaveState(const char *target, int slot) const;
 	virtual SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const;
+	virtual Common::String getSavegameFile(const char *target, int slot) const;
 };
 
 bool ScummMetaEngine::hasFeature(MetaEngineFeature f) const {
@@ -1296,6 +1297,10 @@ void ScummMetaEngine::removeSaveState(const char *target, int slot) const {
 	g_system->getSavefileManager()->removeSavefile(filename);
 }
 
+Common::String ScummMetaEngine::getSavegameFile(const char *target, int slot) const {
+	return ScummEngine::makeSavegameName(target, slot, false);
+}
+
 SaveStateDescriptor ScummMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
 	Common::String saveDesc;
 	Graphics::Surface *thumbnail = nullptr;
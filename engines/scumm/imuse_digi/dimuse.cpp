@@ -105,6 +105,7 @@ void IMuseDigital::resetState() {
 
 void IMuseDigital::saveOrLoad(Serializer *ser) {
 	Common::StackLock lock(_mutex, "IMuseDigital::saveOrLoad()");
+	processCommandQueue();
 
 	const SaveLoadEntry mainEntries[] = {
 		MK_OBSOLETE(IMuseDigital, _volVoice, sleInt32, VER(31), VER(42)),
@@ -210,6 +211,7 @@ void IMuseDigital::saveOrLoad(Serializer *ser) {
 
 void IMuseDigital::callback() {
 	Common::StackLock lock(_mutex, "IMuseDigital::callback()");
+	processCommandQueue();
 
 	for (int l = 0; l < MAX_DIGITAL_TRACKS + MAX_DIGITAL_FADETRACKS; l++) {
 		Track *track = _track[l];
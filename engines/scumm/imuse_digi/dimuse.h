@@ -25,6 +25,7 @@
 
 #include "common/scummsys.h"
 #include "common/mutex.h"
+#include "common/queue.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
@@ -69,6 +70,28 @@ private:
 
 	Track *_track[MAX_DIGITAL_TRACKS + MAX_DIGITAL_FADETRACKS];
 
+	// Track parameter changes requested by scripts. They are queued and
+	// applied by the callback (or before any other locked operation), so
+	// that scripts never wait for the callback to finish streaming.
+	enum CommandType {
+		kCmdSetPriority,
+		kCmdSetVolume,
+		kCmdSetPan,
+		kCmdSetHookId,
+		kCmdSetFade,
+		kCmdSelectVolumeGroup
+	};
+
+	struct Command {
+		CommandType type;
+		int soundId;
+		int param1;
+		int param2;
+	};
+
+	Common::Queue<Command> _cmdQueue;
+	Common::Mutex _cmdMutex;	// only guards _cmdQueue, never held while streaming
+
 	Common::Mutex _mutex;
 	ScummEngine_v7 *_vm;
 	Audio::Mixer *_mixer;
@@ -94,6 +117,10 @@ private:
 	void startSound(int soundId, const char *soundName, int soundType, int volGroupId, Audio::AudioStream *input, int hookId, int volume, int priority, Track *otherTrack);
 	void selectVolumeGroup(int soundId, int volGroupId);
 
+	void queueCommand(CommandType type, int soundId, int param1, int param2 = 0);
+	void processCommandQueue();
+	void applyCommand(const Command &cmd);
+
 	int32 getPosInMs(int soundId);
 	void getLipSync(int soundId, int syncId, int32 msPos, int32 &width, int32 &height);
 
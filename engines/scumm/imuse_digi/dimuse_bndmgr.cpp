@@ -38,6 +38,13 @@ BundleDirCache::BundleDirCache() {
 		_budleDirCache[fileId].isCompressed = false;
 		_budleDirCache[fileId].indexTable = NULL;
 	}
+
+	for (int i = 0; i < kNumCachedBlocks; i++) {
+		_blockCache[i].slot = -1;
+		_blockCache[i].lastUsed = 0;
+	}
+	_blockCacheData = NULL;
+	_blockCacheCounter = 0;
 }
 
 BundleDirCache::~BundleDirCache() {
@@ -45,6 +52,45 @@ BundleDirCache::~BundleDirCache() {
 		free(_budleDirCache[fileId].bundleTable);
 		free(_budleDirCache[fileId].indexTable);
 	}
+	free(_blockCacheData);
+}
+
+bool BundleDirCache::getDecompressedBlock(int slot, int32 index, int32 block, byte *output, int &outputSize) {
+	for (int i = 0; i < kNumCachedBlocks; i++) {
+		CachedBlock &entry = _blockCache[i];
+		if (entry.slot == slot && entry.index == index && entry.block == block) {
+			entry.lastUsed = ++_blockCacheCounter;
+			memcpy(output, _blockCacheData + i * kBlockSize, entry.size);
+			outputSize = entry.size;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void BundleDirCache::storeDecompressedBlock(int slot, int32 index, int32 block, const byte *data, int size) {
+	assert(size <= kBlockSize);
+
+	if (!_blockCacheData) {
+		_blockCacheData = (byte *)malloc(kNumCachedBlocks * kBlockSize);
+		assert(_blockCacheData);
+	}
+
+	// Replace the least recently used block
+	int oldest = 0;
+	for (int i = 1; i < kNumCachedBlocks; i++) {
+		if (_blockCache[i].lastUsed < _blockCache[oldest].lastUsed)
+			oldest = i;
+	}
+
+	CachedBlock &entry = _blockCache[oldest];
+	entry.slot = slot;
+	entry.index = index;
+	entry.block = block;
+	entry.size = size;
+	entry.lastUsed = ++_blockCacheCounter;
+	memcpy(_blockCacheData + oldest * kBlockSize, data, size);
 }
 
 BundleDirCache::AudioTable *BundleDirCache::getTable(int slot) {
@@ -186,6 +232,7 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 
 	int slot = _cache->matchFile(filename);
 	assert(slot != -1);
+	_fileBundleId = slot;
 	compressed = _cache->isSndDataExtComp(slot);
 	_numFiles = _cache->getNumFiles(slot);
 	assert(_numFiles);
@@ -209,6 +256,7 @@ void BundleMgr::close() {
 		_lastBlock = -1;
 		_outputSize = 0;
 		_curSampleId = -1;
+		_fileBundleId = -1;
 		free(_compTable);
 		_compTable = NULL;
 		free(_compInputBuff);
@@ -287,7 +335,7 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 	skip = (offset + headerSize) % 0x2000;
 
 	for (i = firstBlock; i <= lastBlock; i++) {
-		if (_lastBlock != i) {
+		if (_lastBlock != i && !_cache->getDecompressedBlock(_fileBundleId, index, i, _compOutputBuff, _outputSize)) {
 			// CMI hack: one more zero byte at the end of input buffer
 			_compInputBuff[_compTable[i].size] = 0;
 			_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
@@ -296,8 +344,9 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 			if (_outputSize > 0x2000) {
 				error("_outputSize: %d", _outputSize);
 			}
-			_lastBlock = i;
+			_cache->storeDecompressedBlock(_fileBundleId, index, i, _compOutputBuff, _outputSize);
 		}
+		_lastBlock = i;
 
 		outputSize = _outputSize;
 
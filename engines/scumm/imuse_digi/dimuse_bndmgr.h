@@ -53,6 +53,25 @@ private:
 		IndexNode *indexTable;
 	} _budleDirCache[4];
 
+	enum {
+		kBlockSize = 0x2000,
+		kNumCachedBlocks = 128
+	};
+
+	// Decompressed blocks, shared by all sounds playing from the bundles.
+	// Crossfades and jumps play several regions of the same sound at once,
+	// which would otherwise decompress the same blocks over and over.
+	struct CachedBlock {
+		int slot;
+		int32 index;
+		int32 block;
+		int size;
+		uint32 lastUsed;
+	} _blockCache[kNumCachedBlocks];
+
+	byte *_blockCacheData;
+	uint32 _blockCacheCounter;
+
 public:
 	BundleDirCache();
 	~BundleDirCache();
@@ -62,6 +81,9 @@ public:
 	IndexNode *getIndexTable(int slot);
 	int32 getNumFiles(int slot);
 	bool isSndDataExtComp(int slot);
+
+	bool getDecompressedBlock(int slot, int32 index, int32 block, byte *output, int &outputSize);
+	void storeDecompressedBlock(int slot, int32 index, int32 block, const byte *data, int size);
 };
 
 class BundleMgr {
@@ -186,6 +186,7 @@ void IMuseDigital::flushTrack(Track *track) {
 
 void IMuseDigital::flushTracks() {
 	Common::StackLock lock(_mutex, "IMuseDigital::flushTracks()");
+	processCommandQueue();
 	debug(6, "flushTracks()");
 	for (int l = 0; l < MAX_DIGITAL_TRACKS + MAX_DIGITAL_FADETRACKS; l++) {
 		Track *track = _track[l];
@@ -198,6 +199,7 @@ void IMuseDigital::flushTracks() {
 
 void IMuseDigital::refreshScripts() {
 	Common::StackLock lock(_mutex, "IMuseDigital::refreshScripts()");
+	processCommandQueue();
 	debug(6, "refreshScripts()");
 
 	if (_stopingSequence) {
@@ -266,6 +268,7 @@ void IMuseDigital::getLipSync(int soundId, int syncId, int32 msPos, int32 &width
 	msPos /= 16;
 	if (msPos < 65536) {
 		Common::StackLock lock(_mutex, "IMuseDigital::getLipSync()");
+		processCommandQueue();
 		for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
 			Track *track = _track[l];
 			if (track->used && !track->toBeRemoved && (track->soundId == soundId)) {
@@ -294,6 +297,7 @@ void IMuseDigital::getLipSync(int soundId, int syncId, int32 msPos, int32 &width
 
 int32 IMuseDigital::getPosInMs(int soundId) {
 	Common::StackLock lock(_mutex, "IMuseDigital::getPosInMs()");
+	processCommandQueue();
 	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
 		Track *track = _track[l];
 		if (track->used && !track->toBeRemoved && (track->soundId == soundId)) {
@@ -306,6 +310,8 @@ int32 IMuseDigital::getPosInMs(int soundId) {
 }
 
 int IMuseDigital::getSoundStatus(int soundId) const {
+	// None of the queued commands changes whether a sound is playing, so the
+	// queue does not need to be applied here
 	Common::StackLock lock(_mutex, "IMuseDigital::getSoundStatus()");
 	debug(5, "IMuseDigital::getSoundStatus(%d)", soundId);
 	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
@@ -324,6 +330,7 @@ int IMuseDigital::getSoundStatus(int soundId) const {
 
 void IMuseDigital::stopSound(int soundId) {
 	Common::StackLock lock(_mutex, "IMuseDigital::stopSound()");
+	processCommandQueue();
 	debug(5, "IMuseDigital::stopSound(%d)", soundId);
 	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
 		Track *track = _track[l];
@@ -336,6 +343,7 @@ void IMuseDigital::stopSound(int soundId) {
 
 int32 IMuseDigital::getCurMusicPosInMs() {
 	Common::StackLock lock(_mutex, "IMuseDigital::getCurMusicPosInMs()");
+	processCommandQueue();
 	int soundId = -1;
 
 	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
@@ -352,6 +360,7 @@ int32 IMuseDigital::getCurMusicPosInMs() {
 
 int32 IMuseDigital::getCurVoiceLipSyncWidth() {
 	Common::StackLock lock(_mutex, "IMuseDigital::getCurVoiceLipSyncWidth()");
+	processCommandQueue();
 	int32 msPos = getPosInMs(kTalkSoundID) + 50;
 	int32 width = 0, height = 0;
 
@@ -362,6 +371,7 @@ int32 IMuseDigital::getCurVoiceLipSyncWidth() {
 
 int32 IMuseDigital::getCurVoiceLipSyncHeight() {
 	Common::StackLock lock(_mutex, "IMuseDigital::getCurVoiceLipSyncHeight()");
+	processCommandQueue();
 	int32 msPos = getPosInMs(kTalkSoundID) + 50;
 	int32 width = 0, height = 0;
 
@@ -372,6 +382,7 @@ int32 IMuseDigital::getCurVoiceLipSyncHeight() {
 
 int32 IMuseDigital::getCurMusicLipSyncWidth(int syncId) {
 	Common::StackLock lock(_mutex, "IMuseDigital::getCurMusicLipSyncWidth()");
+	processCommandQueue();
 	int soundId = -1;
 
 	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
@@ -391,6 +402,7 @@ int32 IMuseDigital::getCurMusicLipSyncWidth(int syncId) {
 
 int32 IMuseDigital::getCurMusicLipSyncHeight(int syncId) {
 	Common::StackLock lock(_mutex, "IMuseDigital::getCurMusicLipSyncHeight()");
+	processCommandQueue();
 	int soundId = -1;
 
 	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
@@ -410,6 +422,7 @@ int32 IMuseDigital::getCurMusicLipSyncHeight(int syncId) {
 
 void IMuseDigital::stopAllSounds() {
 	Common::StackLock lock(_mutex, "IMuseDigital::stopAllSounds()");
+	processCommandQueue();
 	debug(5, "IMuseDigital::stopAllSounds");
 
 	for (int l = 0; l < MAX_DIGITAL_TRACKS + MAX_DIGITAL_FADETRACKS; l++) {
@@ -81,6 +81,7 @@ int IMuseDigital::allocSlot(int priority) {
 
 void IMuseDigital::startSound(int soundId, const char *soundName, int soundType, int volGroupId, Audio::AudioStream *input, int hookId, int volume, int priority, Track *otherTrack) {
 	Common::StackLock lock(_mutex, "IMuseDigital::startSound()");
+	processCommandQueue();
 	debug(5, "IMuseDigital::startSound(%d) - begin func", soundId);
 
 	int l = allocSlot(priority);
@@ -175,45 +176,23 @@ void IMuseDigital::startSound(int soundId, const char *soundName, int soundType,
 }
 
 void IMuseDigital::setPriority(int soundId, int priority) {
-	Common::StackLock lock(_mutex, "IMuseDigital::setPriority()");
 	debug(5, "IMuseDigital::setPriority(%d, %d)", soundId, priority);
 	assert ((priority >= 0) && (priority <= 127));
-
-	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
-		Track *track = _track[l];
-		if (track->used && !track->toBeRemoved && (track->soundId == soundId)) {
-			debug(5, "IMuseDigital::setPriority(%d) - setting", soundId);
-			track->soundPriority = priority;
-		}
-	}
+	queueCommand(kCmdSetPriority, soundId, priority);
 }
 
 void IMuseDigital::setVolume(int soundId, int volume) {
-	Common::StackLock lock(_mutex, "IMuseDigital::setVolume()");
 	debug(5, "IMuseDigital::setVolume(%d, %d)", soundId, volume);
-
-	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
-		Track *track = _track[l];
-		if (track->used && !track->toBeRemoved && (track->soundId == soundId)) {
-			debug(5, "IMuseDigital::setVolume(%d) - setting", soundId);
-			track->vol = volume * 1000;
-		}
-	}
+	queueCommand(kCmdSetVolume, soundId, volume);
 }
 
 void IMuseDigital::setHookId(int soundId, int hookId) {
-	Common::StackLock lock(_mutex, "IMuseDigital::setHookId()");
-
-	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
-		Track *track = _track[l];
-		if (track->used && !track->toBeRemoved && (track->soundId == soundId)) {
-			track->curHookId = hookId;
-		}
-	}
+	queueCommand(kCmdSetHookId, soundId, hookId);
 }
 
 int IMuseDigital::getCurMusicSoundId() {
 	Common::StackLock lock(_mutex, "IMuseDigital::getCurMusicSoundId()");
+	processCommandQueue();
 	int soundId = -1;
 
 	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
@@ -228,53 +207,86 @@ int IMuseDigital::getCurMusicSoundId() {
 }
 
 void IMuseDigital::setPan(int soundId, int pan) {
-	Common::StackLock lock(_mutex, "IMuseDigital::setPan()");
 	debug(5, "IMuseDigital::setPan(%d, %d)", soundId, pan);
-
-	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
-		Track *track = _track[l];
-		if (track->used && !track->toBeRemoved && (track->soundId == soundId)) {
-			debug(5, "IMuseDigital::setPan(%d) - setting", soundId);
-			track->pan = pan;
-		}
-	}
+	queueCommand(kCmdSetPan, soundId, pan);
 }
 
 void IMuseDigital::selectVolumeGroup(int soundId, int volGroupId) {
-	Common::StackLock lock(_mutex, "IMuseDigital::selectVolumeGroup()");
 	debug(5, "IMuseDigital::setGroupVolume(%d, %d)", soundId, volGroupId);
 	assert((volGroupId >= 1) && (volGroupId <= 4));
 
 	if (volGroupId == 4)
 		volGroupId = 3;
 
-	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
-		Track *track = _track[l];
-		if (track->used && !track->toBeRemoved && (track->soundId == soundId)) {
-			debug(5, "IMuseDigital::setVolumeGroup(%d) - setting", soundId);
-			track->volGroupId = volGroupId;
-		}
-	}
+	queueCommand(kCmdSelectVolumeGroup, soundId, volGroupId);
 }
 
 void IMuseDigital::setFade(int soundId, int destVolume, int delay60HzTicks) {
-	Common::StackLock lock(_mutex, "IMuseDigital::setFade()");
 	debug(5, "IMuseDigital::setFade(%d, %d, %d)", soundId, destVolume, delay60HzTicks);
+	queueCommand(kCmdSetFade, soundId, destVolume, delay60HzTicks);
+}
+
+void IMuseDigital::queueCommand(CommandType type, int soundId, int param1, int param2) {
+	Command cmd;
+	cmd.type = type;
+	cmd.soundId = soundId;
+	cmd.param1 = param1;
+	cmd.param2 = param2;
 
+	Common::StackLock lock(_cmdMutex, "IMuseDigital::queueCommand()");
+	_cmdQueue.push(cmd);
+}
+
+void IMuseDigital::processCommandQueue() {
+	// Must be called with _mutex held, at the top of every locked method
+	// that reads or changes the track parameters.
+	Common::StackLock lock(_cmdMutex, "IMuseDigital::processCommandQueue()");
+	while (!_cmdQueue.empty())
+		applyCommand(_cmdQueue.pop());
+}
+
+void IMuseDigital::applyCommand(const Command &cmd) {
 	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
 		Track *track = _track[l];
-		if (track->used && !track->toBeRemoved && (track->soundId == soundId)) {
-			debug(5, "IMuseDigital::setFade(%d) - setting", soundId);
-			track->volFadeDelay = delay60HzTicks;
-			track->volFadeDest = destVolume * 1000;
-			track->volFadeStep = (track->volFadeDest - track->vol) * 60 * (1000 / _callbackFps) / (1000 * delay60HzTicks);
+		if (!track->used || track->toBeRemoved || (track->soundId != cmd.soundId))
+			continue;
+
+		switch (cmd.type) {
+		case kCmdSetPriority:
+			debug(5, "IMuseDigital::setPriority(%d) - setting", cmd.soundId);
+			track->soundPriority = cmd.param1;
+			break;
+		case kCmdSetVolume:
+			debug(5, "IMuseDigital::setVolume(%d) - setting", cmd.soundId);
+			track->vol = cmd.param1 * 1000;
+			break;
+		case kCmdSetPan:
+			debug(5, "IMuseDigital::setPan(%d) - setting", cmd.soundId);
+			track->pan = cmd.param1;
+			break;
+		case kCmdSetHookId:
+			track->curHookId = cmd.param1;
+			break;
+		case kCmdSetFade:
+			debug(5, "IMuseDigital::setFade(%d) - setting", cmd.soundId);
+			track->volFadeDelay = cmd.param2;
+			track->volFadeDest = cmd.param1 * 1000;
+			track->volFadeStep = (track->volFadeDest - track->vol) * 60 * (1000 / _callbackFps) / (1000 * cmd.param2);
 			track->volFadeUsed = true;
+			break;
+		case kCmdSelectVolumeGroup:
+			debug(5, "IMuseDigital::setVolumeGroup(%d) - setting", cmd.soundId);
+			track->volGroupId = cmd.param1;
+			break;
+		default:
+			break;
 		}
 	}
 }
 
 void IMuseDigital::fadeOutMusicAndStartNew(int fadeDelay, const char *filename, int soundId) {
 	Common::StackLock lock(_mutex, "IMuseDigital::fadeOutMusicAndStartNew()");
+	processCommandQueue();
 	debug(5, "IMuseDigital::fadeOutMusicAndStartNew(fade:%d, file:%s, sound:%d)", fadeDelay, filename, soundId);
 
 	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
@@ -291,6 +303,7 @@ void IMuseDigital::fadeOutMusicAndStartNew(int fadeDelay, const char *filename,
 
 void IMuseDigital::fadeOutMusic(int fadeDelay) {
 	Common::StackLock lock(_mutex, "IMuseDigital::fadeOutMusic()");
+	processCommandQueue();
 	debug(5, "IMuseDigital::fadeOutMusic(fade:%d)", fadeDelay);
 
 	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
@@ -306,6 +319,7 @@ void IMuseDigital::fadeOutMusic(int fadeDelay) {
 
 void IMuseDigital::setHookIdForMusic(int hookId) {
 	Common::StackLock lock(_mutex, "IMuseDigital::setHookIdForMusic()");
+	processCommandQueue();
 	debug(5, "IMuseDigital::setHookIdForMusic(hookId:%d)", hookId);
 
 	for (int l = 0; l < MAX_DIGITAL_TRACKS; l++) {
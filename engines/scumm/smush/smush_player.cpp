@@ -24,6 +24,7 @@
 
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/memstream.h"
 #include "common/system.h"
 #include "common/util.h"
 
@@ -246,6 +247,11 @@ SmushPlayer::SmushPlayer(ScummEngine_v7 *scumm) {
 	_paused = false;
 	_pauseStartTime = 0;
 	_pauseTime = 0;
+	_prefetchBuffer = NULL;
+	_prefetchSize = 0;
+	_prefetchOffset = -1;
+	_lateFrames = 0;
+	_droppedFrames = 0;
 }
 
 SmushPlayer::~SmushPlayer() {
@@ -292,6 +298,8 @@ void SmushPlayer::release() {
 	delete _strings;
 	_strings = NULL;
 
+	discardPrefetchedFrame();
+
 	delete _base;
 	_base = NULL;
 
@@ -785,16 +793,29 @@ void SmushPlayer::handleZlibFrameObject(int32 subSize, Common::SeekableReadStrea
 		return;
 	}
 
-	int32 chunkSize = subSize;
-	byte *chunkBuffer = (byte *)malloc(chunkSize);
-	assert(chunkBuffer);
-	b.read(chunkBuffer, chunkSize);
+	byte *fobjBuffer = NULL;
+
+	// The object may already have been inflated by prefetchNextFrame()
+	for (uint i = 0; i < _inflatedObjects.size(); i++) {
+		if (_inflatedObjects[i].offset == b.pos()) {
+			fobjBuffer = _inflatedObjects[i].data;
+			_inflatedObjects[i].data = NULL;
+			break;
+		}
+	}
 
-	unsigned long decompressedSize = READ_BE_UINT32(chunkBuffer);
-	byte *fobjBuffer = (byte *)malloc(decompressedSize);
-	if (!Common::uncompress(fobjBuffer, &decompressedSize, chunkBuffer + 4, chunkSize - 4))
-		error("SmushPlayer::handleZlibFrameObject() Zlib uncompress error");
-	free(chunkBuffer);
+	if (!fobjBuffer) {
+		int32 chunkSize = subSize;
+		byte *chunkBuffer = (byte *)malloc(chunkSize);
+		assert(chunkBuffer);
+		b.read(chunkBuffer, chunkSize);
+
+		unsigned long decompressedSize = READ_BE_UINT32(chunkBuffer);
+		fobjBuffer = (byte *)malloc(decompressedSize);
+		if (!Common::uncompress(fobjBuffer, &decompressedSize, chunkBuffer + 4, chunkSize - 4))
+			error("SmushPlayer::handleZlibFrameObject() Zlib uncompress error");
+		free(chunkBuffer);
+	}
 
 	byte *ptr = fobjBuffer;
 	int codec = READ_LE_UINT16(ptr); ptr += 2;
@@ -974,6 +995,8 @@ SmushFont *SmushPlayer::getFont(int font) {
 void SmushPlayer::parseNextFrame() {
 
 	if (_seekPos >= 0) {
+		discardPrefetchedFrame();
+
 		if (_smixer)
 			_smixer->stop();
 
@@ -1019,6 +1042,21 @@ void SmushPlayer::parseNextFrame() {
 
 	assert(_base);
 
+	if (_prefetchOffset != -1) {
+		// The frame has already been read by prefetchNextFrame()
+		debug(3, "Chunk: FRME at %x (prefetched)", _prefetchOffset + 8);
+
+		Common::MemoryReadStream frame(_prefetchBuffer, _prefetchSize);
+		handleFrame(_prefetchSize, frame);
+		discardPrefetchedFrame();
+
+		if (_insanity)
+			_vm->_sound->processSound();
+
+		_vm->_imuseDigital->flushTracks();
+		return;
+	}
+
 	const uint32 subType = _base->readUint32BE();
 	const int32 subSize = _base->readUint32BE();
 	const int32 subOffset = _base->pos();
@@ -1050,6 +1088,74 @@ void SmushPlayer::parseNextFrame() {
 	_vm->_imuseDigital->flushTracks();
 }
 
+void SmushPlayer::prefetchNextFrame() {
+	if (!_base || _prefetchOffset != -1 || _seekPos >= 0 || _endOfFile)
+		return;
+
+	const int32 offset = _base->pos();
+	const uint32 subType = _base->readUint32BE();
+	const int32 subSize = _base->readUint32BE();
+
+	// Leave the end of the file and anything but plain frames to
+	// parseNextFrame()
+	if (_base->pos() >= (int32)_baseSize || subType != MKTAG('F','R','M','E') || subSize <= 0) {
+		_base->seek(offset, SEEK_SET);
+		return;
+	}
+
+	_prefetchBuffer = (byte *)malloc(subSize);
+	assert(_prefetchBuffer);
+	if (_base->read(_prefetchBuffer, subSize) != (uint32)subSize) {
+		free(_prefetchBuffer);
+		_prefetchBuffer = NULL;
+		_base->seek(offset, SEEK_SET);
+		return;
+	}
+
+	_prefetchSize = subSize;
+	_prefetchOffset = offset;
+
+#ifdef USE_ZLIB
+	// Inflate the compressed frame objects too, leaving only the decoding
+	// of the frame for when it is due
+	int32 pos = 0;
+	while (pos + 8 <= _prefetchSize) {
+		const uint32 objType = READ_BE_UINT32(_prefetchBuffer + pos);
+		const int32 objSize = READ_BE_UINT32(_prefetchBuffer + pos + 4);
+		pos += 8;
+		if (objSize < 0 || pos + objSize > _prefetchSize)
+			break;
+
+		if (objType == MKTAG('Z','F','O','B') && objSize > 4) {
+			InflatedObject obj;
+			obj.offset = pos;
+			obj.size = READ_BE_UINT32(_prefetchBuffer + pos);
+			obj.data = (byte *)malloc(obj.size);
+			unsigned long decompressedSize = obj.size;
+			if (obj.data && Common::uncompress(obj.data, &decompressedSize, _prefetchBuffer + pos + 4, objSize - 4)) {
+				_inflatedObjects.push_back(obj);
+			} else {
+				// Let handleZlibFrameObject() report the error
+				free(obj.data);
+			}
+		}
+
+		pos += objSize + (objSize & 1);
+	}
+#endif
+}
+
+void SmushPlayer::discardPrefetchedFrame() {
+	for (uint i = 0; i < _inflatedObjects.size(); i++)
+		free(_inflatedObjects[i].data);
+	_inflatedObjects.clear();
+
+	free(_prefetchBuffer);
+	_prefetchBuffer = NULL;
+	_prefetchSize = 0;
+	_prefetchOffset = -1;
+}
+
 void SmushPlayer::setPalette(const byte *palette) {
 	memcpy(_pal, palette, 0x300);
 	setDirtyColors(0, 255);
@@ -1178,6 +1284,9 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 
 	_pauseTime = 0;
 
+	_lateFrames = 0;
+	_droppedFrames = 0;
+
 	int skipped = 0;
 
 	for (;;) {
@@ -1204,11 +1313,18 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 		}
 
 		if (elapsed >= ((_frame - _startFrame) * 1000) / _speed) {
-			if (elapsed >= ((_frame + 1) * 1000) / _speed)
+			if (elapsed >= ((_frame + 1) * 1000) / _speed) {
 				skipFrame = true;
-			else
+				_lateFrames++;
+			} else
 				skipFrame = false;
+			// The previous frame was never shown
+			if (_updateNeeded)
+				_droppedFrames++;
 			timerCallback();
+		} else {
+			// Use the time until the next frame is due to read ahead
+			prefetchNextFrame();
 		}
 
 		_vm->scummLoop_handleSound();
@@ -1254,9 +1370,17 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 			_IACTpos = 0;
 			break;
 		}
-		_vm->_system->delayMillis(10);
+
+		// Don't oversleep the next frame
+		const uint32 nextFrameTime = ((_frame - _startFrame) * 1000) / _speed;
+		if (nextFrameTime > elapsed)
+			_vm->_system->delayMillis(MIN<uint32>(10, nextFrameTime - elapsed));
+		else
+			_vm->_system->delayMillis(1);
 	}
 
+	debugC(DEBUG_SMUSH, "Smush stats: %d frames, %d late, %d dropped", _frame - _startFrame, _lateFrames, _droppedFrames);
+
 	release();
 
 	// Reset mouse state
@@ -23,6 +23,7 @@
 #if !defined(SCUMM_SMUSH_PLAYER_H) && defined(ENABLE_SCUMM_7_8)
 #define SCUMM_SMUSH_PLAYER_H
 
+#include "common/array.h"
 #include "common/util.h"
 #include "scumm/sound.h"
 
@@ -82,6 +83,21 @@ private:
 	bool _middleAudio;
 	bool _skipPalette;
 
+	// The next FRME chunk, read (and inflated) ahead while waiting for
+	// the current frame to be shown
+	struct InflatedObject {
+		int32 offset;
+		byte *data;
+		uint32 size;
+	};
+	byte *_prefetchBuffer;
+	int32 _prefetchSize;
+	int32 _prefetchOffset;
+	Common::Array<InflatedObject> _inflatedObjects;
+
+	uint32 _lateFrames;
+	uint32 _droppedFrames;
+
 public:
 	SmushPlayer(ScummEngine_v7 *scumm);
 	~SmushPlayer();
@@ -111,6 +127,8 @@ protected:
 private:
 	SmushFont *getFont(int font);
 	void parseNextFrame();
+	void prefetchNextFrame();
+	void discardPrefetchedFrame();
 	void init(int32 spped);
 	void setupAnim(const char *file);
 	void updateScreen();
@@ -274,7 +274,8 @@ void Animation::frameNotification(int timeElapsed) {
 			}
 		}
 
-		if ((int)_currentFrame != tmpCurFrame) {
+		const bool frameChanged = ((int)_currentFrame != tmpCurFrame);
+		if (frameChanged) {
 			forceRefresh();
 
 			if (animationDescriptionPtr->getFrame(_currentFrame).action != "") {
@@ -285,6 +286,9 @@ void Animation::frameNotification(int timeElapsed) {
 		}
 
 		_currentFrame = static_cast<uint>(tmpCurFrame);
+
+		if (frameChanged)
+			prefetchNextFrame();
 	}
 
 	// Gre und Position der Animation anhand des aktuellen Frames bestimmen
@@ -294,6 +298,32 @@ void Animation::frameNotification(int timeElapsed) {
 	assert(_currentFrameTime >= 0);
 }
 
+void Animation::prefetchNextFrame() {
+	AnimationDescription *animationDescriptionPtr = getAnimationDescription();
+	const int frameCount = animationDescriptionPtr->getFrameCount();
+	if (frameCount < 2)
+		return;
+
+	int nextFrame = (_direction == FORWARD) ? (int)_currentFrame + 1 : (int)_currentFrame - 1;
+	if (nextFrame < 0 || nextFrame >= frameCount) {
+		switch (animationDescriptionPtr->getAnimationType()) {
+		case AT_LOOP:
+			nextFrame = (nextFrame + frameCount) % frameCount;
+			break;
+		case AT_JOJO:
+			nextFrame = 2 * (int)_currentFrame - nextFrame;
+			break;
+		default:
+			return;
+		}
+	}
+
+	// The frames are normally locked while the animation plays, but they are
+	// unlocked forcibly when the resource cache overflows on room changes.
+	// Reload them in the idle time of a frame instead of when they are drawn.
+	Kernel::getInstance()->getResourceManager()->prefetchResource(animationDescriptionPtr->getFrame(nextFrame).fileName, 1);
+}
+
 void Animation::computeCurrentCharacteristics() {
 	AnimationDescription *animationDescriptionPtr = getAnimationDescription();
 	assert(animationDescriptionPtr);
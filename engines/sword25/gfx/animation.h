@@ -196,6 +196,11 @@ private:
 	*/
 	void computeCurrentCharacteristics();
 
+	/**
+	 * Queues the frame which is shown after the current one for prefetching.
+	 */
+	void prefetchNextFrame();
+
 	/**
 	    @brief Berechnet den Abstand zwischen dem linken Rand und dem Hotspot auf X-Achse in der aktuellen Darstellung.
 	*/
@@ -61,6 +61,7 @@ enum {
 namespace Sword25 {
 
 static const uint FRAMETIME_SAMPLE_COUNT = 5;       // Anzahl der Framezeiten ber die, die Framezeit gemittelt wird
+static const uint PREFETCH_TIME_PER_FRAME = 5;       // Time in milliseconds spent on loading prefetched resources per frame
 
 GraphicEngine::GraphicEngine(Kernel *pKernel) :
 	_width(0),
@@ -148,6 +149,10 @@ bool GraphicEngine::endFrame() {
 
 	g_system->updateScreen();
 
+	// Use some of the remaining frame time to load resources the scripts
+	// are going to need soon
+	Kernel::getInstance()->getResourceManager()->processPrefetchQueue(PREFETCH_TIME_PER_FRAME);
+
 	return true;
 }
 
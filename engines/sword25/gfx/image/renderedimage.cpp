@@ -233,7 +233,29 @@ uint RenderedImage::getPixel(int x, int y) {
 // -----------------------------------------------------------------------------
 
 bool RenderedImage::blit(int posX, int posY, int flipping, Common::Rect *pPartRect, uint color, int width, int height, RectangleList *updateRects) {
-	_surface.blit(*_backSurface, posX, posY, (((flipping & 1) ? Graphics::FLIP_V : 0) | ((flipping & 2) ? Graphics::FLIP_H : 0)), pPartRect, color, width, height);
+	const int flip = ((flipping & 1) ? Graphics::FLIP_V : 0) | ((flipping & 2) ? Graphics::FLIP_H : 0);
+
+	// Only draw the parts of the image which are going to be updated on the
+	// screen. The update rectangles never overlap, so this gives the same
+	// result as drawing everything. Scaled images and image sections are
+	// always drawn completely.
+	if (updateRects && !pPartRect && (width == -1 || width == _surface.w) && (height == -1 || height == _surface.h)) {
+		const Common::Rect destRect(posX, posY, posX + _surface.w, posY + _surface.h);
+
+		for (RectangleList::iterator it = updateRects->begin(); it != updateRects->end(); ++it) {
+			const Common::Rect &clipRect = *it;
+			if (destRect.intersects(clipRect)) {
+				// The section is given in screen orientation, the blitter takes care of flipping
+				Common::Rect partRect = destRect.findIntersectingRect(clipRect);
+				partRect.translate(-posX, -posY);
+				_surface.blit(*_backSurface, posX + partRect.left, posY + partRect.top, flip, &partRect, color);
+			}
+		}
+
+		return true;
+	}
+
+	_surface.blit(*_backSurface, posX, posY, flip, pPartRect, color, width, height);
 
 	return true;
 }
@@ -36,6 +36,8 @@
 #include "sword25/gfx/image/art.h"
 #include "sword25/gfx/image/vectorimage.h"
 #include "sword25/gfx/image/renderedimage.h"
+#include "sword25/kernel/kernel.h"
+#include "sword25/kernel/resmanager.h"
 
 #include "graphics/colormasks.h"
 
@@ -215,7 +217,7 @@ Common::Rect CalculateBoundingBox(const VectorImageElement &vectorImageElement)
 // Construction
 // -----------------------------------------------------------------------------
 
-VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _pixelData(0), _fname(fname) {
+VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _fname(fname) {
 	success = false;
 
 	// Create bitstream object
@@ -300,8 +302,9 @@ VectorImage::~VectorImage() {
 			if (_elements[j].getPathInfo(i).getVec())
 				free(_elements[j].getPathInfo(i).getVec());
 
-	if (_pixelData)
-		free(_pixelData);
+	ResourceManager *resourceManager = Kernel::getInstance()->getResourceManager();
+	if (resourceManager)
+		resourceManager->flushCachedRasters(this);
 }
 
 
@@ -605,26 +608,22 @@ bool VectorImage::blit(int posX, int posY,
                        uint color,
                        int width, int height,
 					   RectangleList *updateRects) {
-	static VectorImage *oldThis = 0;
-	static int              oldWidth = -2;
-	static int              oldHeight = -2;
-
 	// If width or height to 0, nothing needs to be shown.
 	if (width == 0 || height == 0)
 		return true;
 
-	// Determine if the old image in the cache can not be reused and must be recalculated
-	if (!(oldThis == this && oldWidth == width && oldHeight == height)) {
-		render(width, height);
-
-		oldThis = this;
-		oldHeight = height;
-		oldWidth = width;
+	// Rendering the vectors is expensive, so the result is kept in the
+	// resource manager for every size the image is shown in.
+	ResourceManager *resourceManager = Kernel::getInstance()->getResourceManager();
+	byte *pixelData = resourceManager->getCachedRaster(this, width, height);
+	if (!pixelData) {
+		pixelData = render(width, height);
+		resourceManager->cacheRaster(this, width, height, pixelData);
 	}
 
 	RenderedImage *rend = new RenderedImage();
 
-	rend->replaceContent(_pixelData, width, height);
+	rend->replaceContent(pixelData, width, height);
 	rend->blit(posX, posY, flipping, pPartRect, color, width, height, updateRects);
 
 	delete rend;
@@ -183,7 +183,11 @@ public:
 	}
 	virtual bool fill(const Common::Rect *pFillRect = 0, uint color = BS_RGB(0, 0, 0));
 
-	void render(int width, int height);
+	/**
+	 * Renders the image in the given size.
+	 * @return the malloc()ed ARGB pixel data
+	 */
+	byte *render(int width, int height) const;
 
 	virtual uint getPixel(int x, int y);
 	virtual bool isBlitSource() const {
@@ -225,8 +229,6 @@ private:
 	Common::Array<VectorImageElement>    _elements;
 	Common::Rect                         _boundingBox;
 
-	byte *_pixelData;
-
 	Common::String _fname;
 };
 
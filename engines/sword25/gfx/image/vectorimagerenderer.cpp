@@ -255,6 +255,36 @@ void art_rgb_svp_alpha1(const ArtSVP *svp,
 		art_svp_render_aa(svp, x0, y0, x1, y1, art_rgb_svp_alpha_callback1, &data);
 }
 
+/**
+ * Renders an SVP into a buffer covering the whole image. Only the area
+ * within the bounding box of the SVP is rendered, since the pixels outside
+ * of it would not be touched anyway. This avoids walking all scanlines of
+ * the image for every small shape.
+ */
+static void art_rgb_svp_alpha_clipped(const ArtSVP *svp, uint32 color, byte *buf, int width, int height) {
+	if (svp->n_segs == 0)
+		return;
+
+	ArtDRect bbox = svp->segs[0].bbox;
+	for (int i = 1; i < svp->n_segs; i++) {
+		const ArtDRect &segBox = svp->segs[i].bbox;
+		bbox.x0 = MIN(bbox.x0, segBox.x0);
+		bbox.y0 = MIN(bbox.y0, segBox.y0);
+		bbox.x1 = MAX(bbox.x1, segBox.x1);
+		bbox.y1 = MAX(bbox.y1, segBox.y1);
+	}
+
+	const int x0 = MAX(0, (int)floor(bbox.x0));
+	const int y0 = MAX(0, (int)floor(bbox.y0));
+	const int x1 = MIN(width, (int)ceil(bbox.x1) + 1);
+	const int y1 = MIN(height, (int)ceil(bbox.y1) + 1);
+
+	if (x0 >= x1 || y0 >= y1)
+		return;
+
+	art_rgb_svp_alpha1(svp, x0, y0, x1, y1, color, buf + (y0 * width + x0) * 4, width * 4);
+}
+
 static int art_vpath_len(ArtVpath *a) {
 	int i = 0;
 	while (a[i].code != ART_END)
@@ -394,24 +424,21 @@ void drawBez(ArtBpath *bez1, ArtBpath *bez2, byte *buffer, int width, int height
 		art_svp_make_convex(svp);
 	}
 
-	art_rgb_svp_alpha1(svp, 0, 0, width, height, color, buffer, width * 4);
+	art_rgb_svp_alpha_clipped(svp, color, buffer, width, height);
 
 	free(vect);
 	art_svp_free(svp);
 	free(vec);
 }
 
-void VectorImage::render(int width, int height) {
+byte *VectorImage::render(int width, int height) const {
 	double scaleX = (width == - 1) ? 1 : static_cast<double>(width) / static_cast<double>(getWidth());
 	double scaleY = (height == - 1) ? 1 : static_cast<double>(height) / static_cast<double>(getHeight());
 
 	debug(3, "VectorImage::render(%d, %d) %s", width, height, _fname.c_str());
 
-	if (_pixelData)
-		free(_pixelData);
-
-	_pixelData = (byte *)malloc(width * height * 4);
-	memset(_pixelData, 0, width * height * 4);
+	byte *pixelData = (byte *)malloc(width * height * 4);
+	memset(pixelData, 0, width * height * 4);
 
 	for (uint e = 0; e < _elements.size(); e++) {
 
@@ -452,7 +479,7 @@ void VectorImage::render(int width, int height) {
 			(*fill0pos).code = ART_END;
 			(*fill1pos).code = ART_END;
 
-			drawBez(fill1, fill0, _pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, -1, _elements[e].getFillStyleColor(s));
+			drawBez(fill1, fill0, pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, -1, _elements[e].getFillStyleColor(s));
 
 			free(fill0);
 			free(fill1);
@@ -465,11 +492,13 @@ void VectorImage::render(int width, int height) {
 
 			for (uint p = 0; p < _elements[e].getPathCount(); p++) {
 				if (_elements[e].getPathInfo(p).getLineStyle() == s + 1) {
-					drawBez(_elements[e].getPathInfo(p).getVec(), 0, _pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, penWidth, _elements[e].getLineStyleColor(s));
+					drawBez(_elements[e].getPathInfo(p).getVec(), 0, pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, penWidth, _elements[e].getLineStyleColor(s));
 				}
 			}
 		}
 	}
+
+	return pixelData;
 }
 
 
@@ -115,6 +115,14 @@ bool RenderObjectManager::render() {
 	}
 
 	RectangleList *updateRects = _uta->getRectangles();
+
+	// Nothing changed, so the screen does not need to be touched at all
+	if (updateRects->empty()) {
+		delete updateRects;
+		SWAP(_currQueue, _prevQueue);
+		return true;
+	}
+
 	Common::Array<int> updateRectsMinZ;
 
 	updateRectsMinZ.reserve(updateRects->size());
@@ -333,6 +333,31 @@ static int forcePrecacheResource(lua_State *L) {
 	return 1;
 }
 
+static int prefetchResource(lua_State *L) {
+	Kernel *pKernel = Kernel::getInstance();
+	assert(pKernel);
+	ResourceManager *pResource = pKernel->getResourceManager();
+	assert(pResource);
+
+	pResource->prefetchResource(luaL_checkstring(L, 1), luaL_optint(L, 2, 0));
+
+	return 0;
+}
+
+static int cancelPrefetch(lua_State *L) {
+	Kernel *pKernel = Kernel::getInstance();
+	assert(pKernel);
+	ResourceManager *pResource = pKernel->getResourceManager();
+	assert(pResource);
+
+	if (lua_gettop(L) == 0)
+		pResource->cancelAllPrefetches();
+	else
+		pResource->cancelPrefetch(luaL_checkstring(L, 1));
+
+	return 0;
+}
+
 static int getMaxMemoryUsage(lua_State *L) {
 	Kernel *pKernel = Kernel::getInstance();
 	assert(pKernel);
@@ -385,6 +410,8 @@ static const char *RESOURCE_LIBRARY_NAME = "Resource";
 static const luaL_reg RESOURCE_FUNCTIONS[] = {
 	{"PrecacheResource", precacheResource},
 	{"ForcePrecacheResource", forcePrecacheResource},
+	{"PrefetchResource", prefetchResource},
+	{"CancelPrefetch", cancelPrefetch},
 	{"GetMaxMemoryUsage", getMaxMemoryUsage},
 	{"SetMaxMemoryUsage", setMaxMemoryUsage},
 	{"EmptyCache", emptyCache},
@@ -29,6 +29,8 @@
  *
  */
 
+#include "common/system.h"
+
 #include "sword25/sword25.h"	// for kDebugResource
 #include "sword25/kernel/resmanager.h"
 #include "sword25/kernel/resource.h"
@@ -46,8 +48,19 @@ namespace Sword25 {
 // are loaded, the resource manager will start purging resources till it
 // hits the minimum limit above
 #define SWORD25_RESOURCECACHE_MAX 500
+// The maximum amount of memory used by pre-rendered vector images. Many
+// scenes show dozens of them at several sizes, so this should be large
+// enough to hold all renderings of a scene.
+#define SWORD25_RASTERCACHE_MAX (16 * 1024 * 1024)
 
 ResourceManager::~ResourceManager() {
+	// Free the pre-rendered vector images. The images remove their own
+	// entries when deleted below, which is fine with an empty cache.
+	for (Common::List<CachedRaster>::iterator iter = _rasterCache.begin(); iter != _rasterCache.end(); ++iter)
+		free(iter->data);
+	_rasterCache.clear();
+	_rasterCacheSize = 0;
+
 	// Clear all unlocked resources
 	emptyCache();
 
@@ -133,6 +146,9 @@ void ResourceManager::deleteResourcesIfNecessary() {
  * Releases all resources that are not locked.
  */
 void ResourceManager::emptyCache() {
+	// Requests queued before are not wanted anymore either
+	cancelAllPrefetches();
+
 	// Scan through the resource list
 	Common::List<Resource *>::iterator iter = _resources.begin();
 	while (iter != _resources.end()) {
@@ -144,6 +160,55 @@ void ResourceManager::emptyCache() {
 	}
 }
 
+byte *ResourceManager::getCachedRaster(const void *owner, int width, int height) {
+	Common::List<CachedRaster>::iterator iter = _rasterCache.begin();
+	for (; iter != _rasterCache.end(); ++iter) {
+		if (iter->owner == owner && iter->width == width && iter->height == height) {
+			// Move the rendering to the front of the list
+			if (iter != _rasterCache.begin()) {
+				CachedRaster raster = *iter;
+				_rasterCache.erase(iter);
+				_rasterCache.push_front(raster);
+			}
+			return _rasterCache.front().data;
+		}
+	}
+
+	return 0;
+}
+
+void ResourceManager::cacheRaster(const void *owner, int width, int height, byte *data) {
+	CachedRaster raster;
+	raster.owner = owner;
+	raster.width = width;
+	raster.height = height;
+	raster.data = data;
+
+	// Free the renderings which have not been used for the longest time,
+	// but always keep the new one, since the caller is going to use it.
+	const uint size = getRasterSize(raster);
+	while (!_rasterCache.empty() && _rasterCacheSize + size > SWORD25_RASTERCACHE_MAX) {
+		_rasterCacheSize -= getRasterSize(_rasterCache.back());
+		free(_rasterCache.back().data);
+		_rasterCache.pop_back();
+	}
+
+	_rasterCache.push_front(raster);
+	_rasterCacheSize += size;
+}
+
+void ResourceManager::flushCachedRasters(const void *owner) {
+	Common::List<CachedRaster>::iterator iter = _rasterCache.begin();
+	while (iter != _rasterCache.end()) {
+		if (iter->owner == owner) {
+			_rasterCacheSize -= getRasterSize(*iter);
+			free(iter->data);
+			iter = _rasterCache.erase(iter);
+		} else
+			++iter;
+	}
+}
+
 void ResourceManager::emptyThumbnailCache() {
 	// Scan through the resource list
 	Common::List<Resource *>::iterator iter = _resources.begin();
@@ -183,6 +248,79 @@ Resource *ResourceManager::requestResource(const Common::String &fileName) {
 	return NULL;
 }
 
+void ResourceManager::prefetchResource(const Common::String &fileName, int priority) {
+	Common::String uniqueFileName = getUniqueFileName(fileName);
+	if (uniqueFileName.empty() || getResource(uniqueFileName))
+		return;
+
+	// A resource which is already queued only changes its priority
+	cancelPrefetch(fileName);
+
+	PrefetchRequest request;
+	request.fileName = uniqueFileName;
+	request.priority = priority;
+
+	// Keep the queue sorted, requests with the same priority are processed in order
+	Common::List<PrefetchRequest>::iterator iter = _prefetchQueue.begin();
+	while (iter != _prefetchQueue.end() && iter->priority >= priority)
+		++iter;
+	_prefetchQueue.insert(iter, request);
+}
+
+void ResourceManager::cancelPrefetch(const Common::String &fileName) {
+	Common::String uniqueFileName = getUniqueFileName(fileName);
+
+	Common::List<PrefetchRequest>::iterator iter = _prefetchQueue.begin();
+	while (iter != _prefetchQueue.end()) {
+		if (iter->fileName == uniqueFileName)
+			iter = _prefetchQueue.erase(iter);
+		else
+			++iter;
+	}
+}
+
+void ResourceManager::cancelAllPrefetches() {
+	_prefetchQueue.clear();
+}
+
+void ResourceManager::processPrefetchQueue(uint maxTime) {
+	const uint32 startTime = g_system->getMillis();
+	bool loaded = false;
+
+	while (!_prefetchQueue.empty()) {
+		// A resource can not be loaded partially, so only start loading one
+		// if it is expected to be done before the time is up
+		if (g_system->getMillis() - startTime + _prefetchLoadTime > maxTime) {
+			// Let the estimate decay slowly when not even one resource fits,
+			// so a single slow load does not block prefetching for good
+			if (!loaded && _prefetchLoadTime > 0)
+				_prefetchLoadTime--;
+			break;
+		}
+
+		// Loading another resource would release the least recently used
+		// ones, which are likely still needed more than prefetched ones.
+		if (_resources.size() + 1 >= SWORD25_RESOURCECACHE_MAX) {
+			debugC(kDebugResource, "Resource cache is full, dropping %u prefetch requests", _prefetchQueue.size());
+			_prefetchQueue.clear();
+			return;
+		}
+
+		const Common::String fileName = _prefetchQueue.front().fileName;
+		_prefetchQueue.pop_front();
+
+		// The resource may have been requested in the meantime
+		if (getResource(fileName))
+			continue;
+
+		const uint32 loadStartTime = g_system->getMillis();
+		if (!loadResource(fileName))
+			debugC(kDebugResource, "Could not prefetch \"%s\".", fileName.c_str());
+		_prefetchLoadTime = (_prefetchLoadTime + g_system->getMillis() - loadStartTime + 1) / 2;
+		loaded = true;
+	}
+}
+
 #ifdef PRECACHE_RESOURCES
 
 /**
@@ -66,6 +66,33 @@ public:
 	bool precacheResource(const Common::String &fileName, bool forceReload = false);
 #endif
 
+	/**
+	 * Queues a resource to be loaded into the cache while the game is idle,
+	 * so it is available without delay when it is requested later on
+	 * @param FileName      The filename of the resource
+	 * @param Priority      Resources with a higher priority are loaded first
+	 */
+	void prefetchResource(const Common::String &fileName, int priority = 0);
+
+	/**
+	 * Removes a resource from the prefetch queue
+	 * @param FileName      The filename of the resource
+	 */
+	void cancelPrefetch(const Common::String &fileName);
+
+	/**
+	 * Removes all resources from the prefetch queue
+	 */
+	void cancelAllPrefetches();
+
+	/**
+	 * Loads queued resources while they are expected to fit into the given
+	 * time. Prefetching stops before the cache would have to release other
+	 * resources.
+	 * @param MaxTime       The time available in milliseconds
+	 */
+	void processPrefetchQueue(uint maxTime);
+
 	/**
 	 * Registers a RegisterResourceService. This method is the constructor of
 	 * BS_ResourceService, and thus helps all resource services in the ResourceManager list
@@ -88,13 +115,37 @@ public:
 	 */
 	void dumpLockedResources();
 
+	/**
+	 * Returns a cached rendering of a vector image, or NULL if there is none
+	 * in the requested size. The data remains valid until the next call to
+	 * cacheRaster() or flushCachedRasters().
+	 * @param owner         The image the rendering belongs to
+	 * @param width         The width of the rendering
+	 * @param height        The height of the rendering
+	 */
+	byte *getCachedRaster(const void *owner, int width, int height);
+
+	/**
+	 * Adds a rendering of a vector image to the raster cache, which takes
+	 * ownership of the malloc()ed data. If the cache exceeds its memory limit,
+	 * the least recently used renderings of all images are freed.
+	 */
+	void cacheRaster(const void *owner, int width, int height, byte *data);
+
+	/**
+	 * Frees all cached renderings of a vector image
+	 */
+	void flushCachedRasters(const void *owner);
+
 private:
 	/**
 	 * Creates a new resource manager
 	 * Only the BS_Kernel class can generate copies this class. Thus, the constructor is private
 	 */
 	ResourceManager(Kernel *pKernel) :
-		_kernelPtr(pKernel)
+		_kernelPtr(pKernel),
+		_prefetchLoadTime(0),
+		_rasterCacheSize(0)
 	{}
 	virtual ~ResourceManager();
 
@@ -139,6 +190,31 @@ private:
 	Common::List<Resource *> _resources;
 	typedef Common::HashMap<Common::String, Resource *> ResMap;
 	ResMap _resourceHashMap;
+
+	struct PrefetchRequest {
+		Common::String fileName;
+		int priority;
+	};
+
+	/** The resources to prefetch, sorted by descending priority */
+	Common::List<PrefetchRequest> _prefetchQueue;
+	/** Running average of the time needed to prefetch a resource in milliseconds */
+	uint32 _prefetchLoadTime;
+
+	struct CachedRaster {
+		const void *owner;
+		int width;
+		int height;
+		byte *data;
+	};
+
+	/** The cached renderings, the most recently used one first */
+	Common::List<CachedRaster> _rasterCache;
+	uint _rasterCacheSize;
+
+	static uint getRasterSize(const CachedRaster &raster) {
+		return raster.width * raster.height * 4;
+	}
 };
 
 } // End of namespace Sword25
@@ -33,6 +33,8 @@
 #include "graphics/fontman.h"
 #include "graphics/palette.h"
 #include "graphics/surface.h"
+#include "graphics/transparent_surface.h"
+#include "graphics/yuv_to_rgb.h"
 #include "graphics/VectorRendererSpec.h"
 
 namespace Testbed {
@@ -74,6 +76,8 @@ GFXTestSuite::GFXTestSuite() {
 	// Specific Tests:
 	addTest("PaletteRotation", &GFXtests::paletteRotation);
 	addTest("cursorTrailsInGUI", &GFXtests::cursorTrails);
+	addTest("TransparentSurfaceBlitting", &GFXtests::transparentSurfaceBlitting);
+	addTest("YUVToRGBConversion", &GFXtests::yuvToRGBConversion);
 	//addTest("Pixel Formats", &GFXtests::pixelFormats);
 }
 
@@ -1158,4 +1162,136 @@ TestExitStatus GFXtests::pixelFormats() {
 	return kTestPassed;
 }
 
+/**
+ * Measures the throughput of the Graphics::TransparentSurface blending
+ * routines. This doesn't touch the screen, the numbers are only logged.
+ */
+TestExitStatus GFXtests::transparentSurfaceBlitting() {
+	const int width = 320;
+	const int height = 200;
+	const int iterations = 100;
+
+	static const struct {
+		const char *name;
+		Graphics::TSpriteBlendMode blendMode;
+		Graphics::AlphaType alphaType;
+		uint32 color;
+	} modes[] = {
+		{ "opaque",                   Graphics::BLEND_NORMAL,      Graphics::ALPHA_OPAQUE, 0xFFFFFFFF },
+		{ "binary alpha",             Graphics::BLEND_NORMAL,      Graphics::ALPHA_BINARY, 0xFFFFFFFF },
+		{ "alpha",                    Graphics::BLEND_NORMAL,      Graphics::ALPHA_FULL,   0xFFFFFFFF },
+		{ "alpha, color mod",         Graphics::BLEND_NORMAL,      Graphics::ALPHA_FULL,   0x80FF8040 },
+		{ "additive",                 Graphics::BLEND_ADDITIVE,    Graphics::ALPHA_FULL,   0xFFFFFFFF },
+		{ "additive, color mod",      Graphics::BLEND_ADDITIVE,    Graphics::ALPHA_FULL,   0x80FF8040 },
+		{ "subtractive",              Graphics::BLEND_SUBTRACTIVE, Graphics::ALPHA_FULL,   0xFFFFFFFF },
+		{ "subtractive, color mod",   Graphics::BLEND_SUBTRACTIVE, Graphics::ALPHA_FULL,   0x80FF8040 }
+	};
+
+	const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+	Graphics::TransparentSurface src;
+	Graphics::Surface dst;
+	src.create(width, height, format);
+	dst.create(width, height, format);
+
+	Common::RandomSource rnd("testbedTransparentSurface");
+	byte *pixels = (byte *)src.getPixels();
+	for (int i = 0; i < src.pitch * src.h; i++)
+		pixels[i] = rnd.getRandomNumber(255);
+
+	Testsuite::logPrintf("Info! Blitting a %dx%d sprite %d times per blending mode\n", width, height, iterations);
+
+	for (int m = 0; m < ARRAYSIZE(modes); m++) {
+		src.setAlphaMode(modes[m].alphaType);
+		dst.fillRect(Common::Rect(width, height), 0x80808080);
+
+		uint32 start = g_system->getMillis();
+		for (int i = 0; i < iterations; i++)
+			src.blit(dst, 0, 0, (i & 1) ? Graphics::FLIP_H : Graphics::FLIP_NONE, 0, modes[m].color, -1, -1, modes[m].blendMode);
+		uint32 elapsed = g_system->getMillis() - start;
+
+		Testsuite::logPrintf("Info! %s: %u ms, %u pixels/ms\n", modes[m].name, elapsed,
+			(uint)((uint64)width * height * iterations / MAX<uint32>(elapsed, 1)));
+	}
+
+	src.free();
+	dst.free();
+
+	return kTestPassed;
+}
+
+/**
+ * Measures the throughput of the YUV to RGB conversion used by the video
+ * decoders. Like the blitting test, this only logs the numbers.
+ */
+TestExitStatus GFXtests::yuvToRGBConversion() {
+	const int iterations = 20;
+
+	static const struct {
+		int width, height;
+	} sizes[] = {
+		{ 640, 480 },
+		{ 1280, 720 }
+	};
+
+	static const struct {
+		const char *name;
+		Graphics::PixelFormat format;
+	} formats[] = {
+		{ "RGB565",   Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) },
+		{ "XRGB8888", Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0) },
+		{ "ABGR8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24) }
+	};
+
+	Common::RandomSource rnd("testbedYUVToRGB");
+
+	for (int s = 0; s < ARRAYSIZE(sizes); s++) {
+		const int width = sizes[s].width;
+		const int height = sizes[s].height;
+
+		// Large enough for 4:4:4, the 4:1:0 conversion needs an extra
+		// row and column of chroma samples
+		byte *ySrc = new byte[width * height];
+		byte *uSrc = new byte[(width + 1) * (height + 1)];
+		byte *vSrc = new byte[(width + 1) * (height + 1)];
+
+		for (int i = 0; i < width * height; i++)
+			ySrc[i] = rnd.getRandomNumber(255);
+		for (int i = 0; i < (width + 1) * (height + 1); i++) {
+			uSrc[i] = rnd.getRandomNumber(255);
+			vSrc[i] = rnd.getRandomNumber(255);
+		}
+
+		for (int f = 0; f < ARRAYSIZE(formats); f++) {
+			Graphics::Surface dst;
+			dst.create(width, height, formats[f].format);
+
+			uint32 start = g_system->getMillis();
+			for (int i = 0; i < iterations; i++)
+				YUVToRGBMan.convert444(&dst, Graphics::YUVToRGBManager::kScaleITU, ySrc, uSrc, vSrc, width, height, width, width);
+			uint32 time444 = g_system->getMillis() - start;
+
+			start = g_system->getMillis();
+			for (int i = 0; i < iterations; i++)
+				YUVToRGBMan.convert420(&dst, Graphics::YUVToRGBManager::kScaleITU, ySrc, uSrc, vSrc, width, height, width, width / 2);
+			uint32 time420 = g_system->getMillis() - start;
+
+			start = g_system->getMillis();
+			for (int i = 0; i < iterations; i++)
+				YUVToRGBMan.convert410(&dst, Graphics::YUVToRGBManager::kScaleFull, ySrc, uSrc, vSrc, width, height, width, width / 4 + 1);
+			uint32 time410 = g_system->getMillis() - start;
+
+			Testsuite::logPrintf("Info! %dx%d %s, %d frames: 4:4:4 %u ms, 4:2:0 %u ms, 4:1:0 %u ms\n",
+				width, height, formats[f].name, iterations, time444, time420, time410);
+
+			dst.free();
+		}
+
+		delete[] ySrc;
+		delete[] uSrc;
+		delete[] vSrc;
+	}
+
+	return kTestPassed;
+}
+
 } // End of namespace Testbed
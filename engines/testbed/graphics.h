@@ -51,6 +51,8 @@ TestExitStatus focusRectangle();
 TestExitStatus overlayGraphics();
 TestExitStatus paletteRotation();
 TestExitStatus pixelFormats();
+TestExitStatus transparentSurfaceBlitting();
+TestExitStatus yuvToRGBConversion();
 // add more here
 
 } // End of namespace GFXtests
@@ -20,7 +20,10 @@
  *
  */
 
+#include "audio/fmopl.h"
 #include "audio/softsynth/pcspk.h"
+#include "audio/decoders/raw.h"
+#include "audio/mixer_intern.h"
 
 #include "backends/audiocd/audiocd.h"
 
@@ -261,6 +264,253 @@ TestExitStatus SoundSubsystem::sampleRates() {
 	return passed;
 }
 
+TestExitStatus SoundSubsystem::mixerStress() {
+	// Hammers the mixer from the engine thread the way busy engines do (many
+	// short sounds, constant volume changes and status polling) and reports
+	// how regularly the mix callback was invoked meanwhile.
+	const uint32 kTestDuration = 5000;
+	const uint32 kSoundLength = 4410;
+
+	// All backends use the default mixer implementation
+	Audio::Mixer *mixer = g_system->getMixer();
+	Audio::MixerImpl *mixerImpl = (Audio::MixerImpl *)mixer;
+	if (!mixer->isReady()) {
+		Testsuite::logPrintf("Info! Skipping test : Mixer Stress, the mixer is not running\n");
+		return kTestSkipped;
+	}
+
+	Testsuite::writeOnScreen("Stressing the mixer for 5 seconds...", Common::Point(0, 100));
+
+	Audio::SoundHandle handles[12];
+	uint32 apiCalls = 0, maxBurstTime = 0;
+	mixerImpl->resetCallbackStats();
+
+	const uint32 start = g_system->getMillis();
+	for (uint32 iteration = 0; g_system->getMillis() - start < kTestDuration; ++iteration) {
+		const uint32 burstStart = g_system->getMillis();
+
+		// Restart one channel with a short, quiet square wave
+		const uint slot = iteration % ARRAYSIZE(handles);
+		mixer->stopHandle(handles[slot]);
+		int16 *buffer = (int16 *)malloc(kSoundLength * sizeof(int16));
+		for (uint32 i = 0; i < kSoundLength; ++i)
+			buffer[i] = ((i / (20 + slot)) & 1) ? 512 : -512;
+		Audio::AudioStream *stream = Audio::makeRawStream((byte *)buffer, kSoundLength * sizeof(int16), 22050,
+		                                                  Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN);
+		mixer->playStream(Audio::Mixer::kSFXSoundType, &handles[slot], stream, slot);
+		apiCalls += 2;
+
+		for (uint i = 0; i < ARRAYSIZE(handles); ++i) {
+			mixer->setChannelVolume(handles[i], (iteration * 7 + i * 13) & 0xFF);
+			mixer->setChannelBalance(handles[i], ((iteration + i) % 64) - 32);
+			mixer->isSoundHandleActive(handles[i]);
+			mixer->getSoundElapsedTime(handles[i]);
+			mixer->isSoundIDActive(i);
+			apiCalls += 5;
+		}
+
+		maxBurstTime = MAX(maxBurstTime, g_system->getMillis() - burstStart);
+		g_system->delayMillis(1);
+	}
+
+	for (uint i = 0; i < ARRAYSIZE(handles); ++i)
+		mixer->stopHandle(handles[i]);
+
+	const Audio::MixerImpl::CallbackStats stats = mixerImpl->getCallbackStats();
+	Testsuite::clearScreen();
+
+	Testsuite::logPrintf("Info! Mixer stress test, %s mode\n", mixerImpl->usesCommandQueue() ? "command queue" : "mutex");
+	Testsuite::logPrintf("Info! %u engine calls, longest burst of %u calls: %u ms\n", apiCalls, 2 + 5 * ARRAYSIZE(handles), maxBurstTime);
+	Testsuite::logPrintf("Info! %u callbacks of %u ms audio, interval %u-%u ms (jitter %u ms), longest callback %u ms\n",
+	                     stats.callbacks, stats.bufferDuration, stats.minInterval, stats.maxInterval,
+	                     stats.maxInterval - stats.minInterval, stats.maxDuration);
+	Testsuite::logPrintf("Info! %u xruns\n", stats.xruns);
+
+	if (stats.callbacks == 0) {
+		Testsuite::logDetailedPrintf("Error! The mixer callback was never invoked\n");
+		return kTestFailed;
+	}
+
+	if (stats.xruns) {
+		Testsuite::logDetailedPrintf("Error! The mixer callback was late or too slow %u times\n", stats.xruns);
+		return kTestFailed;
+	}
+
+	return kTestPassed;
+}
+
+namespace {
+
+// Operator offsets of the nine OPL2 channels
+const byte kOPLChannelOperators[9] = { 0x00, 0x01, 0x02, 0x08, 0x09, 0x0A, 0x10, 0x11, 0x12 };
+
+enum OPLStreamType {
+	kOPLStreamMelodic,
+	kOPLStreamRhythm
+};
+
+void setupOPLStream(OPL::OPL *opl, OPLStreamType type) {
+	opl->writeReg(0x01, 0x20);
+	for (int c = 0; c < 9; ++c) {
+		const int op = kOPLChannelOperators[c];
+		opl->writeReg(0x20 + op, 0x01 + (c & 3));
+		opl->writeReg(0x23 + op, 0x01);
+		opl->writeReg(0x40 + op, 0x10 + c);
+		opl->writeReg(0x43 + op, 0x00);
+		opl->writeReg(0x60 + op, 0xF2);
+		opl->writeReg(0x63 + op, 0xF4);
+		opl->writeReg(0x80 + op, 0x55);
+		opl->writeReg(0x83 + op, 0x36);
+		opl->writeReg(0xE0 + op, c % 3);
+		opl->writeReg(0xE3 + op, (c + 1) % 3);
+		opl->writeReg(0xC0 + c, 0x30 | ((c & 7) << 1));
+	}
+
+	if (type == kOPLStreamRhythm)
+		opl->writeReg(0xBD, 0x20);
+}
+
+/**
+ * Write a register right away, or queue it for the given sample if a queue
+ * is passed.
+ */
+void writeOPLReg(OPL::OPL *opl, OPL::WriteQueue *queue, uint32 sample, int r, int v) {
+	if (queue)
+		queue->push(sample, r, v);
+	else
+		opl->writeReg(r, v);
+}
+
+/**
+ * Write the registers of one player tick. The streams are synthesized, but
+ * modelled on the AdLib players of SCUMM (notes on all nine channels with
+ * volume and pitch bend updates every tick) and Kyra (rhythm mode percussion
+ * and per tick vibrato on the melodic channels).
+ */
+void writeOPLTick(OPL::OPL *opl, OPL::WriteQueue *queue, uint32 sample, OPLStreamType type, uint32 tick) {
+	const int numChannels = (type == kOPLStreamRhythm) ? 6 : 9;
+
+	// Start a new note every few ticks, round robin over the channels
+	if ((tick & 3) == 0) {
+		const int c = (tick >> 2) % numChannels;
+		const int fnum = 0x157 + ((tick * 37) & 0xFF);
+		const int block = 3 + ((tick >> 4) & 1);
+		writeOPLReg(opl, queue, sample, 0xB0 + c, (fnum >> 8) | (block << 2));
+		writeOPLReg(opl, queue, sample, 0xA0 + c, fnum & 0xFF);
+		writeOPLReg(opl, queue, sample, 0xB0 + c, 0x20 | (fnum >> 8) | (block << 2));
+	}
+
+	for (int c = 0; c < numChannels; ++c) {
+		const int op = kOPLChannelOperators[c];
+		if (type == kOPLStreamMelodic) {
+			// Volume and pitch bend updates
+			writeOPLReg(opl, queue, sample, 0x43 + op, (tick + c * 5) & 0x1F);
+			writeOPLReg(opl, queue, sample, 0xA0 + c, (0x57 + ((tick + c) & 7)) & 0xFF);
+		} else {
+			// Vibrato
+			const int fnum = 0x200 + (((tick + c) & 7) < 4 ? 3 : -3);
+			writeOPLReg(opl, queue, sample, 0xA0 + c, fnum & 0xFF);
+			writeOPLReg(opl, queue, sample, 0xB0 + c, 0x20 | (fnum >> 8) | (4 << 2));
+		}
+	}
+
+	if (type == kOPLStreamRhythm) {
+		// Bass drum, snare and hi-hat patterns
+		byte hits = 0x20;
+		if ((tick % 18) == 0)
+			hits |= 0x10;
+		if ((tick % 36) == 18)
+			hits |= 0x08;
+		if ((tick % 9) == 0)
+			hits |= 0x01;
+		writeOPLReg(opl, queue, sample, 0xBD, 0x20);
+		writeOPLReg(opl, queue, sample, 0xBD, hits);
+	}
+}
+
+} // End of anonymous namespace
+
+TestExitStatus SoundSubsystem::oplThroughput() {
+	// Renders synthesized AdLib register streams with every OPL emulator
+	// and reports how much faster than real time they run. Each stream is
+	// rendered once tick by tick, and once in mixer sized buffers with the
+	// writes queued at their samples, as the AdLib MIDI driver does.
+	const int kRate = 44100;
+	const int kTickRate = 72;
+	const uint32 kDuration = 20;
+	const int kBufferFrames = 2048;
+
+	Testsuite::writeOnScreen("Benchmarking the OPL emulators...", Common::Point(0, 100));
+
+	static const OPL::Config::OplType kTypes[] = { OPL::Config::kOpl2, OPL::Config::kDualOpl2, OPL::Config::kOpl3 };
+	static const char *const kTypeNames[] = { "OPL2", "Dual OPL2", "OPL3" };
+	static const uint32 kTypeFlags[] = { OPL::Config::kFlagOpl2, OPL::Config::kFlagDualOpl2, OPL::Config::kFlagOpl3 };
+	static const char *const kStreamNames[] = { "melodic", "rhythm" };
+
+	const int samplesPerTick = kRate / kTickRate;
+	const uint32 numTicks = kDuration * kTickRate;
+	int16 *buffer = new int16[kBufferFrames * 2];
+	TestExitStatus passed = kTestPassed;
+
+	// Skip the autodetection entry, it is one of the real emulators
+	const OPL::Config::DriverId autoId = OPL::Config::parse("auto");
+
+	for (const OPL::Config::EmulatorDescription *emulator = OPL::Config::getAvailable(); emulator->name; ++emulator) {
+		if (emulator->id == autoId)
+			continue;
+
+		for (int t = 0; t < ARRAYSIZE(kTypes); ++t) {
+			if (!(emulator->flags & kTypeFlags[t]))
+				continue;
+
+			for (int stream = kOPLStreamMelodic; stream <= kOPLStreamRhythm; ++stream) {
+				for (int queued = 0; queued < 2; ++queued) {
+					OPL::OPL *opl = OPL::Config::create(emulator->id, kTypes[t]);
+					if (!opl || !opl->init(kRate)) {
+						Testsuite::logDetailedPrintf("Error! Could not create the %s %s emulator\n", emulator->name, kTypeNames[t]);
+						delete opl;
+						passed = kTestFailed;
+						continue;
+					}
+
+					const uint32 start = g_system->getMillis();
+					setupOPLStream(opl, (OPLStreamType)stream);
+					if (queued) {
+						OPL::WriteQueue queue;
+						uint32 tick = 0;
+						for (uint32 pos = 0; pos < numTicks * samplesPerTick; pos += kBufferFrames) {
+							for (; tick < numTicks && tick * samplesPerTick < pos + kBufferFrames; ++tick)
+								writeOPLTick(opl, &queue, tick * samplesPerTick - pos, (OPLStreamType)stream, tick);
+							queue.render(opl, buffer, kBufferFrames);
+						}
+					} else {
+						const int length = samplesPerTick * (opl->isStereo() ? 2 : 1);
+						for (uint32 tick = 0; tick < numTicks; ++tick) {
+							writeOPLTick(opl, 0, 0, (OPLStreamType)stream, tick);
+							opl->readBuffer(buffer, length);
+						}
+					}
+					const uint32 elapsed = MAX<uint32>(g_system->getMillis() - start, 1);
+					delete opl;
+
+					Testsuite::logPrintf("Info! %s %s, %s stream, %s: %u s of audio in %u ms (%ux real time)\n",
+					                     emulator->name, kTypeNames[t], kStreamNames[stream], queued ? "queued" : "per tick",
+					                     kDuration, elapsed, kDuration * 1000 / elapsed);
+
+					if (elapsed > kDuration * 1000) {
+						Testsuite::logDetailedPrintf("Error! The %s emulator is slower than real time\n", emulator->name);
+						passed = kTestFailed;
+					}
+				}
+			}
+		}
+	}
+
+	delete[] buffer;
+	Testsuite::clearScreen();
+	return passed;
+}
+
 SoundSubsystemTestSuite::SoundSubsystemTestSuite() {
 	addTest("SimpleBeeps", &SoundSubsystem::playBeeps, true);
 	addTest("MixSounds", &SoundSubsystem::mixSounds, true);
@@ -276,6 +526,8 @@ SoundSubsystemTestSuite::SoundSubsystemTestSuite() {
 		}
 	}
 	addTest("SampleRates", &SoundSubsystem::sampleRates, true);
+	addTest("MixerStress", &SoundSubsystem::mixerStress, false);
+	addTest("OPLThroughput", &SoundSubsystem::oplThroughput, false);
 }
 
 } // End of namespace Testbed
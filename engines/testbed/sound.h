@@ -48,6 +48,8 @@ TestExitStatus playBeeps();
 TestExitStatus mixSounds();
 TestExitStatus audiocdOutput();
 TestExitStatus sampleRates();
+TestExitStatus mixerStress();
+TestExitStatus oplThroughput();
 }
 
 class SoundSubsystemTestSuite : public Testsuite {
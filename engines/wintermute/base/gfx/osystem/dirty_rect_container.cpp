@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/wintermute/base/gfx/osystem/dirty_rect_container.h"
+
+namespace Wintermute {
+
+/**
+ * Extra area (in pixels) a merged rect may cover compared to the two rects
+ * it replaces, independent of their size.
+ */
+#define MERGE_SLACK_AREA (32 * 32)
+
+static inline uint32 rectArea(const Common::Rect &rect) {
+	return (uint32)rect.width() * (uint32)rect.height();
+}
+
+DirtyRectContainer::DirtyRectContainer() {
+}
+
+void DirtyRectContainer::setClipRect(const Common::Rect &clipRect) {
+	_clipRect = clipRect;
+}
+
+bool DirtyRectContainer::shouldMerge(const Common::Rect &a, const Common::Rect &b) {
+	if (a.intersects(b))
+		return true;
+
+	Common::Rect merged(a);
+	merged.extend(b);
+
+	// Accept a quarter of extra area, or a small absolute amount for
+	// tiny rects.
+	const uint32 separateArea = rectArea(a) + rectArea(b);
+	const uint32 extraArea = rectArea(merged) - separateArea;
+	return extraArea <= MAX<uint32>(MERGE_SLACK_AREA, separateArea / 4);
+}
+
+void DirtyRectContainer::addDirtyRect(const Common::Rect &rect) {
+	Common::Rect newRect(rect);
+	newRect.clip(_clipRect);
+	if (newRect.isEmpty())
+		return;
+
+	// Merging may make the new rect reach others it did not touch before,
+	// so repeat until nothing is left to merge.
+	bool merged;
+	do {
+		merged = false;
+		for (uint i = 0; i < _rects.size(); ++i) {
+			if (_rects[i].contains(newRect))
+				return;
+
+			if (shouldMerge(_rects[i], newRect)) {
+				newRect.extend(_rects[i]);
+				_rects.remove_at(i);
+				merged = true;
+				break;
+			}
+		}
+	} while (merged);
+
+	if (_rects.size() >= kMaxRects) {
+		for (uint i = 0; i < _rects.size(); ++i)
+			newRect.extend(_rects[i]);
+		_rects.clear();
+	}
+
+	_rects.push_back(newRect);
+}
+
+void DirtyRectContainer::reset() {
+	_rects.clear();
+}
+
+} // End of namespace Wintermute
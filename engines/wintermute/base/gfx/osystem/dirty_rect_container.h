@@ -0,0 +1,78 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef WINTERMUTE_DIRTY_RECT_CONTAINER_H
+#define WINTERMUTE_DIRTY_RECT_CONTAINER_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Wintermute {
+
+/**
+ * A set of dirty screen areas, kept as a short list of non-overlapping rects.
+ *
+ * Rects which overlap are always merged, as the renderer redraws the tickets
+ * per rect, and blending the same ticket twice would give wrong results.
+ * Nearby rects are merged as well, as long as the merged rect does not cover
+ * much more area than the two separate ones, since every rect adds a pass
+ * over the render queue and a copyRectToScreen call.
+ */
+class DirtyRectContainer {
+public:
+	DirtyRectContainer();
+
+	/**
+	 * Set the area all dirty rects are clipped to.
+	 */
+	void setClipRect(const Common::Rect &clipRect);
+
+	/**
+	 * Mark the given area as dirty.
+	 */
+	void addDirtyRect(const Common::Rect &rect);
+
+	/**
+	 * Remove all dirty rects.
+	 */
+	void reset();
+
+	bool isEmpty() const { return _rects.empty(); }
+
+	/**
+	 * Get the dirty areas. The rects do not overlap.
+	 */
+	const Common::Array<Common::Rect> &getRects() const { return _rects; }
+
+private:
+	/** Above this number of rects, they are all merged into one */
+	static const uint kMaxRects = 32;
+
+	Common::Array<Common::Rect> _rects;
+	Common::Rect _clipRect;
+
+	static bool shouldMerge(const Common::Rect &a, const Common::Rect &b);
+};
+
+} // End of namespace Wintermute
+
+#endif
@@ -273,6 +273,11 @@ public:
 		_activeSurface = surface;
 	}
 
+	/**
+	 * Returns the active drawing surface.
+	 */
+	Surface *getActiveSurface() const { return _activeSurface; }
+
 	/**
 	 * Fills the active surface with the specified fg/bg color or the active gradient.
 	 * Defaults to using the active Foreground color for filling.
@@ -427,6 +432,23 @@ public:
 	 */
 	virtual void drawStep(const Common::Rect &area, const DrawStep &step, uint32 extra = 0);
 
+	/**
+	 * Sets up the colors and drawing parameters of a draw step, without
+	 * drawing anything. This leaves the renderer in the same state as
+	 * drawStep() would.
+	 */
+	void setStepState(const DrawStep &step, uint32 extra = 0);
+
+	/** Number of values stored by getColorState(). */
+	static const int kColorStateSize = 5;
+
+	/**
+	 * Stores the foreground, background, bevel and gradient start and end
+	 * colors currently used by the renderer. Draw steps only set the colors
+	 * they specify, so these can influence how a draw step looks.
+	 */
+	virtual void getColorState(uint32 *colors) const = 0;
+
 	/**
 	 * Copies the part of the current frame to the system overlay.
 	 *
@@ -483,6 +505,7 @@ public:
 	 */
 	virtual void disableShadows() { _disableShadows = true; }
 	virtual void enableShadows() { _disableShadows = false; }
+	bool areShadowsDisabled() const { return _disableShadows; }
 
 	/**
 	 * Applies a whole-screen shading effect, used before opening a new dialog.
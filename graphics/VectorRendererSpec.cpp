@@ -376,6 +376,9 @@ VectorRendererSpec(PixelFormat format) :
 	_alphaMask((0xFF >> format.aLoss) << format.aShift) {
 
 	_bitmapAlphaColor = _format.RGBToColor(255, 0, 255);
+
+	_fgColor = _bgColor = _bevelColor = 0;
+	setGradientColors(0, 0, 0, 0, 0, 0);
 }
 
 /****************************
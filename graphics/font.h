@@ -173,6 +173,18 @@ public:
 	int wordWrapText(const Common::String &str, int maxWidth, Common::Array<Common::String> &lines) const;
 	int wordWrapText(const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines) const;
 
+protected:
+	/**
+	 * Draw a string which is already shortened to the text area. This is
+	 * used by drawString after the ellipsis handling.
+	 *
+	 * The default implementation lays out and draws the string character by
+	 * character. Fonts which can cache the layout of strings can override
+	 * this to speed up drawing the same text repeatedly.
+	 */
+	virtual void drawStringLine(Surface *dst, const Common::String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax) const;
+	virtual void drawStringLine(Surface *dst, const Common::U32String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax) const;
+
 private:
 	Common::String handleEllipsis(const Common::String &str, int w) const;
 };
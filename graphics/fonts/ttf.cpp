@@ -34,6 +34,9 @@
 #include "common/singleton.h"
 #include "common/stream.h"
 #include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/array.h"
+#include "common/ustr.h"
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -47,6 +50,15 @@ inline int ftCeil26_6(FT_Pos x) {
 	return (x + 63) / 64;
 }
 
+struct U32StringHash {
+	uint operator()(const Common::U32String &str) const {
+		uint hash = 0;
+		for (uint i = 0; i < str.size(); ++i)
+			hash = hash * 33 + str[i];
+		return hash;
+	}
+};
+
 } // End of anonymous namespace
 
 class TTFLibrary : public Common::Singleton<TTFLibrary> {
@@ -114,6 +126,11 @@ public:
 	virtual Common::Rect getBoundingBox(uint32 chr) const;
 
 	virtual void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const;
+
+protected:
+	virtual void drawStringLine(Surface *dst, const Common::String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax) const;
+	virtual void drawStringLine(Surface *dst, const Common::U32String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax) const;
+
 private:
 	bool _initialized;
 	FT_Face _face;
@@ -125,17 +142,66 @@ private:
 	int _ascent, _descent;
 
 	struct Glyph {
-		Surface image;
+		int atlasX, atlasY;   ///< Position of the glyph image in the atlas.
+		int width, height;    ///< Size of the glyph image.
 		int xOffset, yOffset;
 		int advance;
 		FT_UInt slot;
 	};
 
+	/**
+	 * All glyph images packed into one 8bpp surface. The glyphs are placed
+	 * left to right in shelves as high as the highest glyph in them. The
+	 * atlas grows when a glyph does not fit anymore.
+	 */
+	mutable Surface _atlas;
+	mutable int _atlasShelfX, _atlasShelfY, _atlasShelfHeight;
+
+	bool allocateAtlasSpace(int width, int height, int &x, int &y) const;
+	void growAtlas(int width, int height) const;
+
 	bool cacheGlyph(Glyph &glyph, uint32 chr) const;
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
 	mutable GlyphCache _glyphs;
 	bool _allowLateCaching;
 	void assureCached(uint32 chr) const;
+	const Glyph *getGlyph(uint32 chr) const;
+
+	void drawGlyph(Surface *dst, const Glyph &glyph, int x, int y, uint32 color) const;
+
+	/** Kerning offsets of pairs of glyph slots which fit into 16 bits each. */
+	typedef Common::HashMap<uint32, int> KerningCache;
+	mutable KerningCache _kerning;
+
+	/** A character of a laid out string. */
+	struct TextRunChar {
+		int x;       ///< Position relative to the start of the string.
+		int advance; ///< Width of the character.
+		const Glyph *glyph; ///< 0 if there is no glyph for the character.
+	};
+
+	/** The layout of a string, as drawn by drawString. */
+	struct TextRun {
+		Common::Array<TextRunChar> chars;
+		int width;        ///< Width of the string, as given by getStringWidth.
+		int minRight;     ///< Smallest right edge of a character.
+		int maxRight;     ///< Largest right edge of a character.
+		Common::Rect bbox; ///< Bounding box of all glyph images.
+	};
+
+	enum {
+		/** Number of strings whose layout is kept, per string type. */
+		kMaxCachedTextRuns = 256
+	};
+
+	typedef Common::HashMap<Common::String, TextRun> TextRunCache;
+	typedef Common::HashMap<Common::U32String, TextRun, U32StringHash> U32TextRunCache;
+	mutable TextRunCache _textRuns;
+	mutable U32TextRunCache _u32TextRuns;
+
+	template<class StringType, class CacheType>
+	const TextRun &getTextRun(CacheType &cache, const StringType &str) const;
+	void drawTextRun(Surface *dst, const TextRun &run, int x, int y, int w, uint32 color, TextAlign align, int deltax) const;
 
 	FT_Int32 _loadFlags;
 	FT_Render_Mode _renderMode;
@@ -144,7 +210,8 @@ private:
 
 TTFFont::TTFFont()
     : _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
-      _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
+      _descent(0), _atlasShelfX(0), _atlasShelfY(0), _atlasShelfHeight(0), _glyphs(),
+      _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
       _hasKerning(false), _allowLateCaching(false) {
 }
 
@@ -155,11 +222,10 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
-
 		_initialized = false;
 	}
+
+	_atlas.free();
 }
 
 bool TTFFont::load(Common::SeekableReadStream &stream, int size, uint dpi, TTFRenderMode renderMode, const uint32 *mapping) {
@@ -271,56 +337,55 @@ int TTFFont::getMaxCharWidth() const {
 }
 
 int TTFFont::getCharWidth(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyph = getGlyph(chr);
+	if (!glyph)
 		return 0;
 	else
-		return glyphEntry->_value.advance;
+		return glyph->advance;
 }
 
 int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 	if (!_hasKerning)
 		return 0;
 
-	assureCached(left);
-	assureCached(right);
-
-	FT_UInt leftGlyph, rightGlyph;
-	GlyphCache::const_iterator glyphEntry;
-
-	glyphEntry = _glyphs.find(left);
-	if (glyphEntry != _glyphs.end()) {
-		leftGlyph = glyphEntry->_value.slot;
-	} else {
+	const Glyph *leftGlyph = getGlyph(left);
+	if (!leftGlyph)
 		return 0;
-	}
 
-	glyphEntry = _glyphs.find(right);
-	if (glyphEntry != _glyphs.end()) {
-		rightGlyph = glyphEntry->_value.slot;
-	} else {
+	const Glyph *rightGlyph = getGlyph(right);
+	if (!rightGlyph)
 		return 0;
-	}
 
-	if (!leftGlyph || !rightGlyph)
+	if (!leftGlyph->slot || !rightGlyph->slot)
 		return 0;
 
+	// Looking up the kerning through FreeType is slow compared to the rest
+	// of the text layout, so remember the offsets of the pairs we have seen.
+	const bool cachable = (leftGlyph->slot <= 0xFFFF && rightGlyph->slot <= 0xFFFF);
+	const uint32 pair = (leftGlyph->slot << 16) | rightGlyph->slot;
+
+	if (cachable) {
+		KerningCache::const_iterator kerningEntry = _kerning.find(pair);
+		if (kerningEntry != _kerning.end())
+			return kerningEntry->_value;
+	}
+
 	FT_Vector kerningVector;
-	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
-	return (kerningVector.x / 64);
+	FT_Get_Kerning(_face, leftGlyph->slot, rightGlyph->slot, FT_KERNING_DEFAULT, &kerningVector);
+	const int offset = kerningVector.x / 64;
+
+	if (cachable)
+		_kerning[pair] = offset;
+
+	return offset;
 }
 
 Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end()) {
+	const Glyph *glyph = getGlyph(chr);
+	if (!glyph) {
 		return Common::Rect();
 	} else {
-		const int xOffset = glyphEntry->_value.xOffset;
-		const int yOffset = glyphEntry->_value.yOffset;
-		const Graphics::Surface &image = glyphEntry->_value.image;
-		return Common::Rect(xOffset, yOffset, xOffset + image.w, yOffset + image.h);
+		return Common::Rect(glyph->xOffset, glyph->yOffset, glyph->xOffset + glyph->width, glyph->yOffset + glyph->height);
 	}
 }
 
@@ -360,16 +425,49 @@ void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos, const i
 	}
 }
 
+void renderGlyphCLUT8(uint8 *dstPos, const int dstPitch, const uint8 *srcPos, const int srcPitch, const int w, const int h, uint8 color) {
+	for (int y = 0; y < h; ++y) {
+		uint8 *rDst = dstPos;
+		const uint8 *src = srcPos;
+
+		for (int x = 0; x < w; ++x) {
+			// We assume a 1Bpp mode is a color indexed mode, thus we can
+			// not take advantage of anti-aliasing here.
+			if (*src >= 0x80)
+				*rDst = color;
+
+			++rDst;
+			++src;
+		}
+
+		dstPos += dstPitch;
+		srcPos += srcPitch;
+	}
+}
+
+void renderGlyph(Surface *dst, int x, int y, const uint8 *srcPos, const int srcPitch, const int w, const int h, uint32 color) {
+	uint8 *dstPos = (uint8 *)dst->getBasePtr(x, y);
+
+	if (dst->format.bytesPerPixel == 1) {
+		renderGlyphCLUT8(dstPos, dst->pitch, srcPos, srcPitch, w, h, color);
+	} else if (dst->format.bytesPerPixel == 2) {
+		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format);
+	} else if (dst->format.bytesPerPixel == 4) {
+		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format);
+	}
+}
+
 } // End of anonymous namespace
 
 void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyph = getGlyph(chr);
+	if (!glyph)
 		return;
 
-	const Glyph &glyph = glyphEntry->_value;
+	drawGlyph(dst, *glyph, x, y, color);
+}
 
+void TTFFont::drawGlyph(Surface *dst, const Glyph &glyph, int x, int y, uint32 color) const {
 	x += glyph.xOffset;
 	y += glyph.yOffset;
 
@@ -378,10 +476,10 @@ void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) con
 	if (y > dst->h)
 		return;
 
-	int w = glyph.image.w;
-	int h = glyph.image.h;
+	int w = glyph.width;
+	int h = glyph.height;
 
-	const uint8 *srcPos = (const uint8 *)glyph.image.getPixels();
+	const uint8 *srcPos = (const uint8 *)_atlas.getBasePtr(glyph.atlasX, glyph.atlasY);
 
 	// Make sure we are not drawing outside the screen bounds
 	if (x < 0) {
@@ -397,7 +495,7 @@ void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) con
 		return;
 
 	if (y < 0) {
-		srcPos -= y * glyph.image.pitch;
+		srcPos -= y * _atlas.pitch;
 		h += y;
 		y = 0;
 	}
@@ -408,31 +506,150 @@ void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) con
 	if (h <= 0)
 		return;
 
-	uint8 *dstPos = (uint8 *)dst->getBasePtr(x, y);
+	renderGlyph(dst, x, y, srcPos, _atlas.pitch, w, h, color);
+}
 
-	if (dst->format.bytesPerPixel == 1) {
-		for (int cy = 0; cy < h; ++cy) {
-			uint8 *rDst = dstPos;
-			const uint8 *src = srcPos;
-
-			for (int cx = 0; cx < w; ++cx) {
-				// We assume a 1Bpp mode is a color indexed mode, thus we can
-				// not take advantage of anti-aliasing here.
-				if (*src >= 0x80)
-					*rDst = color;
-
-				++rDst;
-				++src;
-			}
+void TTFFont::drawStringLine(Surface *dst, const Common::String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax) const {
+	drawTextRun(dst, getTextRun(_textRuns, str), x, y, w, color, align, deltax);
+}
+
+void TTFFont::drawStringLine(Surface *dst, const Common::U32String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax) const {
+	drawTextRun(dst, getTextRun(_u32TextRuns, str), x, y, w, color, align, deltax);
+}
 
-			dstPos += dst->pitch;
-			srcPos += glyph.image.pitch;
+template<class StringType, class CacheType>
+const TTFFont::TextRun &TTFFont::getTextRun(CacheType &cache, const StringType &str) const {
+	typename CacheType::iterator runEntry = cache.find(str);
+	if (runEntry != cache.end())
+		return runEntry->_value;
+
+	if (cache.size() >= kMaxCachedTextRuns)
+		cache.clear();
+
+	// This follows the layout done by Font::drawString, with the positions
+	// relative to the start of the string. The glyph pointers stay valid as
+	// glyphs are never removed from the glyph cache once the font is loaded.
+	TextRun &run = cache[str];
+	run.chars.resize(str.size());
+	run.minRight = 0x7FFFFFFF;
+	run.maxRight = -0x7FFFFFFF;
+
+	int x = 0;
+	typename StringType::unsigned_type last = 0;
+	for (uint i = 0; i < str.size(); ++i) {
+		const typename StringType::unsigned_type cur = str[i];
+		TextRunChar &runChar = run.chars[i];
+
+		x += getKerningOffset(last, cur);
+		last = cur;
+
+		runChar.x = x;
+		runChar.glyph = getGlyph(cur);
+		runChar.advance = runChar.glyph ? runChar.glyph->advance : 0;
+
+		run.minRight = MIN(run.minRight, x + runChar.advance);
+		run.maxRight = MAX(run.maxRight, x + runChar.advance);
+
+		if (runChar.glyph) {
+			const Glyph &glyph = *runChar.glyph;
+			Common::Rect glyphBox(x + glyph.xOffset, glyph.yOffset, x + glyph.xOffset + glyph.width, glyph.yOffset + glyph.height);
+			if (run.bbox.isEmpty())
+				run.bbox = glyphBox;
+			else if (!glyphBox.isEmpty())
+				run.bbox.extend(glyphBox);
 		}
-	} else if (dst->format.bytesPerPixel == 2) {
-		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
-	} else if (dst->format.bytesPerPixel == 4) {
-		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
+
+		x += runChar.advance;
 	}
+
+	run.width = x;
+	return run;
+}
+
+void TTFFont::drawTextRun(Surface *dst, const TextRun &run, int x, int y, int w, uint32 color, TextAlign align, int deltax) const {
+	assert(dst != 0);
+
+	if (run.chars.empty())
+		return;
+
+	const int leftX = x, rightX = x + w;
+
+	if (align == kTextAlignCenter)
+		x = x + (w - run.width)/2;
+	else if (align == kTextAlignRight)
+		x = x + w - run.width;
+	x += deltax;
+
+	Common::Rect bbox = run.bbox;
+	bbox.translate(x, y);
+
+	if (x + run.minRight >= leftX && x + run.maxRight <= rightX
+	    && bbox.left >= 0 && bbox.top >= 0 && bbox.right <= dst->w && bbox.bottom <= dst->h) {
+		// The whole string is visible and inside the surface, so we can
+		// render all glyphs without checking them one by one.
+		for (Common::Array<TextRunChar>::const_iterator i = run.chars.begin(), end = run.chars.end(); i != end; ++i) {
+			const Glyph *glyph = i->glyph;
+			if (glyph && glyph->width && glyph->height)
+				renderGlyph(dst, x + i->x + glyph->xOffset, y + glyph->yOffset, (const uint8 *)_atlas.getBasePtr(glyph->atlasX, glyph->atlasY), _atlas.pitch, glyph->width, glyph->height, color);
+		}
+		return;
+	}
+
+	for (Common::Array<TextRunChar>::const_iterator i = run.chars.begin(), end = run.chars.end(); i != end; ++i) {
+		const int charX = x + i->x;
+		if (charX + i->advance > rightX)
+			break;
+		if (charX + i->advance >= leftX && i->glyph)
+			drawGlyph(dst, *i->glyph, charX, y, color);
+	}
+}
+
+bool TTFFont::allocateAtlasSpace(int width, int height, int &x, int &y) const {
+	if (width > _atlas.w)
+		return false;
+
+	// Start a new shelf when the glyph does not fit into the current one
+	if (_atlasShelfX + width > _atlas.w) {
+		_atlasShelfX = 0;
+		_atlasShelfY += _atlasShelfHeight;
+		_atlasShelfHeight = 0;
+	}
+
+	if (_atlasShelfY + height > _atlas.h)
+		return false;
+
+	x = _atlasShelfX;
+	y = _atlasShelfY;
+
+	_atlasShelfX += width;
+	_atlasShelfHeight = MAX(_atlasShelfHeight, height);
+	return true;
+}
+
+void TTFFont::growAtlas(int width, int height) const {
+	// Make room for 16 glyphs of the maximum size per shelf and start with
+	// enough shelves for the 256 glyphs we load up front.
+	int newWidth = MAX<int>(_atlas.w, MAX(16 * _width, width));
+	int newHeight = _atlas.h ? _atlas.h * 2 : 16 * MAX(_height, 1);
+	while (newHeight < _atlasShelfY + _atlasShelfHeight + height)
+		newHeight *= 2;
+
+	Surface newAtlas;
+	newAtlas.create(newWidth, newHeight, PixelFormat::createFormatCLUT8());
+	memset(newAtlas.getPixels(), 0, newAtlas.h * newAtlas.pitch);
+
+	if (_atlas.getPixels())
+		newAtlas.copyRectToSurface(_atlas, 0, 0, Common::Rect(_atlas.w, _atlas.h));
+
+	// The existing shelves can not be widened, so new glyphs go below them
+	if (newWidth != _atlas.w && _atlasShelfX) {
+		_atlasShelfX = 0;
+		_atlasShelfY += _atlasShelfHeight;
+		_atlasShelfHeight = 0;
+	}
+
+	_atlas.free();
+	_atlas = newAtlas;
 }
 
 bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
@@ -460,7 +677,20 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	glyph.advance = ftCeil26_6(_face->glyph->advance.x);
 
 	const FT_Bitmap &bitmap = _face->glyph->bitmap;
-	glyph.image.create(bitmap.width, bitmap.rows, PixelFormat::createFormatCLUT8());
+
+	if (bitmap.pixel_mode != FT_PIXEL_MODE_MONO && bitmap.pixel_mode != FT_PIXEL_MODE_GRAY) {
+		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap.pixel_mode);
+		return false;
+	}
+
+	glyph.width = bitmap.width;
+	glyph.height = bitmap.rows;
+
+	if (!allocateAtlasSpace(glyph.width, glyph.height, glyph.atlasX, glyph.atlasY)) {
+		growAtlas(glyph.width, glyph.height);
+		if (!allocateAtlasSpace(glyph.width, glyph.height, glyph.atlasX, glyph.atlasY))
+			error("TTFFont::cacheGlyph: Could not allocate atlas space for glyph %d", chr);
+	}
 
 	const uint8 *src = bitmap.buffer;
 	int srcPitch = bitmap.pitch;
@@ -469,8 +699,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		srcPitch = -srcPitch;
 	}
 
-	uint8 *dst = (uint8 *)glyph.image.getPixels();
-	memset(dst, 0, glyph.image.h * glyph.image.pitch);
+	uint8 *dst = (uint8 *)_atlas.getBasePtr(glyph.atlasX, glyph.atlasY);
 
 	switch (bitmap.pixel_mode) {
 	case FT_PIXEL_MODE_MONO:
@@ -482,13 +711,12 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 				if ((x % 8) == 0)
 					mask = *curSrc++;
 
-				if (mask & 0x80)
-					*dst = 255;
+				dst[x] = (mask & 0x80) ? 255 : 0;
 
 				mask <<= 1;
-				++dst;
 			}
 
+			dst += _atlas.pitch;
 			src += srcPitch;
 		}
 		break;
@@ -496,15 +724,10 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	case FT_PIXEL_MODE_GRAY:
 		for (uint y = 0; y < bitmap.rows; ++y) {
 			memcpy(dst, src, bitmap.width);
-			dst += glyph.image.pitch;
+			dst += _atlas.pitch;
 			src += srcPitch;
 		}
 		break;
-
-	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap.pixel_mode);
-		glyph.image.free();
-		return false;
 	}
 
 	return true;
@@ -521,6 +744,20 @@ void TTFFont::assureCached(uint32 chr) const {
 	}
 }
 
+const TTFFont::Glyph *TTFFont::getGlyph(uint32 chr) const {
+	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
+	if (glyphEntry != _glyphs.end())
+		return &glyphEntry->_value;
+
+	assureCached(chr);
+
+	glyphEntry = _glyphs.find(chr);
+	if (glyphEntry == _glyphs.end())
+		return 0;
+	else
+		return &glyphEntry->_value;
+}
+
 Font *loadTTFFont(Common::SeekableReadStream &stream, int size, uint dpi, TTFRenderMode renderMode, const uint32 *mapping) {
 	TTFFont *font = new TTFFont();
 
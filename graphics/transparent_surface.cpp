@@ -28,6 +28,7 @@
 
 
 #include "common/algorithm.h"
+#include "common/cpudetect.h"
 #include "common/endian.h"
 #include "common/util.h"
 #include "common/rect.h"
@@ -37,6 +38,11 @@
 #include "graphics/transparent_surface.h"
 #include "graphics/transform_tools.h"
 
+#if defined(SCUMMVM_SSE2) && defined(SCUMM_LITTLE_ENDIAN)
+#include <emmintrin.h>
+#define USE_SSE2_BLITTING
+#endif
+
 //#define ENABLE_BILINEAR
 
 namespace Graphics {
@@ -61,6 +67,262 @@ static const int kGIndex = 1;
 static const int kRIndex = 0;
 #endif
 
+/**
+ * Vectorized versions of the inner loops of the blending functions below.
+ * A row function blends 'count' pixels, which must be a multiple of four,
+ * and produces exactly the same result as the scalar code.
+ */
+typedef void (*BlendRowProc)(const byte *in, byte *out, uint32 count, int32 inStep, uint32 color);
+
+#ifdef USE_SSE2_BLITTING
+
+/**
+ * Loads four source pixels, in blitting order
+ */
+SCUMMVM_TARGET_SSE2
+static inline __m128i loadSourcePixels(const byte *in, int32 inStep) {
+	if (inStep > 0)
+		return _mm_loadu_si128((const __m128i *)in);
+
+	// Horizontally flipped, the next pixels are at lower addresses
+	return _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(in - 12)), _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+/**
+ * Broadcasts the alpha value of each of the two pixels in a vector of
+ * unpacked 16-bit channels to all channels of that pixel
+ */
+SCUMMVM_TARGET_SSE2
+static inline __m128i broadcastAlpha(__m128i pixels) {
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+}
+
+/**
+ * Returns per channel multipliers for color modulation, as 16-bit values in
+ * the order of unpacked pixel channels. Channels with full intensity get
+ * 'fullValue' instead of 255.
+ */
+SCUMMVM_TARGET_SSE2
+static inline __m128i colorModFactors(uint32 color, uint16 fullValue) {
+	uint16 c[4];
+	c[kAIndex] = 0;
+	c[kBIndex] = (color >> kBModShift) & 0xFF;
+	c[kGIndex] = (color >> kGModShift) & 0xFF;
+	c[kRIndex] = (color >> kRModShift) & 0xFF;
+	for (int i = 0; i < 4; i++) {
+		if (i != kAIndex && c[i] == 255)
+			c[i] = fullValue;
+	}
+	return _mm_setr_epi16(c[0], c[1], c[2], c[3], c[0], c[1], c[2], c[3]);
+}
+
+SCUMMVM_TARGET_SSE2
+static void blendRowAlphaSSE2(const byte *in, byte *out, uint32 count, int32 inStep, uint32 color) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i full = _mm_set1_epi16(255);
+	const __m128i alphaMask = _mm_set1_epi32(0xFF << (kAIndex * 8));
+
+	for (uint32 j = 0; j < count; j += 4) {
+		const __m128i src = loadSourcePixels(in, inStep);
+		const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+		const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), zero);
+
+		__m128i s = _mm_unpacklo_epi8(src, zero);
+		__m128i d = _mm_unpacklo_epi8(dst, zero);
+		__m128i a = broadcastAlpha(s);
+		const __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, _mm_sub_epi16(full, a))), 8);
+
+		s = _mm_unpackhi_epi8(src, zero);
+		d = _mm_unpackhi_epi8(dst, zero);
+		a = broadcastAlpha(s);
+		const __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, _mm_sub_epi16(full, a))), 8);
+
+		// Fully transparent source pixels leave the target untouched
+		const __m128i result = _mm_or_si128(_mm_packus_epi16(lo, hi), alphaMask);
+		_mm_storeu_si128((__m128i *)out, _mm_or_si128(_mm_and_si128(transparent, dst), _mm_andnot_si128(transparent, result)));
+
+		in += 4 * inStep;
+		out += 16;
+	}
+}
+
+SCUMMVM_TARGET_SSE2
+static void blendRowAlphaColorSSE2(const byte *in, byte *out, uint32 count, int32 inStep, uint32 color) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i full = _mm_set1_epi16(255);
+	const __m128i alphaMask = _mm_set1_epi32(0xFF << (kAIndex * 8));
+	const __m128i ca = _mm_set1_epi16((color >> kAModShift) & 0xFF);
+	const __m128i cmod = colorModFactors(color, 255);
+
+	for (uint32 j = 0; j < count; j += 4) {
+		const __m128i src = loadSourcePixels(in, inStep);
+		const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		__m128i s = _mm_unpacklo_epi8(src, zero);
+		__m128i ina = _mm_srli_epi16(_mm_mullo_epi16(broadcastAlpha(s), ca), 8);
+		__m128i d = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), _mm_sub_epi16(full, ina)), 8);
+		const __m128i lo = _mm_add_epi16(d, _mm_mulhi_epu16(_mm_mullo_epi16(s, ina), cmod));
+
+		s = _mm_unpackhi_epi8(src, zero);
+		ina = _mm_srli_epi16(_mm_mullo_epi16(broadcastAlpha(s), ca), 8);
+		d = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), _mm_sub_epi16(full, ina)), 8);
+		const __m128i hi = _mm_add_epi16(d, _mm_mulhi_epu16(_mm_mullo_epi16(s, ina), cmod));
+
+		_mm_storeu_si128((__m128i *)out, _mm_or_si128(_mm_packus_epi16(lo, hi), alphaMask));
+
+		in += 4 * inStep;
+		out += 16;
+	}
+}
+
+SCUMMVM_TARGET_SSE2
+static void blendRowAdditiveSSE2(const byte *in, byte *out, uint32 count, int32 inStep, uint32 color) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF << (kAIndex * 8));
+
+	for (uint32 j = 0; j < count; j += 4) {
+		const __m128i src = loadSourcePixels(in, inStep);
+		const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		// Transparent source pixels add nothing, so they need no special case
+		__m128i s = _mm_unpacklo_epi8(src, zero);
+		const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(dst, zero), _mm_srli_epi16(_mm_mullo_epi16(s, broadcastAlpha(s)), 8));
+		s = _mm_unpackhi_epi8(src, zero);
+		const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(dst, zero), _mm_srli_epi16(_mm_mullo_epi16(s, broadcastAlpha(s)), 8));
+
+		// The target alpha is left as is
+		const __m128i result = _mm_packus_epi16(lo, hi);
+		_mm_storeu_si128((__m128i *)out, _mm_or_si128(_mm_and_si128(alphaMask, dst), _mm_andnot_si128(alphaMask, result)));
+
+		in += 4 * inStep;
+		out += 16;
+	}
+}
+
+SCUMMVM_TARGET_SSE2
+static void blendRowAdditiveColorSSE2(const byte *in, byte *out, uint32 count, int32 inStep, uint32 color) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF << (kAIndex * 8));
+	const __m128i ca = _mm_set1_epi16((color >> kAModShift) & 0xFF);
+	// (x * 256) >> 16 == x >> 8 takes care of the unmodulated channels
+	const __m128i cmod = colorModFactors(color, 256);
+
+	for (uint32 j = 0; j < count; j += 4) {
+		const __m128i src = loadSourcePixels(in, inStep);
+		const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		__m128i s = _mm_unpacklo_epi8(src, zero);
+		__m128i ina = _mm_srli_epi16(_mm_mullo_epi16(broadcastAlpha(s), ca), 8);
+		const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(dst, zero), _mm_mulhi_epu16(_mm_mullo_epi16(s, ina), cmod));
+
+		s = _mm_unpackhi_epi8(src, zero);
+		ina = _mm_srli_epi16(_mm_mullo_epi16(broadcastAlpha(s), ca), 8);
+		const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(dst, zero), _mm_mulhi_epu16(_mm_mullo_epi16(s, ina), cmod));
+
+		const __m128i result = _mm_packus_epi16(lo, hi);
+		_mm_storeu_si128((__m128i *)out, _mm_or_si128(_mm_and_si128(alphaMask, dst), _mm_andnot_si128(alphaMask, result)));
+
+		in += 4 * inStep;
+		out += 16;
+	}
+}
+
+SCUMMVM_TARGET_SSE2
+static void blendRowSubtractiveSSE2(const byte *in, byte *out, uint32 count, int32 inStep, uint32 color) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF << (kAIndex * 8));
+
+	for (uint32 j = 0; j < count; j += 4) {
+		const __m128i src = loadSourcePixels(in, inStep);
+		const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		// Transparent source pixels subtract nothing, so they need no special case
+		__m128i s = _mm_unpacklo_epi8(src, zero);
+		__m128i d = _mm_unpacklo_epi8(dst, zero);
+		const __m128i lo = _mm_sub_epi16(d, _mm_mulhi_epu16(_mm_mullo_epi16(s, d), broadcastAlpha(s)));
+		s = _mm_unpackhi_epi8(src, zero);
+		d = _mm_unpackhi_epi8(dst, zero);
+		const __m128i hi = _mm_sub_epi16(d, _mm_mulhi_epu16(_mm_mullo_epi16(s, d), broadcastAlpha(s)));
+
+		// The target alpha is left as is
+		const __m128i result = _mm_packus_epi16(lo, hi);
+		_mm_storeu_si128((__m128i *)out, _mm_or_si128(_mm_and_si128(alphaMask, dst), _mm_andnot_si128(alphaMask, result)));
+
+		in += 4 * inStep;
+		out += 16;
+	}
+}
+
+SCUMMVM_TARGET_SSE2
+static void blendRowSubtractiveColorSSE2(const byte *in, byte *out, uint32 count, int32 inStep, uint32 color) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF << (kAIndex * 8));
+	// (x * 256) >> 24 == x >> 16 takes care of the unmodulated channels
+	const __m128i cmod = colorModFactors(color, 256);
+
+	for (uint32 j = 0; j < count; j += 4) {
+		const __m128i src = loadSourcePixels(in, inStep);
+		const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		__m128i s = _mm_unpacklo_epi8(src, zero);
+		__m128i d = _mm_unpacklo_epi8(dst, zero);
+		__m128i factor = _mm_mullo_epi16(cmod, broadcastAlpha(s));
+		const __m128i lo = _mm_sub_epi16(d, _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(s, d), factor), 8));
+
+		s = _mm_unpackhi_epi8(src, zero);
+		d = _mm_unpackhi_epi8(dst, zero);
+		factor = _mm_mullo_epi16(cmod, broadcastAlpha(s));
+		const __m128i hi = _mm_sub_epi16(d, _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(s, d), factor), 8));
+
+		_mm_storeu_si128((__m128i *)out, _mm_or_si128(_mm_packus_epi16(lo, hi), alphaMask));
+
+		in += 4 * inStep;
+		out += 16;
+	}
+}
+
+#endif
+
+/**
+ * Returns the vectorized row function to use, or NULL if there is none
+ * for the running CPU.
+ */
+static BlendRowProc getBlendRowProc(TSpriteBlendMode blendMode, uint32 color) {
+#ifdef USE_SSE2_BLITTING
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2)) {
+		const bool colorMod = (color != 0xffffffff);
+		switch (blendMode) {
+		case BLEND_ADDITIVE:
+			return colorMod ? blendRowAdditiveColorSSE2 : blendRowAdditiveSSE2;
+		case BLEND_SUBTRACTIVE:
+			return colorMod ? blendRowSubtractiveColorSSE2 : blendRowSubtractiveSSE2;
+		default:
+			return colorMod ? blendRowAlphaColorSSE2 : blendRowAlphaSSE2;
+		}
+	}
+#endif
+
+	return NULL;
+}
+
+/**
+ * Blends as many pixels of a row as the vectorized row function can
+ * handle, and advances the row pointers past them.
+ * @return the number of pixels blended
+ */
+static inline uint32 blendRowSIMD(BlendRowProc proc, byte *&in, byte *&out, uint32 width, int32 inStep, uint32 color) {
+	if (!proc)
+		return 0;
+
+	const uint32 count = width & ~3;
+	if (count) {
+		proc(in, out, count, inStep, color);
+		in += (int32)count * inStep;
+		out += count * 4;
+	}
+	return count;
+}
+
 void doBlitOpaqueFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep);
 void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep);
 void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
@@ -146,13 +408,14 @@ void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
 	byte *in;
 	byte *out;
+	BlendRowProc rowProc = getBlendRowProc(BLEND_NORMAL, color);
 
 	if (color == 0xffffffff) {
 
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			for (uint32 j = blendRowSIMD(rowProc, in, out, width, inStep, color); j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kAIndex] = 255;
@@ -177,7 +440,7 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			for (uint32 j = blendRowSIMD(rowProc, in, out, width, inStep, color); j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 				out[kAIndex] = 255;
@@ -204,13 +467,14 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
 	byte *in;
 	byte *out;
+	BlendRowProc rowProc = getBlendRowProc(BLEND_ADDITIVE, color);
 
 	if (color == 0xffffffff) {
 
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			for (uint32 j = blendRowSIMD(rowProc, in, out, width, inStep, color); j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MIN((in[kRIndex] * in[kAIndex] >> 8) + out[kRIndex], 255);
@@ -234,7 +498,7 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			for (uint32 j = blendRowSIMD(rowProc, in, out, width, inStep, color); j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 
@@ -271,13 +535,14 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
 	byte *in;
 	byte *out;
+	BlendRowProc rowProc = getBlendRowProc(BLEND_SUBTRACTIVE, color);
 
 	if (color == 0xffffffff) {
 
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			for (uint32 j = blendRowSIMD(rowProc, in, out, width, inStep, color); j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MAX(out[kRIndex] - ((in[kRIndex] * out[kRIndex]) * in[kAIndex] >> 16), 0);
@@ -300,23 +565,23 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			for (uint32 j = blendRowSIMD(rowProc, in, out, width, inStep, color); j < width; j++) {
 
 				out[kAIndex] = 255;
 				if (cb != 255) {
-					out[kBIndex] = MAX(out[kBIndex] - ((in[kBIndex] * cb  * (out[kBIndex]) * in[kAIndex]) >> 24), 0);
+					out[kBIndex] = MAX(out[kBIndex] - (int)(((uint32)in[kBIndex] * cb * out[kBIndex] * in[kAIndex]) >> 24), 0);
 				} else {
 					out[kBIndex] = MAX(out[kBIndex] - (in[kBIndex] * (out[kBIndex]) * in[kAIndex] >> 16), 0);
 				}
 
 				if (cg != 255) {
-					out[kGIndex] = MAX(out[kGIndex] - ((in[kGIndex] * cg  * (out[kGIndex]) * in[kAIndex]) >> 24), 0);
+					out[kGIndex] = MAX(out[kGIndex] - (int)(((uint32)in[kGIndex] * cg * out[kGIndex] * in[kAIndex]) >> 24), 0);
 				} else {
 					out[kGIndex] = MAX(out[kGIndex] - (in[kGIndex] * (out[kGIndex]) * in[kAIndex] >> 16), 0);
 				}
 
 				if (cr != 255) {
-					out[kRIndex] = MAX(out[kRIndex] - ((in[kRIndex] * cr * (out[kRIndex]) * in[kAIndex]) >> 24), 0);
+					out[kRIndex] = MAX(out[kRIndex] - (int)(((uint32)in[kRIndex] * cr * out[kRIndex] * in[kAIndex]) >> 24), 0);
 				} else {
 					out[kRIndex] = MAX(out[kRIndex] - (in[kRIndex] * (out[kRIndex]) * in[kAIndex] >> 16), 0);
 				}
@@ -83,9 +83,28 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/cpudetect.h"
+#include "common/endian.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
+#if defined(SCUMMVM_SSE2)
+#include <emmintrin.h>
+#define USE_SSE2_YUV
+#endif
+#if defined(SCUMMVM_AVX2)
+#include <immintrin.h>
+#define USE_AVX2_YUV
+#endif
+#if defined(SCUMMVM_NEON) && defined(SCUMM_LITTLE_ENDIAN)
+#include <arm_neon.h>
+#define USE_NEON_YUV
+#endif
+
+#if defined(USE_SSE2_YUV) || defined(USE_AVX2_YUV) || defined(USE_NEON_YUV)
+#define USE_SIMD_YUV
+#endif
+
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 }
@@ -192,6 +211,426 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+/*
+ * The vectorized conversion code computes the same results as the lookup
+ * tables above. Instead of looking up the chroma contributions in the color
+ * table, it multiplies by 16.16 fixed point versions of the factors. For all
+ * chroma values, rounding the product down and adding one for negative values
+ * gives the same as the truncation used for the table entries. Clamping the
+ * channels replaces the spread out parts of the rgb-to-pixel tables, and the
+ * ITU luminance scaling multiplies by 255 / 219 in 1.15 fixed point, which is
+ * exact for [0, 219].
+ */
+
+#ifdef USE_SIMD_YUV
+
+// (1.401337..., 0.713603..., 0.344410..., 1.773413...) * 65536
+enum {
+	kCrRFactor = 91838,
+	kCrGFactor = 46766,
+	kCbGFactor = 22571,
+	kCbBFactor = 116222,
+	kITUFactor = 38155 // (255 << 15) / 219, rounded up
+};
+
+/**
+ * How to put the channels together into a pixel of the destination format.
+ */
+struct YUVPixelPacking {
+	int rLoss, gLoss, bLoss;
+	int rShift, gShift, bShift;
+	uint32 alpha;
+	int minValue, maxValue;
+	bool scaleITU;
+
+	YUVPixelPacking(const Graphics::PixelFormat &format, YUVToRGBManager::LuminanceScale scale) {
+		rLoss = format.rLoss;
+		gLoss = format.gLoss;
+		bLoss = format.bLoss;
+		rShift = format.rShift;
+		gShift = format.gShift;
+		bShift = format.bShift;
+		alpha = (0xFF >> format.aLoss) << format.aShift;
+		scaleITU = (scale == YUVToRGBManager::kScaleITU);
+		minValue = scaleITU ? 16 : 0;
+		maxValue = scaleITU ? 235 : 255;
+	}
+};
+
+/**
+ * Convert width pixels (rounded down to the block size of the function)
+ * and return the number of pixels converted. If halfChroma is set, there is
+ * one chroma sample for every two pixels of two rows, and both rows are
+ * converted. Otherwise there is one chroma sample for every pixel.
+ */
+typedef int (*YUVConvertRowProc)(byte *dst, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc, int width, const YUVPixelPacking &packing);
+
+#endif
+
+#ifdef USE_SSE2_YUV
+
+// Compute (int16)(factor * value) for value = chroma - 128, see above. The
+// fractional parts of the factors which don't fit into a signed 16 bit value
+// are even, so the value can be doubled instead.
+SCUMMVM_TARGET_SSE2
+static inline __m128i chromaOffsetSSE2(__m128i value, int factor) {
+	const int fraction = factor & 0xFFFF;
+	__m128i result;
+
+	if (fraction > 0x7FFF)
+		result = _mm_mulhi_epi16(_mm_slli_epi16(value, 1), _mm_set1_epi16(fraction >> 1));
+	else
+		result = _mm_mulhi_epi16(value, _mm_set1_epi16(fraction));
+
+	if (factor >> 16)
+		result = _mm_add_epi16(result, value);
+
+	return _mm_add_epi16(result, _mm_srli_epi16(value, 15));
+}
+
+SCUMMVM_TARGET_SSE2
+static inline __m128i clampChannelSSE2(__m128i value, const YUVPixelPacking &packing) {
+	value = _mm_max_epi16(value, _mm_set1_epi16(packing.minValue));
+	value = _mm_min_epi16(value, _mm_set1_epi16(packing.maxValue));
+
+	if (packing.scaleITU)
+		value = _mm_mulhi_epu16(_mm_slli_epi16(_mm_sub_epi16(value, _mm_set1_epi16(16)), 1), _mm_set1_epi16((int16)kITUFactor));
+
+	return value;
+}
+
+/**
+ * Convert eight pixels, given the luminance and the chroma offsets of each
+ * pixel in 16 bit lanes.
+ */
+template<typename PixelInt>
+SCUMMVM_TARGET_SSE2
+static inline void convertPixelsSSE2(byte *dst, __m128i y, __m128i crR, __m128i crbG, __m128i cbB, const YUVPixelPacking &packing) {
+	__m128i r = _mm_srl_epi16(clampChannelSSE2(_mm_add_epi16(y, crR), packing), _mm_cvtsi32_si128(packing.rLoss));
+	__m128i g = _mm_srl_epi16(clampChannelSSE2(_mm_sub_epi16(y, crbG), packing), _mm_cvtsi32_si128(packing.gLoss));
+	__m128i b = _mm_srl_epi16(clampChannelSSE2(_mm_add_epi16(y, cbB), packing), _mm_cvtsi32_si128(packing.bLoss));
+
+	const __m128i rShift = _mm_cvtsi32_si128(packing.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(packing.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(packing.bShift);
+
+	if (sizeof(PixelInt) == 2) {
+		__m128i pixels = _mm_set1_epi16((int16)packing.alpha);
+		pixels = _mm_or_si128(pixels, _mm_sll_epi16(r, rShift));
+		pixels = _mm_or_si128(pixels, _mm_sll_epi16(g, gShift));
+		pixels = _mm_or_si128(pixels, _mm_sll_epi16(b, bShift));
+		_mm_storeu_si128((__m128i *)dst, pixels);
+	} else {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i alpha = _mm_set1_epi32(packing.alpha);
+		__m128i pixels0 = _mm_or_si128(alpha, _mm_sll_epi32(_mm_unpacklo_epi16(r, zero), rShift));
+		__m128i pixels1 = _mm_or_si128(alpha, _mm_sll_epi32(_mm_unpackhi_epi16(r, zero), rShift));
+		pixels0 = _mm_or_si128(pixels0, _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), gShift));
+		pixels1 = _mm_or_si128(pixels1, _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), gShift));
+		pixels0 = _mm_or_si128(pixels0, _mm_sll_epi32(_mm_unpacklo_epi16(b, zero), bShift));
+		pixels1 = _mm_or_si128(pixels1, _mm_sll_epi32(_mm_unpackhi_epi16(b, zero), bShift));
+		_mm_storeu_si128((__m128i *)dst, pixels0);
+		_mm_storeu_si128((__m128i *)(dst + 16), pixels1);
+	}
+}
+
+template<typename PixelInt, bool halfChroma>
+SCUMMVM_TARGET_SSE2
+static int convertRowSSE2(byte *dst, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc, int width, const YUVPixelPacking &pixelPacking) {
+	// Work on a copy, so the compiler knows the stores don't modify it
+	const YUVPixelPacking packing = pixelPacking;
+	const __m128i zero = _mm_setzero_si128();
+	int x = 0;
+
+	for (; x + 8 <= width; x += 8) {
+		__m128i u, v;
+
+		if (halfChroma) {
+			u = _mm_unpacklo_epi8(_mm_cvtsi32_si128(READ_UINT32(uSrc + x / 2)), zero);
+			v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(READ_UINT32(vSrc + x / 2)), zero);
+			u = _mm_unpacklo_epi16(u, u);
+			v = _mm_unpacklo_epi16(v, v);
+		} else {
+			u = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(uSrc + x)), zero);
+			v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(vSrc + x)), zero);
+		}
+
+		u = _mm_sub_epi16(u, _mm_set1_epi16(128));
+		v = _mm_sub_epi16(v, _mm_set1_epi16(128));
+
+		const __m128i crR = chromaOffsetSSE2(v, kCrRFactor);
+		const __m128i crbG = _mm_add_epi16(chromaOffsetSSE2(v, kCrGFactor), chromaOffsetSSE2(u, kCbGFactor));
+		const __m128i cbB = chromaOffsetSSE2(u, kCbBFactor);
+
+		const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(ySrc + x)), zero);
+		convertPixelsSSE2<PixelInt>(dst + x * sizeof(PixelInt), y, crR, crbG, cbB, packing);
+
+		if (halfChroma) {
+			const __m128i y1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(ySrc + yPitch + x)), zero);
+			convertPixelsSSE2<PixelInt>(dst + dstPitch + x * sizeof(PixelInt), y1, crR, crbG, cbB, packing);
+		}
+	}
+
+	return x;
+}
+
+#endif
+
+#ifdef USE_AVX2_YUV
+
+SCUMMVM_TARGET_AVX2
+static inline __m256i chromaOffsetAVX2(__m256i value, int factor) {
+	const int fraction = factor & 0xFFFF;
+	__m256i result;
+
+	if (fraction > 0x7FFF)
+		result = _mm256_mulhi_epi16(_mm256_slli_epi16(value, 1), _mm256_set1_epi16(fraction >> 1));
+	else
+		result = _mm256_mulhi_epi16(value, _mm256_set1_epi16(fraction));
+
+	if (factor >> 16)
+		result = _mm256_add_epi16(result, value);
+
+	return _mm256_add_epi16(result, _mm256_srli_epi16(value, 15));
+}
+
+SCUMMVM_TARGET_AVX2
+static inline __m256i clampChannelAVX2(__m256i value, const YUVPixelPacking &packing) {
+	value = _mm256_max_epi16(value, _mm256_set1_epi16(packing.minValue));
+	value = _mm256_min_epi16(value, _mm256_set1_epi16(packing.maxValue));
+
+	if (packing.scaleITU)
+		value = _mm256_mulhi_epu16(_mm256_slli_epi16(_mm256_sub_epi16(value, _mm256_set1_epi16(16)), 1), _mm256_set1_epi16((int16)kITUFactor));
+
+	return value;
+}
+
+template<typename PixelInt>
+SCUMMVM_TARGET_AVX2
+static inline void convertPixelsAVX2(byte *dst, __m256i y, __m256i crR, __m256i crbG, __m256i cbB, const YUVPixelPacking &packing) {
+	__m256i r = _mm256_srl_epi16(clampChannelAVX2(_mm256_add_epi16(y, crR), packing), _mm_cvtsi32_si128(packing.rLoss));
+	__m256i g = _mm256_srl_epi16(clampChannelAVX2(_mm256_sub_epi16(y, crbG), packing), _mm_cvtsi32_si128(packing.gLoss));
+	__m256i b = _mm256_srl_epi16(clampChannelAVX2(_mm256_add_epi16(y, cbB), packing), _mm_cvtsi32_si128(packing.bLoss));
+
+	const __m128i rShift = _mm_cvtsi32_si128(packing.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(packing.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(packing.bShift);
+
+	if (sizeof(PixelInt) == 2) {
+		__m256i pixels = _mm256_set1_epi16((int16)packing.alpha);
+		pixels = _mm256_or_si256(pixels, _mm256_sll_epi16(r, rShift));
+		pixels = _mm256_or_si256(pixels, _mm256_sll_epi16(g, gShift));
+		pixels = _mm256_or_si256(pixels, _mm256_sll_epi16(b, bShift));
+		_mm256_storeu_si256((__m256i *)dst, pixels);
+	} else {
+		// The unpacks work within 128 bit lanes, so pixels0 holds pixels
+		// 0-3 and 8-11, pixels1 holds 4-7 and 12-15
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i alpha = _mm256_set1_epi32(packing.alpha);
+		__m256i pixels0 = _mm256_or_si256(alpha, _mm256_sll_epi32(_mm256_unpacklo_epi16(r, zero), rShift));
+		__m256i pixels1 = _mm256_or_si256(alpha, _mm256_sll_epi32(_mm256_unpackhi_epi16(r, zero), rShift));
+		pixels0 = _mm256_or_si256(pixels0, _mm256_sll_epi32(_mm256_unpacklo_epi16(g, zero), gShift));
+		pixels1 = _mm256_or_si256(pixels1, _mm256_sll_epi32(_mm256_unpackhi_epi16(g, zero), gShift));
+		pixels0 = _mm256_or_si256(pixels0, _mm256_sll_epi32(_mm256_unpacklo_epi16(b, zero), bShift));
+		pixels1 = _mm256_or_si256(pixels1, _mm256_sll_epi32(_mm256_unpackhi_epi16(b, zero), bShift));
+		_mm256_storeu_si256((__m256i *)dst, _mm256_permute2x128_si256(pixels0, pixels1, 0x20));
+		_mm256_storeu_si256((__m256i *)(dst + 32), _mm256_permute2x128_si256(pixels0, pixels1, 0x31));
+	}
+}
+
+template<typename PixelInt, bool halfChroma>
+SCUMMVM_TARGET_AVX2
+static int convertRowAVX2(byte *dst, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc, int width, const YUVPixelPacking &pixelPacking) {
+	// Work on a copy, so the compiler knows the stores don't modify it
+	const YUVPixelPacking packing = pixelPacking;
+	int x = 0;
+
+	for (; x + 16 <= width; x += 16) {
+		__m256i u, v;
+
+		if (halfChroma) {
+			// Widen the eight chroma samples to 32 bit and copy each into
+			// the upper half as well
+			u = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(uSrc + x / 2)));
+			v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(vSrc + x / 2)));
+			u = _mm256_or_si256(u, _mm256_slli_epi32(u, 16));
+			v = _mm256_or_si256(v, _mm256_slli_epi32(v, 16));
+		} else {
+			u = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(uSrc + x)));
+			v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(vSrc + x)));
+		}
+
+		u = _mm256_sub_epi16(u, _mm256_set1_epi16(128));
+		v = _mm256_sub_epi16(v, _mm256_set1_epi16(128));
+
+		const __m256i crR = chromaOffsetAVX2(v, kCrRFactor);
+		const __m256i crbG = _mm256_add_epi16(chromaOffsetAVX2(v, kCrGFactor), chromaOffsetAVX2(u, kCbGFactor));
+		const __m256i cbB = chromaOffsetAVX2(u, kCbBFactor);
+
+		const __m256i y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(ySrc + x)));
+		convertPixelsAVX2<PixelInt>(dst + x * sizeof(PixelInt), y, crR, crbG, cbB, packing);
+
+		if (halfChroma) {
+			const __m256i y1 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(ySrc + yPitch + x)));
+			convertPixelsAVX2<PixelInt>(dst + dstPitch + x * sizeof(PixelInt), y1, crR, crbG, cbB, packing);
+		}
+	}
+
+	return x;
+}
+
+#endif
+
+#ifdef USE_NEON_YUV
+
+static inline uint16x8_t mulFactorNEON(uint16x8_t value, int factor) {
+	const uint16x4_t factorLow = vdup_n_u16(factor & 0xFFFF);
+	uint16x8_t result = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(value), factorLow), 16),
+	                                 vshrn_n_u32(vmull_u16(vget_high_u16(value), factorLow), 16));
+	if (factor >> 16)
+		result = vaddq_u16(result, value);
+	return result;
+}
+
+static inline int16x8_t chromaOffsetNEON(uint16x8_t chroma, int factor) {
+	const int16x8_t value = vsubq_s16(vreinterpretq_s16_u16(chroma), vdupq_n_s16(128));
+	const int16x8_t magnitude = vreinterpretq_s16_u16(mulFactorNEON(vreinterpretq_u16_s16(vabsq_s16(value)), factor));
+	return vbslq_s16(vcltq_s16(value, vdupq_n_s16(0)), vnegq_s16(magnitude), magnitude);
+}
+
+static inline uint16x8_t clampChannelNEON(int16x8_t value, const YUVPixelPacking &packing) {
+	value = vmaxq_s16(value, vdupq_n_s16(packing.minValue));
+	value = vminq_s16(value, vdupq_n_s16(packing.maxValue));
+
+	uint16x8_t result = vreinterpretq_u16_s16(value);
+
+	if (packing.scaleITU) {
+		result = mulFactorNEON(vshlq_n_u16(vsubq_u16(result, vdupq_n_u16(16)), 1), kITUFactor);
+	}
+
+	return result;
+}
+
+struct ChromaOffsetsNEON {
+	int16x8_t crR, crbG, cbB;
+};
+
+static inline ChromaOffsetsNEON chromaOffsetsNEON(uint8x8_t uIn, uint8x8_t vIn) {
+	const uint16x8_t u = vmovl_u8(uIn);
+	const uint16x8_t v = vmovl_u8(vIn);
+
+	ChromaOffsetsNEON offsets;
+	offsets.crR = chromaOffsetNEON(v, kCrRFactor);
+	offsets.crbG = vaddq_s16(chromaOffsetNEON(v, kCrGFactor), chromaOffsetNEON(u, kCbGFactor));
+	offsets.cbB = chromaOffsetNEON(u, kCbBFactor);
+	return offsets;
+}
+
+template<typename PixelInt>
+static inline void convertPixelsNEON(byte *dst, uint8x8_t yIn, const ChromaOffsetsNEON &offsets, const YUVPixelPacking &packing) {
+	const int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(yIn));
+	const int16x8_t crR = offsets.crR;
+	const int16x8_t crbG = offsets.crbG;
+	const int16x8_t cbB = offsets.cbB;
+
+	const uint16x8_t r = vshlq_u16(clampChannelNEON(vaddq_s16(y, crR), packing), vdupq_n_s16(-packing.rLoss));
+	const uint16x8_t g = vshlq_u16(clampChannelNEON(vsubq_s16(y, crbG), packing), vdupq_n_s16(-packing.gLoss));
+	const uint16x8_t b = vshlq_u16(clampChannelNEON(vaddq_s16(y, cbB), packing), vdupq_n_s16(-packing.bLoss));
+
+	if (sizeof(PixelInt) == 2) {
+		uint16x8_t pixels = vdupq_n_u16(packing.alpha);
+		pixels = vorrq_u16(pixels, vshlq_u16(r, vdupq_n_s16(packing.rShift)));
+		pixels = vorrq_u16(pixels, vshlq_u16(g, vdupq_n_s16(packing.gShift)));
+		pixels = vorrq_u16(pixels, vshlq_u16(b, vdupq_n_s16(packing.bShift)));
+		vst1q_u16((uint16 *)dst, pixels);
+	} else {
+		const uint32x4_t alpha = vdupq_n_u32(packing.alpha);
+		uint32x4_t pixels0 = vorrq_u32(alpha, vshlq_u32(vmovl_u16(vget_low_u16(r)), vdupq_n_s32(packing.rShift)));
+		uint32x4_t pixels1 = vorrq_u32(alpha, vshlq_u32(vmovl_u16(vget_high_u16(r)), vdupq_n_s32(packing.rShift)));
+		pixels0 = vorrq_u32(pixels0, vshlq_u32(vmovl_u16(vget_low_u16(g)), vdupq_n_s32(packing.gShift)));
+		pixels1 = vorrq_u32(pixels1, vshlq_u32(vmovl_u16(vget_high_u16(g)), vdupq_n_s32(packing.gShift)));
+		pixels0 = vorrq_u32(pixels0, vshlq_u32(vmovl_u16(vget_low_u16(b)), vdupq_n_s32(packing.bShift)));
+		pixels1 = vorrq_u32(pixels1, vshlq_u32(vmovl_u16(vget_high_u16(b)), vdupq_n_s32(packing.bShift)));
+		vst1q_u32((uint32 *)dst, pixels0);
+		vst1q_u32((uint32 *)dst + 4, pixels1);
+	}
+}
+
+template<typename PixelInt, bool halfChroma>
+static int convertRowNEON(byte *dst, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc, int width, const YUVPixelPacking &pixelPacking) {
+	// Work on a copy, so the compiler knows the stores don't modify it
+	const YUVPixelPacking packing = pixelPacking;
+	int x = 0;
+
+	for (; x + 16 <= width; x += 16) {
+		uint8x8_t u0, u1, v0, v1;
+
+		if (halfChroma) {
+			const uint8x8x2_t u = vzip_u8(vld1_u8(uSrc + x / 2), vld1_u8(uSrc + x / 2));
+			const uint8x8x2_t v = vzip_u8(vld1_u8(vSrc + x / 2), vld1_u8(vSrc + x / 2));
+			u0 = u.val[0];
+			u1 = u.val[1];
+			v0 = v.val[0];
+			v1 = v.val[1];
+		} else {
+			u0 = vld1_u8(uSrc + x);
+			u1 = vld1_u8(uSrc + x + 8);
+			v0 = vld1_u8(vSrc + x);
+			v1 = vld1_u8(vSrc + x + 8);
+		}
+
+		const ChromaOffsetsNEON offsets0 = chromaOffsetsNEON(u0, v0);
+		const ChromaOffsetsNEON offsets1 = chromaOffsetsNEON(u1, v1);
+
+		const uint8x16_t y = vld1q_u8(ySrc + x);
+		convertPixelsNEON<PixelInt>(dst + x * sizeof(PixelInt), vget_low_u8(y), offsets0, packing);
+		convertPixelsNEON<PixelInt>(dst + (x + 8) * sizeof(PixelInt), vget_high_u8(y), offsets1, packing);
+
+		if (halfChroma) {
+			const uint8x16_t y1 = vld1q_u8(ySrc + yPitch + x);
+			convertPixelsNEON<PixelInt>(dst + dstPitch + x * sizeof(PixelInt), vget_low_u8(y1), offsets0, packing);
+			convertPixelsNEON<PixelInt>(dst + dstPitch + (x + 8) * sizeof(PixelInt), vget_high_u8(y1), offsets1, packing);
+		}
+	}
+
+	return x;
+}
+
+#endif
+
+#ifdef USE_SIMD_YUV
+
+/**
+ * Select the fastest row conversion the CPU supports, or return 0 if
+ * there is none.
+ */
+static YUVConvertRowProc getYUVConvertRowProc(int bytesPerPixel, bool halfChroma) {
+#ifdef USE_AVX2_YUV
+	if (Common::hasCpuFeature(Common::kCpuFeatureAVX2)) {
+		if (bytesPerPixel == 2)
+			return halfChroma ? convertRowAVX2<uint16, true> : convertRowAVX2<uint16, false>;
+		return halfChroma ? convertRowAVX2<uint32, true> : convertRowAVX2<uint32, false>;
+	}
+#endif
+#ifdef USE_SSE2_YUV
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2)) {
+		if (bytesPerPixel == 2)
+			return halfChroma ? convertRowSSE2<uint16, true> : convertRowSSE2<uint16, false>;
+		return halfChroma ? convertRowSSE2<uint32, true> : convertRowSSE2<uint32, false>;
+	}
+#endif
+#ifdef USE_NEON_YUV
+	if (Common::hasCpuFeature(Common::kCpuFeatureNEON)) {
+		if (bytesPerPixel == 2)
+			return halfChroma ? convertRowNEON<uint16, true> : convertRowNEON<uint16, false>;
+		return halfChroma ? convertRowNEON<uint32, true> : convertRowNEON<uint32, false>;
+	}
+#endif
+	return 0;
+}
+
+#endif
+
 #define PUT_PIXEL(s, d) \
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
@@ -227,6 +666,143 @@ void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	}
 }
 
+#ifdef USE_SIMD_YUV
+
+/**
+ * Convert count pixels using the lookup tables. This handles what is left
+ * of a row after the vectorized conversion.
+ */
+template<typename PixelInt>
+static void convertYUVPixelsToRGB(byte *dstPtr, const YUVToRGBLookup *lookup, const int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int count, int chromaShift) {
+	const int16 *Cr_r_tab = colorTab;
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+	const uint32 *rgbToPix = lookup->getRGBToPix();
+
+	for (int x = 0; x < count; x++) {
+		const uint32 *L;
+
+		const byte u = uSrc[x >> chromaShift];
+		const byte v = vSrc[x >> chromaShift];
+		int16 cr_r  = Cr_r_tab[v];
+		int16 crb_g = Cr_g_tab[v] + Cb_g_tab[u];
+		int16 cb_b  = Cb_b_tab[u];
+
+		PUT_PIXEL(ySrc[x], dstPtr);
+		dstPtr += sizeof(PixelInt);
+	}
+}
+
+template<typename PixelInt>
+static void convertYUV444ToRGBRows(YUVConvertRowProc convertRow, const YUVPixelPacking &packing, byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	for (int h = 0; h < yHeight; h++) {
+		const int done = convertRow(dstPtr, dstPitch, ySrc, yPitch, uSrc, vSrc, yWidth, packing);
+		convertYUVPixelsToRGB<PixelInt>(dstPtr + done * sizeof(PixelInt), lookup, colorTab, ySrc + done, uSrc + done, vSrc + done, yWidth - done, 0);
+
+		dstPtr += dstPitch;
+		ySrc += yPitch;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+}
+
+template<typename PixelInt>
+static void convertYUV420ToRGBRows(YUVConvertRowProc convertRow, const YUVPixelPacking &packing, byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	for (int h = 0; h < yHeight; h += 2) {
+		// The vectorized code always converts an even number of pixels
+		const int done = convertRow(dstPtr, dstPitch, ySrc, yPitch, uSrc, vSrc, yWidth, packing);
+		convertYUVPixelsToRGB<PixelInt>(dstPtr + done * sizeof(PixelInt), lookup, colorTab, ySrc + done, uSrc + done / 2, vSrc + done / 2, yWidth - done, 1);
+		convertYUVPixelsToRGB<PixelInt>(dstPtr + dstPitch + done * sizeof(PixelInt), lookup, colorTab, ySrc + yPitch + done, uSrc + done / 2, vSrc + done / 2, yWidth - done, 1);
+
+		dstPtr += dstPitch * 2;
+		ySrc += yPitch * 2;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+}
+
+/**
+ * Interpolate the chroma values of one row of a 4:1:0 image, like
+ * convertYUV410ToRGB() does.
+ */
+static void interpolateYUV410Row(byte *dst, const byte *src, int quarterWidth, int yDiff, int uvPitch) {
+	for (int x = 0; x < quarterWidth; x++) {
+		const int a = src[x], b = src[x + 1], c = src[x + uvPitch], d = src[x + uvPitch + 1];
+
+		for (int xDiff = 0; xDiff < 4; xDiff++)
+			*dst++ = (a * (4 - xDiff) * (4 - yDiff) + b * xDiff * (4 - yDiff) + c * yDiff * (4 - xDiff) + d * xDiff * yDiff) >> 4;
+	}
+}
+
+#ifdef USE_SSE2_YUV
+
+SCUMMVM_TARGET_SSE2
+static void interpolateYUV410RowSSE2(byte *dst, const byte *src, int quarterWidth, int yDiff, int uvPitch) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i xDiff = _mm_setr_epi16(0, 1, 2, 3, 0, 1, 2, 3);
+	const __m128i weightA = _mm_mullo_epi16(_mm_sub_epi16(_mm_set1_epi16(4), xDiff), _mm_set1_epi16(4 - yDiff));
+	const __m128i weightB = _mm_mullo_epi16(xDiff, _mm_set1_epi16(4 - yDiff));
+	const __m128i weightC = _mm_mullo_epi16(_mm_sub_epi16(_mm_set1_epi16(4), xDiff), _mm_set1_epi16(yDiff));
+	const __m128i weightD = _mm_mullo_epi16(xDiff, _mm_set1_epi16(yDiff));
+
+	// Two chroma samples per iteration, reading no further than the scalar
+	// code does for the last sample of the row
+	int x = 0;
+	for (; x + 4 <= quarterWidth; x += 2) {
+		const __m128i row0 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(READ_UINT32(src + x)), zero);
+		const __m128i row1 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(READ_UINT32(src + x + uvPitch)), zero);
+
+		// Repeat samples x and x + 1 (or x + 1 and x + 2) four times each
+		__m128i a = _mm_unpacklo_epi16(row0, row0);
+		__m128i b = _mm_srli_si128(a, 4);
+		__m128i c = _mm_unpacklo_epi16(row1, row1);
+		__m128i d = _mm_srli_si128(c, 4);
+		a = _mm_unpacklo_epi32(a, a);
+		b = _mm_unpacklo_epi32(b, b);
+		c = _mm_unpacklo_epi32(c, c);
+		d = _mm_unpacklo_epi32(d, d);
+
+		__m128i sum = _mm_mullo_epi16(a, weightA);
+		sum = _mm_add_epi16(sum, _mm_mullo_epi16(b, weightB));
+		sum = _mm_add_epi16(sum, _mm_mullo_epi16(c, weightC));
+		sum = _mm_add_epi16(sum, _mm_mullo_epi16(d, weightD));
+		_mm_storel_epi64((__m128i *)(dst + x * 4), _mm_packus_epi16(_mm_srli_epi16(sum, 4), zero));
+	}
+
+	interpolateYUV410Row(dst + x * 4, src + x, quarterWidth - x, yDiff, uvPitch);
+}
+
+#endif
+
+template<typename PixelInt>
+static void convertYUV410ToRGBRows(YUVConvertRowProc convertRow, const YUVPixelPacking &packing, byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	void (*interpolateRow)(byte *, const byte *, int, int, int) = interpolateYUV410Row;
+#ifdef USE_SSE2_YUV
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2))
+		interpolateRow = interpolateYUV410RowSSE2;
+#endif
+
+	// Interpolate the chroma of each row first, the rest then works like 4:4:4
+	byte *uRow = new byte[yWidth * 2];
+	byte *vRow = uRow + yWidth;
+
+	for (int h = 0; h < yHeight; h++) {
+		interpolateRow(uRow, uSrc + (h >> 2) * uvPitch, yWidth >> 2, h & 3, uvPitch);
+		interpolateRow(vRow, vSrc + (h >> 2) * uvPitch, yWidth >> 2, h & 3, uvPitch);
+
+		const int done = convertRow(dstPtr, dstPitch, ySrc, yPitch, uRow, vRow, yWidth, packing);
+		convertYUVPixelsToRGB<PixelInt>(dstPtr + done * sizeof(PixelInt), lookup, colorTab, ySrc + done, uRow + done, vRow + done, yWidth - done, 0);
+
+		dstPtr += dstPitch;
+		ySrc += yPitch;
+	}
+
+	delete[] uRow;
+}
+
+#endif
+
 void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
@@ -235,6 +811,21 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+#ifdef USE_SIMD_YUV
+	YUVConvertRowProc convertRow = getYUVConvertRowProc(dst->format.bytesPerPixel, false);
+
+	if (convertRow) {
+		YUVPixelPacking packing(dst->format, scale);
+
+		if (dst->format.bytesPerPixel == 2)
+			convertYUV444ToRGBRows<uint16>(convertRow, packing, (byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV444ToRGBRows<uint32>(convertRow, packing, (byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+
+		return;
+	}
+#endif
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -291,6 +882,21 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+#ifdef USE_SIMD_YUV
+	YUVConvertRowProc convertRow = getYUVConvertRowProc(dst->format.bytesPerPixel, true);
+
+	if (convertRow) {
+		YUVPixelPacking packing(dst->format, scale);
+
+		if (dst->format.bytesPerPixel == 2)
+			convertYUV420ToRGBRows<uint16>(convertRow, packing, (byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV420ToRGBRows<uint32>(convertRow, packing, (byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+
+		return;
+	}
+#endif
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -376,6 +982,21 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+#ifdef USE_SIMD_YUV
+	YUVConvertRowProc convertRow = getYUVConvertRowProc(dst->format.bytesPerPixel, false);
+
+	if (convertRow) {
+		YUVPixelPacking packing(dst->format, scale);
+
+		if (dst->format.bytesPerPixel == 2)
+			convertYUV410ToRGBRows<uint16>(convertRow, packing, (byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV410ToRGBRows<uint32>(convertRow, packing, (byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+
+		return;
+	}
+#endif
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
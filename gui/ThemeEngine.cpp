@@ -84,6 +84,11 @@ struct WidgetDrawData {
 
 	bool _buffer;
 
+	/** Whether the drawing of this item can be pre-rendered, see calcCachable(). */
+	bool _cachable;
+
+	/** Renderer colors which are not set by the first draw step, indexed like VectorRenderer::getColorState(). */
+	bool _inheritedColors[Graphics::VectorRenderer::kColorStateSize];
 
 	/**
 	 * Calculates the background threshold offset of a given DrawData item.
@@ -93,6 +98,28 @@ struct WidgetDrawData {
 	 * value will be added when restoring the background of the widget.
 	 */
 	void calcBackgroundOffset();
+
+	/**
+	 * Checks whether the drawing of a given DrawData item can be reused at
+	 * another position. This is the case when all draw steps are sized and
+	 * positioned automatically, since they then only draw inside the area
+	 * given by the background offset.
+	 */
+	void calcCachable();
+};
+
+/** A DrawData item pre-rendered by ThemeEngine::drawDrawData(). */
+struct ThemeEngine::CachedDrawData {
+	const WidgetDrawData *data;
+	uint32 dynamicData;
+	int width, height; ///< Size of the widget area.
+	bool shadows;      ///< Whether shadows were enabled.
+
+	/** Renderer colors before drawing the item. */
+	uint32 colors[Graphics::VectorRenderer::kColorStateSize];
+
+	Graphics::Surface background; ///< The extended area before drawing the item.
+	Graphics::Surface result;     ///< The extended area after drawing the item.
 };
 
 class ThemeItem {
@@ -233,11 +260,8 @@ void ThemeItemDrawData::drawSelf(bool draw, bool restore) {
 	if (restore)
 		_engine->restoreBackground(extendedRect);
 
-	if (draw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = _data->_steps.begin(); step != _data->_steps.end(); ++step)
-			_engine->renderer()->drawStep(_area, *step, _dynamicData);
-	}
+	if (draw)
+		_engine->drawDrawData(_data, _area, extendedRect, _dynamicData);
 
 	_engine->addDirtyRect(extendedRect);
 }
@@ -277,7 +301,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(0), _vectorRenderer(0),
 	_buffering(false), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
 	_font(0), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
-	_cursor(0) {
+	_cursor(0), _drawDataCacheUsed(0) {
 
 	_system = g_system;
 	_parser = new ThemeParser(this);
@@ -316,6 +340,8 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 }
 
 ThemeEngine::~ThemeEngine() {
+	clearDrawDataCache();
+
 	delete _vectorRenderer;
 	_vectorRenderer = 0;
 	_screen.free();
@@ -520,6 +546,9 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_screen.free();
 	_screen.create(width, height, _overlayFormat);
 
+	// The pre-rendered items depend on the renderer and the pixel format
+	clearDrawDataCache();
+
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
@@ -545,11 +574,136 @@ void WidgetDrawData::calcBackgroundOffset() {
 	_backgroundOffset = maxShadow;
 }
 
+void WidgetDrawData::calcCachable() {
+	_cachable = !_steps.empty();
+	for (Common::List<Graphics::DrawStep>::const_iterator step = _steps.begin();
+	        step != _steps.end(); ++step) {
+		const Common::Rect &padding = step->padding;
+		if (!step->autoWidth || !step->autoHeight || padding.left || padding.top || padding.right || padding.bottom)
+			_cachable = false;
+	}
+
+	if (!_cachable)
+		return;
+
+	// Draw steps keep the colors of earlier steps, so only the colors the
+	// first step does not set can depend on what was drawn before.
+	const Graphics::DrawStep &first = _steps.front();
+	_inheritedColors[0] = !first.fgColor.set;
+	_inheritedColors[1] = !first.bgColor.set;
+	_inheritedColors[2] = !first.bevelColor.set;
+	_inheritedColors[3] = _inheritedColors[4] = !(first.gradColor1.set && first.gradColor2.set);
+}
+
 void ThemeEngine::restoreBackground(Common::Rect r) {
 	r.clip(_screen.w, _screen.h);
 	_vectorRenderer->blitSurface(&_backBuffer, r);
 }
 
+namespace {
+
+bool isSameArea(const Graphics::Surface &cached, const Graphics::Surface &surface, const Common::Rect &r) {
+	const int lineSize = r.width() * surface.format.bytesPerPixel;
+
+	for (int y = 0; y < r.height(); ++y) {
+		if (memcmp(cached.getBasePtr(0, y), surface.getBasePtr(r.left, r.top + y), lineSize))
+			return false;
+	}
+
+	return true;
+}
+
+} // End of anonymous namespace
+
+void ThemeEngine::drawDrawData(const WidgetDrawData *data, const Common::Rect &area, const Common::Rect &extendedArea, uint32 dynamicData) {
+	Common::List<Graphics::DrawStep>::const_iterator step;
+	Graphics::Surface *surface = _vectorRenderer->getActiveSurface();
+
+	const uint32 itemSize = 2 * extendedArea.width() * extendedArea.height() * _bytesPerPixel;
+
+	if (!data->_cachable || !surface || itemSize > kDrawDataCacheItemSize
+	    || !Common::Rect(surface->w, surface->h).contains(extendedArea)) {
+		for (step = data->_steps.begin(); step != data->_steps.end(); ++step)
+			_vectorRenderer->drawStep(area, *step, dynamicData);
+		return;
+	}
+
+	uint32 colors[Graphics::VectorRenderer::kColorStateSize];
+	_vectorRenderer->getColorState(colors);
+
+	const bool shadows = !_vectorRenderer->areShadowsDisabled();
+
+	// Look for a rendering of the same item onto the same background
+	for (Common::List<CachedDrawData *>::iterator i = _drawDataCache.begin(); i != _drawDataCache.end(); ++i) {
+		CachedDrawData *item = *i;
+
+		if (item->data != data || item->dynamicData != dynamicData || item->shadows != shadows
+		    || item->width != area.width() || item->height != area.height()
+		    || item->background.format != surface->format)
+			continue;
+
+		bool sameColors = true;
+		for (int c = 0; c < Graphics::VectorRenderer::kColorStateSize; ++c) {
+			if (data->_inheritedColors[c] && item->colors[c] != colors[c])
+				sameColors = false;
+		}
+
+		if (!sameColors || !isSameArea(item->background, *surface, extendedArea))
+			continue;
+
+		surface->copyRectToSurface(item->result, extendedArea.left, extendedArea.top, Common::Rect(item->result.w, item->result.h));
+
+		// Leave the renderer in the same state as drawing the item would
+		for (step = data->_steps.begin(); step != data->_steps.end(); ++step)
+			_vectorRenderer->setStepState(*step, dynamicData);
+
+		_drawDataCache.erase(i);
+		_drawDataCache.push_front(item);
+		return;
+	}
+
+	CachedDrawData *item = new CachedDrawData;
+	item->data = data;
+	item->dynamicData = dynamicData;
+	item->width = area.width();
+	item->height = area.height();
+	item->shadows = shadows;
+	memcpy(item->colors, colors, sizeof(colors));
+
+	item->background.create(extendedArea.width(), extendedArea.height(), surface->format);
+	item->background.copyRectToSurface(*surface, 0, 0, extendedArea);
+
+	for (step = data->_steps.begin(); step != data->_steps.end(); ++step)
+		_vectorRenderer->drawStep(area, *step, dynamicData);
+
+	item->result.create(extendedArea.width(), extendedArea.height(), surface->format);
+	item->result.copyRectToSurface(*surface, 0, 0, extendedArea);
+
+	_drawDataCache.push_front(item);
+	_drawDataCacheUsed += itemSize;
+
+	// Drop the least recently used items
+	while (_drawDataCacheUsed > kDrawDataCacheSize) {
+		CachedDrawData *last = _drawDataCache.back();
+		_drawDataCacheUsed -= 2 * last->result.w * last->result.h * last->result.format.bytesPerPixel;
+		last->background.free();
+		last->result.free();
+		delete last;
+		_drawDataCache.pop_back();
+	}
+}
+
+void ThemeEngine::clearDrawDataCache() {
+	for (Common::List<CachedDrawData *>::iterator i = _drawDataCache.begin(); i != _drawDataCache.end(); ++i) {
+		(*i)->background.free();
+		(*i)->result.free();
+		delete *i;
+	}
+
+	_drawDataCache.clear();
+	_drawDataCacheUsed = 0;
+}
+
 
 
 /**********************************************************
@@ -705,6 +859,7 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 			warning("Missing data asset: '%s'", kDrawDataDefaults[i].name);
 		} else {
 			_widgets[i]->calcBackgroundOffset();
+			_widgets[i]->calcCachable();
 		}
 	}
 }
@@ -713,6 +868,8 @@ void ThemeEngine::unloadTheme() {
 	if (!_themeOk)
 		return;
 
+	clearDrawDataCache();
+
 	for (int i = 0; i < kDrawDataMAX; ++i) {
 		delete _widgets[i];
 		_widgets[i] = 0;
@@ -1581,12 +1738,15 @@ bool ThemeEngine::themeConfigUsable(const Common::ArchiveMember &member, Common:
 			stream.open("THEMERC", *zipArchive);
 		}
 
-		delete zipArchive;
-	}
+		// Archive members read from the ZIP file directly, so we have to
+		// parse the header before the archive is deleted.
+		if (stream.isOpen()) {
+			Common::String stxHeader = stream.readLine();
+			foundHeader = themeConfigParseHeader(stxHeader, themeName);
+			stream.close();
+		}
 
-	if (stream.isOpen()) {
-		Common::String stxHeader = stream.readLine();
-		foundHeader = themeConfigParseHeader(stxHeader, themeName);
+		delete zipArchive;
 	}
 
 	return foundHeader;
@@ -1602,12 +1762,13 @@ bool ThemeEngine::themeConfigUsable(const Common::FSNode &node, Common::String &
 			// Open THEMERC from the ZIP file.
 			stream.open("THEMERC", *zipArchive);
 		}
-		// Delete the ZIP archive again. Note: This only works because
-		// stream.open() only uses ZipArchive::createReadStreamForMember,
-		// and that in turn happens to read all the data for a given
-		// archive member into a memory block. So there will be no dangling
-		// reference to zipArchive anywhere. This could change if we
-		// ever modify ZipArchive::createReadStreamForMember.
+		// Archive members read from the ZIP file directly, so we have to
+		// parse the header before the archive is deleted again.
+		if (stream.isOpen()) {
+			Common::String stxHeader = stream.readLine();
+			foundHeader = themeConfigParseHeader(stxHeader, themeName);
+			stream.close();
+		}
 		delete zipArchive;
 	} else if (node.isDirectory()) {
 		Common::FSNode headerfile = node.getChild("THEMERC");
@@ -523,6 +523,19 @@ public:
 	 */
 	void restoreBackground(Common::Rect r);
 
+	/**
+	 * Draws all the steps of a DrawData item. When the same item was drawn
+	 * before with the same size, state and background, the pre-rendered
+	 * result is copied instead.
+	 *
+	 * @param data DrawData item to draw.
+	 * @param area Area of the widget.
+	 * @param extendedArea Area which is touched when drawing the item,
+	 *                     including shadows and bevels.
+	 * @param dynamicData Dynamic data passed to the draw steps.
+	 */
+	void drawDrawData(const WidgetDrawData *data, const Common::Rect &area, const Common::Rect &extendedArea, uint32 dynamicData);
+
 	const Common::String &getThemeName() const { return _themeName; }
 	const Common::String &getThemeId() const { return _themeId; }
 	int getGraphicsMode() const { return _graphicsMode; }
@@ -572,6 +585,11 @@ protected:
 	 */
 	void renderDirtyScreen();
 
+	/**
+	 * Removes all pre-rendered DrawData items.
+	 */
+	void clearDrawDataCache();
+
 	/**
 	 * Generates a DrawQueue item and enqueues it so it's drawn to the screen
 	 * when the drawing queue is processed.
@@ -673,6 +691,21 @@ protected:
 	/** Queue with all the drawing that must be done to the screen */
 	Common::List<ThemeItem *> _screenQueue;
 
+	enum {
+		/** Maximum memory used by the pre-rendered DrawData items, in bytes. */
+		kDrawDataCacheSize = 1024 * 1024,
+		/** Maximum memory used by a single pre-rendered DrawData item, in bytes. */
+		kDrawDataCacheItemSize = kDrawDataCacheSize / 8
+	};
+
+	struct CachedDrawData;
+
+	/** Pre-rendered DrawData items, most recently used first. */
+	Common::List<CachedDrawData *> _drawDataCache;
+
+	/** Memory used by the pre-rendered DrawData items, in bytes. */
+	uint32 _drawDataCacheUsed;
+
 	bool _initOk;  ///< Class and renderer properly initialized
 	bool _themeOk; ///< Theme data successfully loaded.
 	bool _enabled; ///< Whether the Theme is currently shown on the overlay
@@ -26,6 +26,7 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/system.h"
+#include "common/timer.h"
 
 #ifndef DISABLE_MD5
 #include "common/md5.h"
@@ -77,6 +78,8 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+
+	registerCmd("timers",			WRAP_METHOD(Debugger, cmdTimers));
 }
 
 Debugger::~Debugger() {
@@ -681,6 +684,36 @@ bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdTimers(int argc, const char **argv) {
+	Common::TimerManager *timerManager = g_system->getTimerManager();
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			timerManager->resetTimerStats();
+			debugPrintf("Timer statistics reset\n");
+		} else {
+			debugPrintf("timers [reset]\n");
+		}
+		return true;
+	}
+
+	Common::TimerManager::TimerStatsList stats;
+	timerManager->getTimerStats(stats);
+	if (stats.empty()) {
+		debugPrintf("No timer statistics available\n");
+		return true;
+	}
+
+	// Durations are in milliseconds, interval and lateness in microseconds
+	debugPrintf("%-24s %8s %8s %8s %8s %8s %8s %8s\n", "id", "interval", "calls", "total", "max", "avg late", "max late", "overruns");
+	for (Common::TimerManager::TimerStatsList::const_iterator i = stats.begin(); i != stats.end(); ++i) {
+		debugPrintf("%-24s %8d %8u %8u %8u %8u %8u %8u\n", i->id.c_str(), i->interval, i->calls,
+		            i->totalDuration, i->maxDuration, i->calls ? i->totalLateness / i->calls : 0,
+		            i->maxLateness, i->overruns);
+	}
+	return true;
+}
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
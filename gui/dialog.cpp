@@ -167,6 +167,13 @@ void Dialog::drawDialog() {
 	}
 }
 
+void Dialog::drawDirtyWidgets() {
+	if (!isVisible())
+		return;
+
+	Widget::drawDirtyWidgetsInChain(_firstWidget);
+}
+
 void Dialog::handleMouseDown(int x, int y, int button, int clickCount) {
 	Widget *w;
 
@@ -90,6 +90,7 @@ protected:
 
 	virtual void draw();
 	virtual void drawDialog();
+	void drawDirtyWidgets();
 
 	virtual void handleTickle(); // Called periodically (in every guiloop() )
 	virtual void handleMouseDown(int x, int y, int button, int clickCount);
@@ -206,8 +206,14 @@ bool GuiManager::loadNewTheme(Common::String id, ThemeEngine::GraphicsMode gfx,
 void GuiManager::redraw() {
 	ThemeEngine::ShadingStyle shading;
 
-	if (_redrawStatus == kRedrawDisabled || _dialogStack.empty())
+	if (_dialogStack.empty())
+		return;
+
+	// Only the widgets which changed since the last frame need to be drawn
+	if (_redrawStatus == kRedrawDisabled) {
+		_dialogStack.top()->drawDirtyWidgets();
 		return;
+	}
 
 	shading = (ThemeEngine::ShadingStyle)xmlEval()->getVar("Dialog." + _dialogStack.top()->_name + ".Shading", 0);
 
@@ -302,6 +308,7 @@ void GuiManager::runLoop() {
 //		_system->updateScreen();
 
 		if (lastRedraw + waitTime < _system->getMillis(true)) {
+			redraw();
 			_theme->updateScreen();
 			_system->updateScreen();
 			lastRedraw = _system->getMillis(true);
@@ -340,6 +347,7 @@ void GuiManager::runLoop() {
 
 
 			if (lastRedraw + waitTime < _system->getMillis(true)) {
+				redraw();
 				_theme->updateScreen();
 				_system->updateScreen();
 				lastRedraw = _system->getMillis(true);
@@ -30,6 +30,8 @@
 #include "common/system.h"
 #include "common/translation.h"
 
+#include "engines/advancedDetector.h"
+
 #include "gui/about.h"
 #include "gui/browser.h"
 #include "gui/chooser.h"
@@ -846,6 +848,7 @@ void LauncherDialog::addGame() {
 			// ...so let's determine a list of candidates, games that
 			// could be contained in the specified directory.
 			GameList candidates(EngineMan.detectGames(files));
+			ADDetectionCacheMan.flush();
 
 			int idx;
 			if (candidates.empty()) {
@@ -20,6 +20,7 @@
  *
  */
 
+#include "engines/advancedDetector.h"
 #include "engines/metaengine.h"
 #include "common/algorithm.h"
 #include "common/config-manager.h"
@@ -164,7 +165,9 @@ void MassAddDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data
 		close();
 	} else if (cmd == kCancelCmd) {
 		// User cancelled, so we don't do anything and just leave.
+		// Keep the MD5s computed so far for the next scan, though.
 		_games.clear();
+		ADDetectionCacheMan.flush();
 		close();
 	} else {
 		Dialog::handleCommand(sender, cmd, data);
@@ -253,6 +256,9 @@ void MassAddDialog::handleTickle() {
 	Common::String buf;
 
 	if (_scanStack.empty()) {
+		// Remember the MD5s computed during the scan
+		ADDetectionCacheMan.flush();
+
 		// Enable the OK button
 		_okButton->setEnabled(true);
 
@@ -23,6 +23,10 @@
 #include "gui/saveload-dialog.h"
 #include "common/translation.h"
 #include "common/config-manager.h"
+#include "common/memstream.h"
+#include "common/savefile.h"
+#include "common/singleton.h"
+#include "common/system.h"
 
 #include "gui/message.h"
 #include "gui/gui-manager.h"
@@ -64,6 +68,86 @@ enum {
 };
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
 
+/**
+ * Keeps the meta infos of the save slots of the last used target. All infos
+ * are dropped when the savefile manager reports that a savefile changed, or
+ * when the target or its save path is different. Infos which are not in
+ * memory are looked up in the savefile manager's meta data index before the
+ * savefile itself is loaded.
+ */
+class SaveMetaInfoCache : public Common::Singleton<SaveMetaInfoCache> {
+public:
+	SaveMetaInfoCache() : _changeCounter(0) {}
+
+	SaveStateDescriptor query(const MetaEngine *metaEngine, const Common::String &target, int slot);
+
+private:
+	bool loadFromIndex(const Common::String &target, const Common::String &filename, int slot, SaveStateDescriptor &desc);
+	void storeInIndex(const Common::String &target, const Common::String &filename, const SaveStateDescriptor &desc);
+
+	enum {
+		/** Drop all infos when there are more, to bound the memory used by the thumbnails. */
+		kMaxEntries = 512
+	};
+
+	typedef Common::HashMap<int, SaveStateDescriptor> DescriptorMap;
+
+	Common::String _target;
+	Common::String _savePath;
+	uint32 _changeCounter;
+	DescriptorMap _descriptors;
+};
+
+SaveStateDescriptor SaveMetaInfoCache::query(const MetaEngine *metaEngine, const Common::String &target, int slot) {
+	const uint32 changeCounter = g_system->getSavefileManager()->getChangeCounter();
+	if (!changeCounter)
+		return metaEngine->querySaveMetaInfos(target.c_str(), slot);
+
+	const Common::String savePath = ConfMan.get("savepath");
+	if (changeCounter != _changeCounter || target != _target || savePath != _savePath
+	    || _descriptors.size() >= kMaxEntries) {
+		_descriptors.clear();
+		_changeCounter = changeCounter;
+		_target = target;
+		_savePath = savePath;
+	}
+
+	DescriptorMap::const_iterator i = _descriptors.find(slot);
+	if (i != _descriptors.end())
+		return i->_value;
+
+	SaveStateDescriptor desc;
+	const Common::String filename = metaEngine->getSavegameFile(target.c_str(), slot);
+	if (filename.empty() || !loadFromIndex(target, filename, slot, desc)) {
+		desc = metaEngine->querySaveMetaInfos(target.c_str(), slot);
+
+		// Only cache the infos if querying did not write or remove any savefile
+		if (g_system->getSavefileManager()->getChangeCounter() != changeCounter)
+			return desc;
+
+		// Empty slots have no savefile to keep the infos for
+		if (!filename.empty() && desc.getSaveSlot() == slot)
+			storeInIndex(target, filename, desc);
+	}
+
+	_descriptors[slot] = desc;
+	return desc;
+}
+
+bool SaveMetaInfoCache::loadFromIndex(const Common::String &target, const Common::String &filename, int slot, SaveStateDescriptor &desc) {
+	Common::ScopedPtr<Common::SeekableReadStream> in(g_system->getSavefileManager()->loadSavefileMetaData(target, filename));
+	if (!in)
+		return false;
+
+	return desc.loadFromStream(*in) && desc.getSaveSlot() == slot;
+}
+
+void SaveMetaInfoCache::storeInIndex(const Common::String &target, const Common::String &filename, const SaveStateDescriptor &desc) {
+	Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+	desc.saveToStream(out);
+	g_system->getSavefileManager()->storeSavefileMetaData(target, filename, out.getData(), out.size());
+}
+
 SaveLoadChooserDialog::SaveLoadChooserDialog(const Common::String &dialogName, const bool saveMode)
 	: Dialog(dialogName), _metaEngine(0), _delSupport(false), _metaInfoSupport(false),
 	_thumbnailSupport(false), _saveDateSupport(false), _playTimeSupport(false), _saveMode(saveMode)
@@ -96,6 +180,13 @@ void SaveLoadChooserDialog::open() {
 	setResult(-1);
 }
 
+void SaveLoadChooserDialog::close() {
+	// Keep the meta infos loaded while the dialog was open for next time
+	g_system->getSavefileManager()->flushSavefileMetaData();
+
+	Dialog::close();
+}
+
 int SaveLoadChooserDialog::run(const Common::String &target, const MetaEngine *metaEngine) {
 	_metaEngine = metaEngine;
 	_target = target;
@@ -108,6 +199,10 @@ int SaveLoadChooserDialog::run(const Common::String &target, const MetaEngine *m
 	return runIntern();
 }
 
+SaveStateDescriptor SaveLoadChooserDialog::querySaveMetaInfos(int slot) const {
+	return SaveMetaInfoCache::instance().query(_metaEngine, _target, slot);
+}
+
 void SaveLoadChooserDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data) {
 #ifndef DISABLE_SAVELOADCHOOSER_GRID
 	switch (cmd) {
@@ -362,7 +457,7 @@ void SaveLoadChooserSimple::updateSelection(bool redraw) {
 	_playtime->setLabel(_("No playtime saved"));
 
 	if (selItem >= 0 && _metaInfoSupport) {
-		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), _saveList[selItem].getSaveSlot());
+		SaveStateDescriptor desc = querySaveMetaInfos(_saveList[selItem].getSaveSlot());
 
 		isDeletable = desc.getDeletableFlag() && _delSupport;
 		isWriteProtected = desc.getWriteProtectedFlag();
@@ -603,6 +698,17 @@ void SaveLoadChooserGrid::handleCommand(CommandSender *sender, uint32 cmd, uint3
 	}
 }
 
+void SaveLoadChooserGrid::handleTickle() {
+	// Load the meta infos of the neighboring pages one slot at a time, so
+	// switching pages is fast without blocking the dialog.
+	if (!_prefetchSlots.empty()) {
+		querySaveMetaInfos(_prefetchSlots.back());
+		_prefetchSlots.pop_back();
+	}
+
+	SaveLoadChooserDialog::handleTickle();
+}
+
 void SaveLoadChooserGrid::handleMouseWheel(int x, int y, int direction) {
 	if (direction > 0) {
 		if (_nextButton->isEnabled()) {
@@ -655,7 +761,7 @@ void SaveLoadChooserGrid::open() {
 			// In case there was a gap found use the slot.
 			if (lastSlot + 1 < curSlot) {
 				// Check that the save slot can be used for user saves.
-				SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), lastSlot + 1);
+				SaveStateDescriptor desc = querySaveMetaInfos(lastSlot + 1);
 				if (!desc.getWriteProtectedFlag()) {
 					_nextFreeSaveSlot = lastSlot + 1;
 					break;
@@ -669,7 +775,7 @@ void SaveLoadChooserGrid::open() {
 		const int maxSlot = _metaEngine->getMaximumSaveSlot();
 		for (int i = lastSlot; _nextFreeSaveSlot == -1 && i < maxSlot; ++i) {
 			// Check that the save slot can be used for user saves.
-			SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), i + 1);
+			SaveStateDescriptor desc = querySaveMetaInfos(i + 1);
 			if (!desc.getWriteProtectedFlag()) {
 				_nextFreeSaveSlot = i + 1;
 			}
@@ -863,7 +969,7 @@ void SaveLoadChooserGrid::updateSaves() {
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
 		const uint saveSlot = _saveList[i].getSaveSlot();
 
-		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot);
+		SaveStateDescriptor desc = querySaveMetaInfos(saveSlot);
 		SlotButton &curButton = _buttons[curNum];
 		curButton.setVisible(true);
 		const Graphics::Surface *thumbnail = desc.getThumbnail();
@@ -910,6 +1016,15 @@ void SaveLoadChooserGrid::updateSaves() {
 		}
 	}
 
+	// Queue the slots of the previous and the next page for prefetching,
+	// the next page first since it is the more likely one to be shown.
+	_prefetchSlots.clear();
+	const uint pageStart = _curPage * _entriesPerPage;
+	for (uint i = pageStart; i > 0 && i + _entriesPerPage > pageStart; --i)
+		_prefetchSlots.push_back(_saveList[i - 1].getSaveSlot());
+	for (uint i = MIN<uint>(pageStart + 2 * _entriesPerPage, _saveList.size()); i > pageStart + _entriesPerPage; --i)
+		_prefetchSlots.push_back(_saveList[i - 1].getSaveSlot());
+
 	const uint numPages = (_entriesPerPage != 0 && !_saveList.empty()) ? ((_saveList.size() + _entriesPerPage - 1) / _entriesPerPage) : 1;
 	_pageDisplay->setLabel(Common::String::format("%u/%u", _curPage + 1, numPages));
 
@@ -964,3 +1079,7 @@ void SavenameDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 dat
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
 
 } // End of namespace GUI
+
+namespace Common {
+DECLARE_SINGLETON(GUI::SaveMetaInfoCache);
+}
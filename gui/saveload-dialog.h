@@ -55,6 +55,7 @@ public:
 	SaveLoadChooserDialog(int x, int y, int w, int h, const bool saveMode);
 
 	virtual void open();
+	virtual void close();
 
 	virtual void reflowLayout();
 
@@ -70,6 +71,15 @@ public:
 protected:
 	virtual int runIntern() = 0;
 
+	/**
+	 * Queries the meta infos of a save slot of the current target. The
+	 * infos are cached until a savefile is written or removed, so showing
+	 * a slot again does not need to load the savefile again. If the engine
+	 * tells which savefile holds the slot, they are also kept in the
+	 * savefile manager's meta data index, which lasts across sessions.
+	 */
+	SaveStateDescriptor querySaveMetaInfos(int slot) const;
+
 	const bool				_saveMode;
 	const MetaEngine		*_metaEngine;
 	bool					_delSupport;
@@ -164,6 +174,7 @@ public:
 protected:
 	virtual void handleCommand(CommandSender *sender, uint32 cmd, uint32 data);
 	virtual void handleMouseWheel(int x, int y, int direction);
+	virtual void handleTickle();
 private:
 	virtual int runIntern();
 
@@ -172,6 +183,9 @@ private:
 	uint _curPage;
 	SaveStateList _saveList;
 
+	/** Slots of the neighboring pages, whose meta infos are loaded while idle. */
+	Common::Array<int> _prefetchSlots;
+
 	ButtonWidget *_nextButton;
 	ButtonWidget *_prevButton;
 
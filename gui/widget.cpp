@@ -37,13 +37,13 @@ namespace GUI {
 
 Widget::Widget(GuiObject *boss, int x, int y, int w, int h, const char *tooltip)
 	: GuiObject(x, y, w, h), _type(0), _boss(boss), _tooltip(tooltip),
-	  _id(0), _flags(0), _hasFocus(false), _state(ThemeEngine::kStateEnabled) {
+	  _id(0), _flags(0), _hasFocus(false), _needsRedraw(false), _state(ThemeEngine::kStateEnabled) {
 	init();
 }
 
 Widget::Widget(GuiObject *boss, const Common::String &name, const char *tooltip)
 	: GuiObject(name), _type(0), _boss(boss), _tooltip(tooltip),
-	  _id(0), _flags(0), _hasFocus(false), _state(ThemeEngine::kStateDisabled) {
+	  _id(0), _flags(0), _hasFocus(false), _needsRedraw(false), _state(ThemeEngine::kStateDisabled) {
 	init();
 }
 
@@ -88,6 +88,8 @@ void Widget::updateState(int oldFlags, int newFlags) {
 }
 
 void Widget::draw() {
+	_needsRedraw = false;
+
 	if (!isVisible() || !_boss->isVisible())
 		return;
 
@@ -150,6 +152,17 @@ Widget *Widget::findWidgetInChain(Widget *w, const char *name) {
 	return 0;
 }
 
+void Widget::drawDirtyWidgetsInChain(Widget *w) {
+	while (w) {
+		// Drawing a widget also draws all of its children
+		if (w->_needsRedraw)
+			w->draw();
+		else
+			drawDirtyWidgetsInChain(w->_firstWidget);
+		w = w->_next;
+	}
+}
+
 void Widget::setEnabled(bool e) {
 	if ((_flags & WIDGET_ENABLED) != e) {
 		if (e)
@@ -337,7 +350,7 @@ ButtonWidget *addClearButton(GuiObject *boss, const Common::String &name, uint32
 
 void ButtonWidget::setHighLighted(bool enable) {
 	(enable) ? setFlags(WIDGET_HILITED) : clearFlags(WIDGET_HILITED);
-	draw();
+	markAsDirty();
 }
 
 void ButtonWidget::handleTickle() {
@@ -352,14 +365,14 @@ void ButtonWidget::handleTickle() {
 void ButtonWidget::setPressedState() {
 	wantTickle(true);
 	setFlags(WIDGET_PRESSED);
-	draw();
+	markAsDirty();
 }
 
 void ButtonWidget::stopAnimatePressedState() {
 	wantTickle(false);
 	_lastTime = 0;
 	clearFlags(WIDGET_PRESSED);
-	draw();
+	markAsDirty();
 }
 
 void ButtonWidget::startAnimatePressedState() {
@@ -469,7 +482,7 @@ void CheckboxWidget::setState(bool state) {
 	if (_state != state) {
 		_state = state;
 		//_flags ^= WIDGET_INV_BORDER;
-		draw();
+		markAsDirty();
 	}
 	sendCommand(_cmd, _state);
 }
@@ -537,7 +550,7 @@ void RadiobuttonWidget::setState(bool state, bool setGroup) {
 	if (_state != state) {
 		_state = state;
 		//_flags ^= WIDGET_INV_BORDER;
-		draw();
+		markAsDirty();
 	}
 	sendCommand(_cmd, _state);
 }
@@ -572,7 +585,7 @@ void SliderWidget::handleMouseMoved(int x, int y, int button) {
 
 		if (newValue != _value) {
 			_value = newValue;
-			draw();
+			markAsDirty();
 			sendCommand(_cmd, _value);	// FIXME - hack to allow for "live update" in sound dialog
 		}
 	}
@@ -604,7 +617,7 @@ void SliderWidget::handleMouseWheel(int x, int y, int direction) {
 
 		if (newValue != _value) {
 			_value = newValue;
-			draw();
+			markAsDirty();
 			sendCommand(_cmd, _value);	// FIXME - hack to allow for "live update" in sound dialog
 		}
 	}
@@ -0,0 +1,56 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "audio/softsynth/emumidi.h"
+
+/**
+ * Records the absolute sample position of every timer tick.
+ */
+class TickRecordingDriver : public MidiDriver_Emulated {
+public:
+	Common::Array<int> _ticks;
+	int _generated;
+
+	TickRecordingDriver(bool batch) : MidiDriver_Emulated(0), _generated(0) {
+		setBatchTicks(batch);
+	}
+
+	void close() {}
+	void send(uint32 b) {}
+	MidiChannel *allocateChannel() { return 0; }
+	MidiChannel *getPercussionChannel() { return 0; }
+
+	bool isStereo() const { return false; }
+	int getRate() const { return 22050; }
+
+protected:
+	void generateSamples(int16 *buf, int len) {
+		_generated += len;
+	}
+
+	void onTimer() {
+		_ticks.push_back(_generated + (getTickSample() >= 0 ? getTickSample() : 0));
+	}
+};
+
+class EmulatedMidiDriverTestSuite : public CxxTest::TestSuite
+{
+public:
+	void test_batched_ticks() {
+		TickRecordingDriver plain(false);
+		TickRecordingDriver batched(true);
+		plain.open();
+		batched.open();
+
+		int16 buffer[2048];
+		for (int len = 1; len < 2048; len = len * 2 + 7) {
+			plain.readBuffer(buffer, len);
+			batched.readBuffer(buffer, len);
+		}
+
+		// Batching must not change where the ticks happen
+		TS_ASSERT_EQUALS(plain._generated, batched._generated);
+		TS_ASSERT(plain._ticks.size() > 10);
+		TS_ASSERT(plain._ticks == batched._ticks);
+	}
+};
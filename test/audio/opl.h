@@ -0,0 +1,147 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/fmopl.h"
+#include "audio/softsynth/opl/dosbox.h"
+
+#ifndef DISABLE_DOSBOX_OPL
+
+class DOSBoxOPLTestSuite : public CxxTest::TestSuite
+{
+private:
+	static void playNote(OPL::OPL *opl, int channelOffset) {
+		// Enable the OPL3 mode and output to both speakers, if available
+		if (opl->isStereo()) {
+			opl->writeReg(0x105, 0x01);
+			opl->writeReg(0xC0 + channelOffset, 0x30);
+		}
+
+		// Simple sine voice, modulator and carrier of the given channel
+		opl->writeReg(0x20 + channelOffset, 0x01);
+		opl->writeReg(0x40 + channelOffset, 0x10);
+		opl->writeReg(0x60 + channelOffset, 0xF0);
+		opl->writeReg(0x80 + channelOffset, 0x77);
+		opl->writeReg(0x23 + channelOffset, 0x01);
+		opl->writeReg(0x43 + channelOffset, 0x00);
+		opl->writeReg(0x63 + channelOffset, 0xF0);
+		opl->writeReg(0x83 + channelOffset, 0x77);
+		opl->writeReg(0xA0 + channelOffset, 0x98);
+		opl->writeReg(0xB0 + channelOffset, 0x31);
+	}
+
+	/**
+	 * Render a note in one go and in blocks of varying sizes, the output
+	 * must not depend on how it is split up.
+	 */
+	void readBufferTestTemplate(OPL::Config::OplType type) {
+		const int rate = 22050;
+		const int numSamples = 4000;
+		int16 *whole = new int16[numSamples];
+		int16 *split = new int16[numSamples];
+
+		OPL::DOSBox::OPL *opl = new OPL::DOSBox::OPL(type);
+		TS_ASSERT(opl->init(rate));
+		playNote(opl, 0);
+		opl->readBuffer(whole, numSamples);
+		delete opl;
+
+		opl = new OPL::DOSBox::OPL(type);
+		TS_ASSERT(opl->init(rate));
+		playNote(opl, 0);
+		const int channels = opl->isStereo() ? 2 : 1;
+		int pos = 0;
+		for (int len = 1; pos < numSamples; len = len * 3 + 1) {
+			const int step = MIN(len * channels, numSamples - pos);
+			opl->readBuffer(split + pos, step);
+			pos += step;
+		}
+		delete opl;
+
+		TS_ASSERT_EQUALS(memcmp(whole, split, sizeof(int16) * numSamples), 0);
+
+		bool silent = true;
+		for (int i = 0; i < numSamples; ++i) {
+			if (whole[i] != 0) {
+				silent = false;
+				break;
+			}
+		}
+		TS_ASSERT(!silent);
+
+		delete[] whole;
+		delete[] split;
+	}
+
+	/**
+	 * Render register writes queued with their sample positions in one
+	 * render() call, and by writing them directly between readBuffer()
+	 * calls. Both must give the same output.
+	 */
+	void writeQueueTestTemplate(OPL::Config::OplType type) {
+		const int rate = 22050;
+		const int numFrames = 2000;
+		static const struct {
+			uint32 sample;
+			int reg;
+			int value;
+		} writes[] = {
+			{   0, 0xA0, 0x98 },
+			{   0, 0xB0, 0x31 },
+			{ 300, 0x43, 0x08 },
+			{ 301, 0x43, 0x10 },
+			{ 900, 0xB0, 0x11 },
+			{ 900, 0xA0, 0x57 },
+			{ 900, 0xB0, 0x32 },
+			{ numFrames, 0xB0, 0x12 }
+		};
+
+		OPL::DOSBox::OPL *opl = new OPL::DOSBox::OPL(type);
+		TS_ASSERT(opl->init(rate));
+		playNote(opl, 0);
+		const int channels = opl->isStereo() ? 2 : 1;
+		int16 *direct = new int16[numFrames * channels];
+		int16 *queued = new int16[numFrames * channels];
+
+		int pos = 0;
+		for (int i = 0; i < ARRAYSIZE(writes); ++i) {
+			const int sample = MIN<int>(writes[i].sample, numFrames);
+			opl->readBuffer(direct + pos * channels, (sample - pos) * channels);
+			pos = sample;
+			opl->writeReg(writes[i].reg, writes[i].value);
+		}
+		delete opl;
+
+		opl = new OPL::DOSBox::OPL(type);
+		TS_ASSERT(opl->init(rate));
+		playNote(opl, 0);
+		OPL::WriteQueue queue;
+		for (int i = 0; i < ARRAYSIZE(writes); ++i)
+			queue.push(writes[i].sample, writes[i].reg, writes[i].value);
+		queue.render(opl, queued, numFrames);
+		TS_ASSERT(queue.empty());
+		delete opl;
+
+		TS_ASSERT_EQUALS(memcmp(direct, queued, sizeof(int16) * numFrames * channels), 0);
+
+		delete[] direct;
+		delete[] queued;
+	}
+
+public:
+	void test_write_queue_opl2() {
+		writeQueueTestTemplate(OPL::Config::kOpl2);
+	}
+
+	void test_write_queue_opl3() {
+		writeQueueTestTemplate(OPL::Config::kOpl3);
+	}
+
+	void test_read_buffer_opl2() {
+		readBufferTestTemplate(OPL::Config::kOpl2);
+	}
+
+	void test_read_buffer_opl3() {
+		readBufferTestTemplate(OPL::Config::kOpl3);
+	}
+};
+
+#endif
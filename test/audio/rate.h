@@ -0,0 +1,161 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoders/raw.h"
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include "common/endian.h"
+#include "common/frac.h"
+#include "common/stream.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kNumFrames = 4099
+	};
+
+	uint32 _seed;
+
+	int16 random16() {
+		_seed = _seed * 1103515245 + 12345;
+		return (int16)(_seed >> 8);
+	}
+
+	Audio::AudioStream *createStream(const int16 *samples, int numSamples, int rate, bool stereo) {
+		byte *data = (byte *)malloc(numSamples * 2);
+		for (int i = 0; i < numSamples; ++i)
+			WRITE_LE_UINT16(data + i * 2, samples[i]);
+
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream(data, numSamples * 2, DisposeAfterUse::YES);
+		return Audio::makeRawStream(stream, rate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | (stereo ? Audio::FLAG_STEREO : 0));
+	}
+
+	static void mixReference(int16 &dst, int sample, int vol) {
+		int val = dst + (sample * vol) / Audio::Mixer::kMaxMixerVolume;
+		dst = CLIP<int>(val, -32768, 32767);
+	}
+
+	/**
+	 * Run the given conversion through the rate converter and a straight
+	 * scalar reimplementation of it, and compare the results.
+	 */
+	void checkConversion(int inRate, int outRate, bool stereo, bool reverseStereo, int vol_l, int vol_r) {
+		const int channels = stereo ? 2 : 1;
+		const int numSamples = kNumFrames * channels;
+		const int maxOut = kNumFrames * 2 + 16;
+
+		int16 *in = new int16[numSamples];
+		for (int i = 0; i < numSamples; ++i)
+			in[i] = random16();
+		// Make sure the extreme values show up
+		in[0] = 32767;
+		in[channels] = -32768;
+
+		int16 *out = new int16[maxOut * 2];
+		int16 *expected = new int16[maxOut * 2];
+		for (int i = 0; i < maxOut * 2; ++i)
+			out[i] = expected[i] = random16();
+
+		// Straight reimplementation of the scalar converters
+		int expectedFrames = 0;
+		const frac_t inc = ((frac_t)inRate << FRAC_BITS) / outRate;
+		frac_t opos = FRAC_ONE;
+		int pos = 0;
+		int last0 = 0, last1 = 0, cur0 = 0, cur1 = 0;
+		while (expectedFrames < maxOut) {
+			int out0, out1;
+			if (inRate == outRate || (inRate % outRate) == 0) {
+				// Copy / simple converter: pick every n-th frame, the simple
+				// converter starts with the second one
+				const int step = inRate / outRate;
+				const int frame = expectedFrames * step + (step > 1 ? 1 : 0);
+				if (frame >= kNumFrames)
+					break;
+				out0 = in[frame * channels];
+				out1 = in[frame * channels + channels - 1];
+			} else {
+				bool endOfInput = false;
+				while (opos >= (frac_t)FRAC_ONE) {
+					if (pos >= kNumFrames) {
+						endOfInput = true;
+						break;
+					}
+					last0 = cur0;
+					last1 = cur1;
+					cur0 = in[pos * channels];
+					cur1 = in[pos * channels + channels - 1];
+					++pos;
+					opos -= FRAC_ONE;
+				}
+				if (endOfInput)
+					break;
+				out0 = (int16)(last0 + (((cur0 - last0) * opos + FRAC_HALF) >> FRAC_BITS));
+				out1 = (int16)(last1 + (((cur1 - last1) * opos + FRAC_HALF) >> FRAC_BITS));
+				opos += inc;
+			}
+
+			mixReference(expected[expectedFrames * 2 + (reverseStereo ? 1 : 0)], out0, vol_l);
+			mixReference(expected[expectedFrames * 2 + (reverseStereo ? 0 : 1)], out1, vol_r);
+			++expectedFrames;
+		}
+
+		Audio::AudioStream *input = createStream(in, numSamples, inRate, stereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, stereo, reverseStereo);
+
+		// Use odd sized requests to exercise the non-vectorized remainders
+		int frames = 0;
+		const int requestSizes[] = { 1, 3, 7, 13, 1000, 333 };
+		for (int i = 0; frames < maxOut; i = (i + 1) % ARRAYSIZE(requestSizes)) {
+			const int request = MIN<int>(requestSizes[i], maxOut - frames);
+			const int got = converter->flow(*input, out + frames * 2, request, vol_l, vol_r);
+			frames += got;
+			if (got < request)
+				break;
+		}
+
+		TS_ASSERT_EQUALS(frames, expectedFrames);
+		TS_ASSERT_EQUALS(memcmp(out, expected, maxOut * 2 * sizeof(int16)), 0);
+
+		delete converter;
+		delete input;
+		delete[] expected;
+		delete[] out;
+		delete[] in;
+	}
+
+public:
+	void setUp() {
+		_seed = 0x12345678;
+	}
+
+	void test_copy_mono() {
+		checkConversion(22050, 22050, false, false, 256, 100);
+		checkConversion(22050, 22050, false, false, 0, 255);
+	}
+
+	void test_copy_stereo() {
+		checkConversion(44100, 44100, true, false, 256, 37);
+		checkConversion(44100, 44100, true, true, 256, 37);
+	}
+
+	void test_simple_mono() {
+		checkConversion(44100, 22050, false, false, 200, 256);
+	}
+
+	void test_simple_stereo() {
+		checkConversion(44100, 11025, true, false, 1, 256);
+		checkConversion(44100, 22050, true, true, 128, 255);
+	}
+
+	void test_linear_mono() {
+		checkConversion(11025, 44100, false, false, 256, 256);
+		checkConversion(22050, 48000, false, false, 77, 3);
+	}
+
+	void test_linear_stereo() {
+		checkConversion(22050, 44100, true, false, 256, 192);
+		checkConversion(32000, 44100, true, true, 13, 256);
+	}
+};
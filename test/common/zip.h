@@ -0,0 +1,452 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/unzip.h"
+
+// A ZIP file with two members:
+//  stored.txt   - stored, "Hello stored member!"
+//  deflated.bin - deflated, 3 MiB where byte i is ((i >> 12) + (i & 3)) & 0xFF
+static const byte zipTestData[] = {
+	0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0xdd, 0x78,
+	0x04, 0x52, 0x14, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x73, 0x74,
+	0x6f, 0x72, 0x65, 0x64, 0x2e, 0x74, 0x78, 0x74, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x20, 0x73, 0x74,
+	0x6f, 0x72, 0x65, 0x64, 0x20, 0x6d, 0x65, 0x6d, 0x62, 0x65, 0x72, 0x21, 0x50, 0x4b, 0x03, 0x04,
+	0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21, 0x00, 0x7e, 0x0c, 0x58, 0x8c, 0x07, 0x14,
+	0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x64, 0x65, 0x66, 0x6c, 0x61, 0x74,
+	0x65, 0x64, 0x2e, 0x62, 0x69, 0x6e, 0xed, 0xc3, 0x03, 0x12, 0x00, 0x06, 0x02, 0x04, 0xb0, 0xf2,
+	0x6a, 0xdb, 0xb6, 0x6d, 0xdb, 0xb6, 0x6d, 0xdb, 0xb6, 0x6d, 0xdb, 0xb6, 0x6d, 0xdb, 0xb6, 0xed,
+	0xf6, 0xf6, 0x1d, 0x3b, 0x99, 0x49, 0x06, 0x18, 0x70, 0xa0, 0x81, 0x07, 0x50, 0x55, 0x55, 0x55,
+	0xab, 0xc7, 0x20, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x54, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xff,
+	0x53, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x60, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x5c, 0x55, 0x55,
+	0x55, 0xed, 0x1e, 0x43, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x48, 0x55, 0x55, 0x55, 0xb5, 0x7b,
+	0x0c, 0xa5, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xa1, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x31, 0x8c, 0xaa,
+	0xaa, 0xaa, 0xda, 0x3d, 0x86, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x70, 0xaa, 0xaa, 0xaa, 0x6a,
+	0xf7, 0x18, 0x5e, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x23, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x44,
+	0x55, 0x55, 0x55, 0xb5, 0x7b, 0x8c, 0xa4, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x91, 0x55, 0x55, 0x55,
+	0xd5, 0xee, 0x31, 0x8a, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x46, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7,
+	0x68, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x5d, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x63, 0xa8, 0xaa,
+	0xaa, 0xaa, 0xdd, 0x63, 0x4c, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x8c, 0xa5, 0xaa, 0xaa, 0xaa, 0x76,
+	0x8f, 0xb1, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x31, 0x8e, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xc6, 0x55,
+	0x55, 0x55, 0x55, 0xbb, 0xc7, 0x78, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x5f, 0x55, 0x55, 0x55,
+	0xed, 0x1e, 0x13, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x42, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x4c,
+	0xa4, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x89, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x31, 0x89, 0xaa, 0xaa,
+	0xaa, 0xda, 0x3d, 0x26, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x64, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7,
+	0x98, 0x5c, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x53, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x4a, 0x55,
+	0x55, 0x55, 0xb5, 0x7b, 0x4c, 0xa5, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xa9, 0x55, 0x55, 0x55, 0xd5,
+	0xee, 0x31, 0x8d, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xa6, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x74,
+	0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x98, 0x5e, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x33, 0xa8, 0xaa, 0xaa,
+	0xaa, 0xdd, 0x63, 0x46, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xcc, 0xa4, 0xaa, 0xaa, 0xaa, 0x76, 0x8f,
+	0x99, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x31, 0x8b, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x66, 0x55, 0x55,
+	0x55, 0x55, 0xbb, 0xc7, 0x6c, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x98, 0x5d, 0x55, 0x55, 0x55, 0xed,
+	0x1e, 0x73, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x4e, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xcc, 0xa5,
+	0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xb9, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x31, 0x8f, 0xaa, 0xaa, 0xaa,
+	0xda, 0x3d, 0xe6, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x7c, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x98,
+	0x5f, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x0b, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x41, 0x55, 0x55,
+	0x55, 0xb5, 0x7b, 0x2c, 0xa4, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x85, 0x55, 0x55, 0x55, 0xd5, 0xee,
+	0xb1, 0x88, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x16, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x62, 0xaa,
+	0xaa, 0xaa, 0x6a, 0xf7, 0x58, 0x5c, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x4b, 0xa8, 0xaa, 0xaa, 0xaa,
+	0xdd, 0x63, 0x49, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x2c, 0xa5, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xa5,
+	0x55, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0x8c, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x96, 0x55, 0x55, 0x55,
+	0x55, 0xbb, 0xc7, 0x72, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x58, 0x5e, 0x55, 0x55, 0x55, 0xed, 0x1e,
+	0x2b, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x45, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xac, 0xa4, 0xaa,
+	0xaa, 0xaa, 0x76, 0x8f, 0x95, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0x8a, 0xaa, 0xaa, 0xaa, 0xda,
+	0x3d, 0x56, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x6a, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x58, 0x5d,
+	0x55, 0x55, 0x55, 0xed, 0x1e, 0x6b, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x4d, 0x55, 0x55, 0x55,
+	0xb5, 0x7b, 0xac, 0xa5, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xb5, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xb1,
+	0x8e, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xd6, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x7a, 0xaa, 0xaa,
+	0xaa, 0x6a, 0xf7, 0x58, 0x5f, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x1b, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd,
+	0x63, 0x43, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x6c, 0xa4, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x8d, 0x55,
+	0x55, 0x55, 0xd5, 0xee, 0xb1, 0x89, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x36, 0x55, 0x55, 0x55, 0x55,
+	0xbb, 0xc7, 0x66, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xd8, 0x5c, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x5b,
+	0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x4b, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x6c, 0xa5, 0xaa, 0xaa,
+	0xaa, 0x76, 0x8f, 0xad, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0x8d, 0xaa, 0xaa, 0xaa, 0xda, 0x3d,
+	0xb6, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x76, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xd8, 0x5e, 0x55,
+	0x55, 0x55, 0xed, 0x1e, 0x3b, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x47, 0x55, 0x55, 0x55, 0xb5,
+	0x7b, 0xec, 0xa4, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x9d, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0x8b,
+	0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x76, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x6e, 0xaa, 0xaa, 0xaa,
+	0x6a, 0xf7, 0xd8, 0x5d, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x7b, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0x63,
+	0x4f, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xec, 0xa5, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xbd, 0x55, 0x55,
+	0x55, 0xd5, 0xee, 0xb1, 0x8f, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xf6, 0x55, 0x55, 0x55, 0x55, 0xbb,
+	0xc7, 0x7e, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xd8, 0x5f, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x07, 0xa8,
+	0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x40, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x1c, 0xa4, 0xaa, 0xaa, 0xaa,
+	0x76, 0x8f, 0x83, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x71, 0x88, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x0e,
+	0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x61, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x38, 0x5c, 0x55, 0x55,
+	0x55, 0xed, 0x1e, 0x47, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x48, 0x55, 0x55, 0x55, 0xb5, 0x7b,
+	0x1c, 0xa5, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xa3, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x71, 0x8c, 0xaa,
+	0xaa, 0xaa, 0xda, 0x3d, 0x8e, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x71, 0xaa, 0xaa, 0xaa, 0x6a,
+	0xf7, 0x38, 0x5e, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x27, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x44,
+	0x55, 0x55, 0x55, 0xb5, 0x7b, 0x9c, 0xa4, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x93, 0x55, 0x55, 0x55,
+	0xd5, 0xee, 0x71, 0x8a, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x4e, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7,
+	0x69, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x38, 0x5d, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x67, 0xa8, 0xaa,
+	0xaa, 0xaa, 0xdd, 0xe3, 0x4c, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x9c, 0xa5, 0xaa, 0xaa, 0xaa, 0x76,
+	0x8f, 0xb3, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x71, 0x8e, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xce, 0x55,
+	0x55, 0x55, 0x55, 0xbb, 0xc7, 0x79, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x38, 0x5f, 0x55, 0x55, 0x55,
+	0xed, 0x1e, 0x17, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x42, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x5c,
+	0xa4, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x8b, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x71, 0x89, 0xaa, 0xaa,
+	0xaa, 0xda, 0x3d, 0x2e, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x65, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7,
+	0xb8, 0x5c, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x57, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x4a, 0x55,
+	0x55, 0x55, 0xb5, 0x7b, 0x5c, 0xa5, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xab, 0x55, 0x55, 0x55, 0xd5,
+	0xee, 0x71, 0x8d, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xae, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x75,
+	0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xb8, 0x5e, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x37, 0xa8, 0xaa, 0xaa,
+	0xaa, 0xdd, 0xe3, 0x46, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xdc, 0xa4, 0xaa, 0xaa, 0xaa, 0x76, 0x8f,
+	0x9b, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x71, 0x8b, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x6e, 0x55, 0x55,
+	0x55, 0x55, 0xbb, 0xc7, 0x6d, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xb8, 0x5d, 0x55, 0x55, 0x55, 0xed,
+	0x1e, 0x77, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x4e, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xdc, 0xa5,
+	0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xbb, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x71, 0x8f, 0xaa, 0xaa, 0xaa,
+	0xda, 0x3d, 0xee, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x7d, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xb8,
+	0x5f, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x0f, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x41, 0x55, 0x55,
+	0x55, 0xb5, 0x7b, 0x3c, 0xa4, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x87, 0x55, 0x55, 0x55, 0xd5, 0xee,
+	0xf1, 0x88, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x1e, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x63, 0xaa,
+	0xaa, 0xaa, 0x6a, 0xf7, 0x78, 0x5c, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x4f, 0xa8, 0xaa, 0xaa, 0xaa,
+	0xdd, 0xe3, 0x49, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x3c, 0xa5, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xa7,
+	0x55, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0x8c, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x9e, 0x55, 0x55, 0x55,
+	0x55, 0xbb, 0xc7, 0x73, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x78, 0x5e, 0x55, 0x55, 0x55, 0xed, 0x1e,
+	0x2f, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x45, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xbc, 0xa4, 0xaa,
+	0xaa, 0xaa, 0x76, 0x8f, 0x97, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0x8a, 0xaa, 0xaa, 0xaa, 0xda,
+	0x3d, 0x5e, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x6b, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x78, 0x5d,
+	0x55, 0x55, 0x55, 0xed, 0x1e, 0x6f, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x4d, 0x55, 0x55, 0x55,
+	0xb5, 0x7b, 0xbc, 0xa5, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xb7, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xf1,
+	0x8e, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xde, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x7b, 0xaa, 0xaa,
+	0xaa, 0x6a, 0xf7, 0x78, 0x5f, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x1f, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd,
+	0xe3, 0x43, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x7c, 0xa4, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x8f, 0x55,
+	0x55, 0x55, 0xd5, 0xee, 0xf1, 0x89, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x3e, 0x55, 0x55, 0x55, 0x55,
+	0xbb, 0xc7, 0x67, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xf8, 0x5c, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x5f,
+	0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x4b, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x7c, 0xa5, 0xaa, 0xaa,
+	0xaa, 0x76, 0x8f, 0xaf, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0x8d, 0xaa, 0xaa, 0xaa, 0xda, 0x3d,
+	0xbe, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x77, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xf8, 0x5e, 0x55,
+	0x55, 0x55, 0xed, 0x1e, 0x3f, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x47, 0x55, 0x55, 0x55, 0xb5,
+	0x7b, 0xfc, 0xa4, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x9f, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0x8b,
+	0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x7e, 0x55, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x6f, 0xaa, 0xaa, 0xaa,
+	0x6a, 0xf7, 0xf8, 0x5d, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x7f, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3,
+	0x4f, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xfc, 0xa5, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xbf, 0x55, 0x55,
+	0x55, 0xd5, 0xee, 0xf1, 0x8f, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xfe, 0x55, 0x55, 0x55, 0x55, 0xbb,
+	0xc7, 0x7f, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x40, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x03, 0xaa,
+	0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x20, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x0c, 0xac, 0xaa, 0xaa, 0xaa,
+	0x76, 0x8f, 0x41, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x31, 0xa8, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xfe,
+	0xa7, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xc1, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x31, 0xb8, 0xaa, 0xaa,
+	0xaa, 0xda, 0x3d, 0x86, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x90, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7,
+	0x18, 0x4a, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x43, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x18, 0x55,
+	0x55, 0x55, 0xb5, 0x7b, 0x0c, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xe1, 0x54, 0x55, 0x55, 0xd5,
+	0xee, 0x31, 0xbc, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x46, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x88,
+	0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x49, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x23, 0xab, 0xaa, 0xaa,
+	0xaa, 0xdd, 0x63, 0x14, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x8c, 0xaa, 0xaa, 0xaa, 0xaa, 0x76, 0x8f,
+	0xd1, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x31, 0xba, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xc6, 0x50, 0x55,
+	0x55, 0x55, 0xbb, 0xc7, 0x98, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x4b, 0x55, 0x55, 0x55, 0xed,
+	0x1e, 0x63, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x1c, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x8c, 0xab,
+	0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xf1, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x31, 0xbe, 0xaa, 0xaa, 0xaa,
+	0xda, 0x3d, 0x26, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x84, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x98,
+	0x48, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x13, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x12, 0x55, 0x55,
+	0x55, 0xb5, 0x7b, 0x4c, 0xaa, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xc9, 0x54, 0x55, 0x55, 0xd5, 0xee,
+	0x31, 0xb9, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xa6, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x94, 0xaa,
+	0xaa, 0xaa, 0x6a, 0xf7, 0x98, 0x4a, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x53, 0xab, 0xaa, 0xaa, 0xaa,
+	0xdd, 0x63, 0x1a, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x4c, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xe9,
+	0x54, 0x55, 0x55, 0xd5, 0xee, 0x31, 0xbd, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x66, 0x50, 0x55, 0x55,
+	0x55, 0xbb, 0xc7, 0x8c, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x98, 0x49, 0x55, 0x55, 0x55, 0xed, 0x1e,
+	0x33, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x16, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xcc, 0xaa, 0xaa,
+	0xaa, 0xaa, 0x76, 0x8f, 0xd9, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x31, 0xbb, 0xaa, 0xaa, 0xaa, 0xda,
+	0x3d, 0xe6, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x9c, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x98, 0x4b,
+	0x55, 0x55, 0x55, 0xed, 0x1e, 0x73, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x1e, 0x55, 0x55, 0x55,
+	0xb5, 0x7b, 0xcc, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xf9, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x31,
+	0xbf, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x16, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x82, 0xaa, 0xaa,
+	0xaa, 0x6a, 0xf7, 0x58, 0x48, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x0b, 0xab, 0xaa, 0xaa, 0xaa, 0xdd,
+	0x63, 0x11, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x2c, 0xaa, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xc5, 0x54,
+	0x55, 0x55, 0xd5, 0xee, 0xb1, 0xb8, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x96, 0x50, 0x55, 0x55, 0x55,
+	0xbb, 0xc7, 0x92, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x58, 0x4a, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x4b,
+	0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x19, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x2c, 0xab, 0xaa, 0xaa,
+	0xaa, 0x76, 0x8f, 0xe5, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0xbc, 0xaa, 0xaa, 0xaa, 0xda, 0x3d,
+	0x56, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x8a, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x58, 0x49, 0x55,
+	0x55, 0x55, 0xed, 0x1e, 0x2b, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x15, 0x55, 0x55, 0x55, 0xb5,
+	0x7b, 0xac, 0xaa, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xd5, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0xba,
+	0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xd6, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x9a, 0xaa, 0xaa, 0xaa,
+	0x6a, 0xf7, 0x58, 0x4b, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x6b, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63,
+	0x1d, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xac, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xf5, 0x54, 0x55,
+	0x55, 0xd5, 0xee, 0xb1, 0xbe, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x36, 0x50, 0x55, 0x55, 0x55, 0xbb,
+	0xc7, 0x86, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xd8, 0x48, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x1b, 0xab,
+	0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x13, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x6c, 0xaa, 0xaa, 0xaa, 0xaa,
+	0x76, 0x8f, 0xcd, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0xb9, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xb6,
+	0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x96, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xd8, 0x4a, 0x55, 0x55,
+	0x55, 0xed, 0x1e, 0x5b, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x1b, 0x55, 0x55, 0x55, 0xb5, 0x7b,
+	0x6c, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xed, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0xbd, 0xaa,
+	0xaa, 0xaa, 0xda, 0x3d, 0x76, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x8e, 0xaa, 0xaa, 0xaa, 0x6a,
+	0xf7, 0xd8, 0x49, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x3b, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x17,
+	0x55, 0x55, 0x55, 0xb5, 0x7b, 0xec, 0xaa, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xdd, 0x54, 0x55, 0x55,
+	0xd5, 0xee, 0xb1, 0xbb, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xf6, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7,
+	0x9e, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xd8, 0x4b, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x7b, 0xab, 0xaa,
+	0xaa, 0xaa, 0xdd, 0x63, 0x1f, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xec, 0xab, 0xaa, 0xaa, 0xaa, 0x76,
+	0x8f, 0xfd, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0xbf, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x0e, 0x50,
+	0x55, 0x55, 0x55, 0xbb, 0xc7, 0x81, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x38, 0x48, 0x55, 0x55, 0x55,
+	0xed, 0x1e, 0x07, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x10, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x1c,
+	0xaa, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xc3, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x71, 0xb8, 0xaa, 0xaa,
+	0xaa, 0xda, 0x3d, 0x8e, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x91, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7,
+	0x38, 0x4a, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x47, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x18, 0x55,
+	0x55, 0x55, 0xb5, 0x7b, 0x1c, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xe3, 0x54, 0x55, 0x55, 0xd5,
+	0xee, 0x71, 0xbc, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x4e, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x89,
+	0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x38, 0x49, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x27, 0xab, 0xaa, 0xaa,
+	0xaa, 0xdd, 0xe3, 0x14, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x9c, 0xaa, 0xaa, 0xaa, 0xaa, 0x76, 0x8f,
+	0xd3, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x71, 0xba, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xce, 0x50, 0x55,
+	0x55, 0x55, 0xbb, 0xc7, 0x99, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x38, 0x4b, 0x55, 0x55, 0x55, 0xed,
+	0x1e, 0x67, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x1c, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x9c, 0xab,
+	0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xf3, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x71, 0xbe, 0xaa, 0xaa, 0xaa,
+	0xda, 0x3d, 0x2e, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x85, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xb8,
+	0x48, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x17, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x12, 0x55, 0x55,
+	0x55, 0xb5, 0x7b, 0x5c, 0xaa, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xcb, 0x54, 0x55, 0x55, 0xd5, 0xee,
+	0x71, 0xb9, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xae, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x95, 0xaa,
+	0xaa, 0xaa, 0x6a, 0xf7, 0xb8, 0x4a, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x57, 0xab, 0xaa, 0xaa, 0xaa,
+	0xdd, 0xe3, 0x1a, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x5c, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xeb,
+	0x54, 0x55, 0x55, 0xd5, 0xee, 0x71, 0xbd, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x6e, 0x50, 0x55, 0x55,
+	0x55, 0xbb, 0xc7, 0x8d, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xb8, 0x49, 0x55, 0x55, 0x55, 0xed, 0x1e,
+	0x37, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x16, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xdc, 0xaa, 0xaa,
+	0xaa, 0xaa, 0x76, 0x8f, 0xdb, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x71, 0xbb, 0xaa, 0xaa, 0xaa, 0xda,
+	0x3d, 0xee, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x9d, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xb8, 0x4b,
+	0x55, 0x55, 0x55, 0xed, 0x1e, 0x77, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x1e, 0x55, 0x55, 0x55,
+	0xb5, 0x7b, 0xdc, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xfb, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x71,
+	0xbf, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x1e, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x83, 0xaa, 0xaa,
+	0xaa, 0x6a, 0xf7, 0x78, 0x48, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x0f, 0xab, 0xaa, 0xaa, 0xaa, 0xdd,
+	0xe3, 0x11, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x3c, 0xaa, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xc7, 0x54,
+	0x55, 0x55, 0xd5, 0xee, 0xf1, 0xb8, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x9e, 0x50, 0x55, 0x55, 0x55,
+	0xbb, 0xc7, 0x93, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x78, 0x4a, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x4f,
+	0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x19, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x3c, 0xab, 0xaa, 0xaa,
+	0xaa, 0x76, 0x8f, 0xe7, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0xbc, 0xaa, 0xaa, 0xaa, 0xda, 0x3d,
+	0x5e, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x8b, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x78, 0x49, 0x55,
+	0x55, 0x55, 0xed, 0x1e, 0x2f, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x15, 0x55, 0x55, 0x55, 0xb5,
+	0x7b, 0xbc, 0xaa, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xd7, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0xba,
+	0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xde, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x9b, 0xaa, 0xaa, 0xaa,
+	0x6a, 0xf7, 0x78, 0x4b, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x6f, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3,
+	0x1d, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xbc, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xf7, 0x54, 0x55,
+	0x55, 0xd5, 0xee, 0xf1, 0xbe, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x3e, 0x50, 0x55, 0x55, 0x55, 0xbb,
+	0xc7, 0x87, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xf8, 0x48, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x1f, 0xab,
+	0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x13, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x7c, 0xaa, 0xaa, 0xaa, 0xaa,
+	0x76, 0x8f, 0xcf, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0xb9, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xbe,
+	0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x97, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xf8, 0x4a, 0x55, 0x55,
+	0x55, 0xed, 0x1e, 0x5f, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x1b, 0x55, 0x55, 0x55, 0xb5, 0x7b,
+	0x7c, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xef, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0xbd, 0xaa,
+	0xaa, 0xaa, 0xda, 0x3d, 0x7e, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x8f, 0xaa, 0xaa, 0xaa, 0x6a,
+	0xf7, 0xf8, 0x49, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x3f, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x17,
+	0x55, 0x55, 0x55, 0xb5, 0x7b, 0xfc, 0xaa, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xdf, 0x54, 0x55, 0x55,
+	0xd5, 0xee, 0xf1, 0xbb, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xfe, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7,
+	0x9f, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xf8, 0x4b, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x7f, 0xab, 0xaa,
+	0xaa, 0xaa, 0xdd, 0xe3, 0x1f, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xfc, 0xab, 0xaa, 0xaa, 0xaa, 0x76,
+	0x8f, 0xff, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x31, 0x80, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x06, 0x54,
+	0x55, 0x55, 0x55, 0xbb, 0xc7, 0x40, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x58, 0x55, 0x55, 0x55,
+	0xed, 0x1e, 0x83, 0xa8, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x50, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xfc,
+	0x4f, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x83, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x70, 0x55, 0x55,
+	0x55, 0xb5, 0x7b, 0x0c, 0xa1, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x21, 0x55, 0x55, 0x55, 0xd5, 0xee,
+	0x31, 0x94, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x86, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x30, 0xaa,
+	0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x56, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xc3, 0xa9, 0xaa, 0xaa, 0xaa,
+	0xdd, 0x63, 0x78, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x8c, 0xa0, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x11,
+	0x55, 0x55, 0x55, 0xd5, 0xee, 0x31, 0x92, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x46, 0x56, 0x55, 0x55,
+	0x55, 0xbb, 0xc7, 0x28, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x55, 0x55, 0x55, 0x55, 0xed, 0x1e,
+	0xa3, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x74, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x8c, 0xa1, 0xaa,
+	0xaa, 0xaa, 0x76, 0x8f, 0x31, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x31, 0x96, 0xaa, 0xaa, 0xaa, 0xda,
+	0x3d, 0xc6, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x38, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x57,
+	0x55, 0x55, 0x55, 0xed, 0x1e, 0xe3, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x7c, 0x55, 0x55, 0x55,
+	0xb5, 0x7b, 0x4c, 0xa0, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x09, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x31,
+	0x91, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x26, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x24, 0xaa, 0xaa,
+	0xaa, 0x6a, 0xf7, 0x98, 0x54, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x93, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd,
+	0x63, 0x72, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x4c, 0xa1, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x29, 0x55,
+	0x55, 0x55, 0xd5, 0xee, 0x31, 0x95, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xa6, 0x56, 0x55, 0x55, 0x55,
+	0xbb, 0xc7, 0x34, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x98, 0x56, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xd3,
+	0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x7a, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xcc, 0xa0, 0xaa, 0xaa,
+	0xaa, 0x76, 0x8f, 0x19, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x31, 0x93, 0xaa, 0xaa, 0xaa, 0xda, 0x3d,
+	0x66, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x2c, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x98, 0x55, 0x55,
+	0x55, 0x55, 0xed, 0x1e, 0xb3, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x76, 0x55, 0x55, 0x55, 0xb5,
+	0x7b, 0xcc, 0xa1, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x39, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x31, 0x97,
+	0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xe6, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x3c, 0xaa, 0xaa, 0xaa,
+	0x6a, 0xf7, 0x98, 0x57, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xf3, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63,
+	0x7e, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x2c, 0xa0, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x05, 0x55, 0x55,
+	0x55, 0xd5, 0xee, 0xb1, 0x90, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x16, 0x56, 0x55, 0x55, 0x55, 0xbb,
+	0xc7, 0x22, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x58, 0x54, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x8b, 0xa9,
+	0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x71, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x2c, 0xa1, 0xaa, 0xaa, 0xaa,
+	0x76, 0x8f, 0x25, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0x94, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x96,
+	0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x32, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x58, 0x56, 0x55, 0x55,
+	0x55, 0xed, 0x1e, 0xcb, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x79, 0x55, 0x55, 0x55, 0xb5, 0x7b,
+	0xac, 0xa0, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x15, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0x92, 0xaa,
+	0xaa, 0xaa, 0xda, 0x3d, 0x56, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x2a, 0xaa, 0xaa, 0xaa, 0x6a,
+	0xf7, 0x58, 0x55, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xab, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x75,
+	0x55, 0x55, 0x55, 0xb5, 0x7b, 0xac, 0xa1, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x35, 0x55, 0x55, 0x55,
+	0xd5, 0xee, 0xb1, 0x96, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xd6, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7,
+	0x3a, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x58, 0x57, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xeb, 0xa9, 0xaa,
+	0xaa, 0xaa, 0xdd, 0x63, 0x7d, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x6c, 0xa0, 0xaa, 0xaa, 0xaa, 0x76,
+	0x8f, 0x0d, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0x91, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x36, 0x56,
+	0x55, 0x55, 0x55, 0xbb, 0xc7, 0x26, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xd8, 0x54, 0x55, 0x55, 0x55,
+	0xed, 0x1e, 0x9b, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x73, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x6c,
+	0xa1, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x2d, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0x95, 0xaa, 0xaa,
+	0xaa, 0xda, 0x3d, 0xb6, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x36, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7,
+	0xd8, 0x56, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xdb, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x7b, 0x55,
+	0x55, 0x55, 0xb5, 0x7b, 0xec, 0xa0, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x1d, 0x55, 0x55, 0x55, 0xd5,
+	0xee, 0xb1, 0x93, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x76, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x2e,
+	0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xd8, 0x55, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xbb, 0xa9, 0xaa, 0xaa,
+	0xaa, 0xdd, 0x63, 0x77, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xec, 0xa1, 0xaa, 0xaa, 0xaa, 0x76, 0x8f,
+	0x3d, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0x97, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xf6, 0x56, 0x55,
+	0x55, 0x55, 0xbb, 0xc7, 0x3e, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xd8, 0x57, 0x55, 0x55, 0x55, 0xed,
+	0x1e, 0xfb, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x7f, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x1c, 0xa0,
+	0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x03, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x71, 0x90, 0xaa, 0xaa, 0xaa,
+	0xda, 0x3d, 0x0e, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x21, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x38,
+	0x54, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x87, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x70, 0x55, 0x55,
+	0x55, 0xb5, 0x7b, 0x1c, 0xa1, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x23, 0x55, 0x55, 0x55, 0xd5, 0xee,
+	0x71, 0x94, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x8e, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x31, 0xaa,
+	0xaa, 0xaa, 0x6a, 0xf7, 0x38, 0x56, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xc7, 0xa9, 0xaa, 0xaa, 0xaa,
+	0xdd, 0xe3, 0x78, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x9c, 0xa0, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x13,
+	0x55, 0x55, 0x55, 0xd5, 0xee, 0x71, 0x92, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x4e, 0x56, 0x55, 0x55,
+	0x55, 0xbb, 0xc7, 0x29, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x38, 0x55, 0x55, 0x55, 0x55, 0xed, 0x1e,
+	0xa7, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x74, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x9c, 0xa1, 0xaa,
+	0xaa, 0xaa, 0x76, 0x8f, 0x33, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x71, 0x96, 0xaa, 0xaa, 0xaa, 0xda,
+	0x3d, 0xce, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x39, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x38, 0x57,
+	0x55, 0x55, 0x55, 0xed, 0x1e, 0xe7, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x7c, 0x55, 0x55, 0x55,
+	0xb5, 0x7b, 0x5c, 0xa0, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x0b, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x71,
+	0x91, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x2e, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x25, 0xaa, 0xaa,
+	0xaa, 0x6a, 0xf7, 0xb8, 0x54, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x97, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd,
+	0xe3, 0x72, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x5c, 0xa1, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x2b, 0x55,
+	0x55, 0x55, 0xd5, 0xee, 0x71, 0x95, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xae, 0x56, 0x55, 0x55, 0x55,
+	0xbb, 0xc7, 0x35, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xb8, 0x56, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xd7,
+	0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x7a, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xdc, 0xa0, 0xaa, 0xaa,
+	0xaa, 0x76, 0x8f, 0x1b, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x71, 0x93, 0xaa, 0xaa, 0xaa, 0xda, 0x3d,
+	0x6e, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x2d, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xb8, 0x55, 0x55,
+	0x55, 0x55, 0xed, 0x1e, 0xb7, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x76, 0x55, 0x55, 0x55, 0xb5,
+	0x7b, 0xdc, 0xa1, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x3b, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x71, 0x97,
+	0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xee, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x3d, 0xaa, 0xaa, 0xaa,
+	0x6a, 0xf7, 0xb8, 0x57, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xf7, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3,
+	0x7e, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x3c, 0xa0, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x07, 0x55, 0x55,
+	0x55, 0xd5, 0xee, 0xf1, 0x90, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x1e, 0x56, 0x55, 0x55, 0x55, 0xbb,
+	0xc7, 0x23, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x78, 0x54, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x8f, 0xa9,
+	0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x71, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x3c, 0xa1, 0xaa, 0xaa, 0xaa,
+	0x76, 0x8f, 0x27, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0x94, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x9e,
+	0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x33, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x78, 0x56, 0x55, 0x55,
+	0x55, 0xed, 0x1e, 0xcf, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x79, 0x55, 0x55, 0x55, 0xb5, 0x7b,
+	0xbc, 0xa0, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x17, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0x92, 0xaa,
+	0xaa, 0xaa, 0xda, 0x3d, 0x5e, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x2b, 0xaa, 0xaa, 0xaa, 0x6a,
+	0xf7, 0x78, 0x55, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xaf, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x75,
+	0x55, 0x55, 0x55, 0xb5, 0x7b, 0xbc, 0xa1, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x37, 0x55, 0x55, 0x55,
+	0xd5, 0xee, 0xf1, 0x96, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xde, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7,
+	0x3b, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x78, 0x57, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xef, 0xa9, 0xaa,
+	0xaa, 0xaa, 0xdd, 0xe3, 0x7d, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x7c, 0xa0, 0xaa, 0xaa, 0xaa, 0x76,
+	0x8f, 0x0f, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0x91, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x3e, 0x56,
+	0x55, 0x55, 0x55, 0xbb, 0xc7, 0x27, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xf8, 0x54, 0x55, 0x55, 0x55,
+	0xed, 0x1e, 0x9f, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x73, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x7c,
+	0xa1, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x2f, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0x95, 0xaa, 0xaa,
+	0xaa, 0xda, 0x3d, 0xbe, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x37, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7,
+	0xf8, 0x56, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xdf, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x7b, 0x55,
+	0x55, 0x55, 0xb5, 0x7b, 0xfc, 0xa0, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x1f, 0x55, 0x55, 0x55, 0xd5,
+	0xee, 0xf1, 0x93, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x7e, 0x56, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x2f,
+	0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xf8, 0x55, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xbf, 0xa9, 0xaa, 0xaa,
+	0xaa, 0xdd, 0xe3, 0x77, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xfc, 0xa1, 0xaa, 0xaa, 0xaa, 0x76, 0x8f,
+	0x3f, 0x55, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0x97, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xfe, 0x56, 0x55,
+	0x55, 0x55, 0xbb, 0xc7, 0x3f, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xf8, 0x57, 0x55, 0x55, 0x55, 0xed,
+	0x1e, 0xff, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x00, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x0c, 0xa8,
+	0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x81, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xff, 0x07, 0x50, 0x4b, 0x01,
+	0x02, 0x14, 0x03, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0xdd, 0x78, 0x04,
+	0x52, 0x14, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x73, 0x74, 0x6f, 0x72, 0x65,
+	0x64, 0x2e, 0x74, 0x78, 0x74, 0x50, 0x4b, 0x01, 0x02, 0x14, 0x03, 0x14, 0x00, 0x00, 0x00, 0x08,
+	0x00, 0x00, 0x00, 0x21, 0x00, 0x7e, 0x0c, 0x58, 0x8c, 0x07, 0x14, 0x00, 0x00, 0x00, 0x00, 0x30,
+	0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x3c,
+	0x00, 0x00, 0x00, 0x64, 0x65, 0x66, 0x6c, 0x61, 0x74, 0x65, 0x64, 0x2e, 0x62, 0x69, 0x6e, 0x50,
+	0x4b, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x02, 0x00, 0x72, 0x00, 0x00, 0x00, 0x6d,
+	0x14, 0x00, 0x00, 0x00, 0x00,
+};
+
+class ZipTestSuite : public CxxTest::TestSuite {
+	static byte expectedByte(uint32 pos) {
+		return ((pos >> 12) + (pos & 3)) & 0xFF;
+	}
+
+	static bool checkRange(Common::SeekableReadStream &stream, uint32 pos, uint32 len) {
+		byte buf[64];
+		assert(len <= sizeof(buf));
+		if (stream.read(buf, len) != len)
+			return false;
+		for (uint32 i = 0; i < len; ++i) {
+			if (buf[i] != expectedByte(pos + i))
+				return false;
+		}
+		return true;
+	}
+
+	Common::Archive *openArchive() {
+		return Common::makeZipArchive(new Common::MemoryReadStream(zipTestData, sizeof(zipTestData)));
+	}
+
+	public:
+	void test_stored_member() {
+		Common::Archive *archive = openArchive();
+		TS_ASSERT(archive);
+
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember("stored.txt");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 20);
+		TS_ASSERT_EQUALS(stream->readLine(), "Hello stored member!");
+
+		stream->seek(6, SEEK_SET);
+		TS_ASSERT_EQUALS(stream->readByte(), 's');
+
+		delete stream;
+		delete archive;
+	}
+
+#ifdef USE_ZLIB
+	void test_deflated_sequential() {
+		Common::Archive *archive = openArchive();
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember("deflated.bin");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 3 * 1024 * 1024);
+
+		byte buf[4096];
+		bool match = true;
+		uint32 pos = 0;
+		while (!stream->eos()) {
+			uint32 len = stream->read(buf, sizeof(buf));
+			for (uint32 i = 0; i < len; ++i)
+				match &= (buf[i] == expectedByte(pos + i));
+			pos += len;
+		}
+		TS_ASSERT(match);
+		TS_ASSERT_EQUALS(pos, (uint32)stream->size());
+		TS_ASSERT(!stream->err());
+
+		delete stream;
+		delete archive;
+	}
+
+	void test_deflated_seek() {
+		Common::Archive *archive = openArchive();
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember("deflated.bin");
+
+		// Forward across several checkpoints, then back and forth
+		static const uint32 positions[] = { 2621443, 1048573, 17, 3145700, 2097152, 1572865, 0 };
+		for (uint i = 0; i < ARRAYSIZE(positions); ++i) {
+			TS_ASSERT(stream->seek(positions[i], SEEK_SET));
+			TS_ASSERT_EQUALS((uint32)stream->pos(), positions[i]);
+			TS_ASSERT(checkRange(*stream, positions[i], 28));
+		}
+
+		TS_ASSERT(stream->seek(-5, SEEK_END));
+		TS_ASSERT(checkRange(*stream, stream->size() - 5, 5));
+		TS_ASSERT(!stream->eos());
+		stream->readByte();
+		TS_ASSERT(stream->eos());
+
+		delete stream;
+		delete archive;
+	}
+
+	void test_independent_members() {
+		Common::Archive *archive = openArchive();
+		Common::SeekableReadStream *first = archive->createReadStreamForMember("deflated.bin");
+		Common::SeekableReadStream *second = archive->createReadStreamForMember("deflated.bin");
+		Common::SeekableReadStream *stored = archive->createReadStreamForMember("stored.txt");
+
+		second->seek(1000000, SEEK_SET);
+		for (uint32 i = 0; i < 10; ++i) {
+			TS_ASSERT(checkRange(*first, i * 16, 16));
+			TS_ASSERT_EQUALS(stored->readByte(), (byte)"Hello stored member!"[i]);
+			TS_ASSERT(checkRange(*second, 1000000 + i * 16, 16));
+		}
+
+		delete stored;
+		delete second;
+		delete first;
+		delete archive;
+	}
+#endif
+};
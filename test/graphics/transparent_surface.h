@@ -0,0 +1,174 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/transparent_surface.h"
+
+#include "common/endian.h"
+#include "common/util.h"
+
+class TransparentSurfaceTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kWidth = 37,
+		kHeight = 11
+	};
+
+#ifdef SCUMM_LITTLE_ENDIAN
+	enum { kA = 0, kB = 1, kG = 2, kR = 3 };
+#else
+	enum { kA = 3, kB = 2, kG = 1, kR = 0 };
+#endif
+
+	uint32 _seed;
+
+	byte random8() {
+		_seed = _seed * 1103515245 + 12345;
+		return (byte)(_seed >> 16);
+	}
+
+	void fillRandom(Graphics::Surface &surface, bool extremeAlpha) {
+		byte *pixels = (byte *)surface.getPixels();
+		for (int i = 0; i < surface.pitch * surface.h; i++)
+			pixels[i] = random8();
+
+		// Make sure fully transparent and fully opaque pixels show up
+		if (extremeAlpha) {
+			for (int i = 0; i < surface.w * surface.h; i += 3)
+				pixels[i * 4 + kA] = (i % 2) ? 0 : 255;
+		}
+	}
+
+	/**
+	 * Straight per pixel reimplementation of the blending functions
+	 */
+	static void blendReference(const byte *in, byte *out, uint32 color, Graphics::TSpriteBlendMode blendMode) {
+		const uint ca = (color >> 24) & 0xFF;
+		uint c[4];
+		c[kR] = (color >> 16) & 0xFF;
+		c[kG] = (color >> 8) & 0xFF;
+		c[kB] = color & 0xFF;
+		const int channels[] = { kR, kG, kB };
+		const uint a = in[kA];
+
+		if (color == 0xFFFFFFFF && a == 0)
+			return;
+
+		for (int i = 0; i < 3; i++) {
+			const int ch = channels[i];
+
+			if (blendMode == Graphics::BLEND_ADDITIVE) {
+				uint add;
+				if (color == 0xFFFFFFFF)
+					add = in[ch] * a >> 8;
+				else if (c[ch] != 255)
+					add = in[ch] * c[ch] * (a * ca >> 8) >> 16;
+				else
+					add = in[ch] * (a * ca >> 8) >> 8;
+				out[ch] = MIN<uint>(out[ch] + add, 255);
+			} else if (blendMode == Graphics::BLEND_SUBTRACTIVE) {
+				uint sub;
+				if (color == 0xFFFFFFFF || c[ch] == 255)
+					sub = in[ch] * out[ch] * a >> 16;
+				else
+					sub = in[ch] * c[ch] * out[ch] * a >> 24;
+				out[ch] = out[ch] - sub;
+			} else {
+				if (color == 0xFFFFFFFF) {
+					out[ch] = (in[ch] * a + out[ch] * (255 - a)) >> 8;
+				} else {
+					const uint ina = a * ca >> 8;
+					out[ch] = (out[ch] * (255 - ina) >> 8) + (in[ch] * ina * c[ch] >> 16);
+				}
+			}
+		}
+
+		if (blendMode == Graphics::BLEND_NORMAL || (blendMode == Graphics::BLEND_SUBTRACTIVE && color != 0xFFFFFFFF))
+			out[kA] = 255;
+	}
+
+	void checkBlit(Graphics::TSpriteBlendMode blendMode, Graphics::AlphaType alphaType, uint32 color, int flipping, bool extremeAlpha) {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		Graphics::TransparentSurface src;
+		src.create(kWidth, kHeight, format);
+		src.setAlphaMode(alphaType);
+		fillRandom(src, extremeAlpha);
+
+		// Blit to an odd position, so that part of the source is clipped
+		const int posX = 3, posY = 2;
+		Graphics::Surface target, expected;
+		target.create(kWidth + 2, kHeight + 5, format);
+		fillRandom(target, false);
+		expected.copyFrom(target);
+
+		const int width = MIN<int>(kWidth, target.w - posX);
+		const int height = MIN<int>(kHeight, target.h - posY);
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				const int srcX = (flipping & Graphics::FLIP_H) ? width - 1 - x : x;
+				const int srcY = (flipping & Graphics::FLIP_V) ? kHeight - 1 - y : y;
+				const byte *in = (const byte *)src.getBasePtr(srcX, srcY);
+				byte *out = (byte *)expected.getBasePtr(posX + x, posY + y);
+
+				if (color == 0xFFFFFFFF && blendMode == Graphics::BLEND_NORMAL && alphaType == Graphics::ALPHA_OPAQUE) {
+					memcpy(out, in, 4);
+					out[kA] = 255;
+				} else if (color == 0xFFFFFFFF && blendMode == Graphics::BLEND_NORMAL && alphaType == Graphics::ALPHA_BINARY) {
+					if (in[kA]) {
+						memcpy(out, in, 4);
+						out[kA] = 255;
+					}
+				} else {
+					blendReference(in, out, color, blendMode);
+				}
+			}
+		}
+
+		src.blit(target, posX, posY, flipping, 0, color, -1, -1, blendMode);
+
+		TS_ASSERT_EQUALS(memcmp(target.getPixels(), expected.getPixels(), target.pitch * target.h), 0);
+
+		src.free();
+		target.free();
+		expected.free();
+	}
+
+	void checkAllFlips(Graphics::TSpriteBlendMode blendMode, Graphics::AlphaType alphaType, uint32 color) {
+		for (int flipping = Graphics::FLIP_NONE; flipping <= Graphics::FLIP_HV; flipping++) {
+			checkBlit(blendMode, alphaType, color, flipping, false);
+			checkBlit(blendMode, alphaType, color, flipping, true);
+		}
+	}
+
+public:
+	void setUp() {
+		_seed = 0x2468ace0;
+	}
+
+	void test_blit_opaque() {
+		// The opaque fast path copies whole rows and ignores horizontal flipping
+		checkBlit(Graphics::BLEND_NORMAL, Graphics::ALPHA_OPAQUE, 0xFFFFFFFF, Graphics::FLIP_NONE, false);
+		checkBlit(Graphics::BLEND_NORMAL, Graphics::ALPHA_OPAQUE, 0xFFFFFFFF, Graphics::FLIP_V, false);
+	}
+
+	void test_blit_binary() {
+		checkAllFlips(Graphics::BLEND_NORMAL, Graphics::ALPHA_BINARY, 0xFFFFFFFF);
+	}
+
+	void test_blit_alpha() {
+		checkAllFlips(Graphics::BLEND_NORMAL, Graphics::ALPHA_FULL, 0xFFFFFFFF);
+		checkAllFlips(Graphics::BLEND_NORMAL, Graphics::ALPHA_FULL, 0x80FF40C0);
+		checkAllFlips(Graphics::BLEND_NORMAL, Graphics::ALPHA_BINARY, 0xFF102030);
+	}
+
+	void test_blit_additive() {
+		checkAllFlips(Graphics::BLEND_ADDITIVE, Graphics::ALPHA_FULL, 0xFFFFFFFF);
+		checkAllFlips(Graphics::BLEND_ADDITIVE, Graphics::ALPHA_FULL, 0xC0FF7F01);
+		checkAllFlips(Graphics::BLEND_ADDITIVE, Graphics::ALPHA_OPAQUE, 0xFFFEFFFF);
+	}
+
+	void test_blit_subtractive() {
+		checkAllFlips(Graphics::BLEND_SUBTRACTIVE, Graphics::ALPHA_FULL, 0xFFFFFFFF);
+		checkAllFlips(Graphics::BLEND_SUBTRACTIVE, Graphics::ALPHA_FULL, 0xFFFEFF80);
+		checkAllFlips(Graphics::BLEND_SUBTRACTIVE, Graphics::ALPHA_BINARY, 0x40FFFFFE);
+	}
+};
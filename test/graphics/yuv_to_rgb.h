@@ -0,0 +1,183 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite
+{
+private:
+	uint32 _seed;
+
+	byte random8() {
+		_seed = _seed * 1103515245 + 12345;
+		return (byte)(_seed >> 16);
+	}
+
+	void fillRandom(byte *buffer, int size) {
+		for (int i = 0; i < size; i++)
+			buffer[i] = random8();
+	}
+
+	/**
+	 * Straight per pixel version of the conversion formulas
+	 */
+	static uint32 convertReference(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, byte y, byte u, byte v) {
+		int16 CR = v - 128, CB = u - 128;
+		int r = y + (int16) ( (0.419 / 0.299) * CR);
+		int g = y + (int16) (-(0.299 / 0.419) * CR) + (int16) (-(0.114 / 0.331) * CB);
+		int b = y + (int16) ( (0.587 / 0.331) * CB);
+
+		if (scale == Graphics::YUVToRGBManager::kScaleFull) {
+			r = CLIP(r, 0, 255);
+			g = CLIP(g, 0, 255);
+			b = CLIP(b, 0, 255);
+		} else {
+			r = (CLIP(r, 16, 235) - 16) * 255 / 219;
+			g = (CLIP(g, 16, 235) - 16) * 255 / 219;
+			b = (CLIP(b, 16, 235) - 16) * 255 / 219;
+		}
+
+		return format.RGBToColor(r, g, b);
+	}
+
+	static uint32 getPixel(const Graphics::Surface &surface, int x, int y) {
+		if (surface.format.bytesPerPixel == 2)
+			return *(const uint16 *)surface.getBasePtr(x, y);
+		return *(const uint32 *)surface.getBasePtr(x, y);
+	}
+
+	static Graphics::PixelFormat getFormat(int index) {
+		switch (index) {
+		case 0:
+			return Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		case 1:
+			return Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15);
+		case 2:
+			return Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0);
+		default:
+			return Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24);
+		}
+	}
+
+	enum {
+		kFormatCount = 4
+	};
+
+	void checkConvert444(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, int width, int height, bool exhaustive) {
+		const int yPitch = width + 3, uvPitch = width + 5;
+		byte *ySrc = new byte[yPitch * height];
+		byte *uSrc = new byte[uvPitch * height];
+		byte *vSrc = new byte[uvPitch * height];
+		fillRandom(ySrc, yPitch * height);
+		fillRandom(uSrc, uvPitch * height);
+		fillRandom(vSrc, uvPitch * height);
+
+		// Go through all chroma values
+		if (exhaustive) {
+			for (int y = 0; y < height; y++) {
+				for (int x = 0; x < width; x++) {
+					ySrc[y * yPitch + x] = y * 255 / (height - 1);
+					uSrc[y * uvPitch + x] = x;
+					vSrc[y * uvPitch + x] = 255 - x;
+				}
+			}
+		}
+
+		Graphics::Surface dst;
+		dst.create(width, height, format);
+		YUVToRGBMan.convert444(&dst, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+
+		for (int y = 0; y < height; y++)
+			for (int x = 0; x < width; x++)
+				TS_ASSERT_EQUALS(getPixel(dst, x, y), convertReference(format, scale, ySrc[y * yPitch + x], uSrc[y * uvPitch + x], vSrc[y * uvPitch + x]));
+
+		dst.free();
+		delete[] ySrc;
+		delete[] uSrc;
+		delete[] vSrc;
+	}
+
+	void checkConvert420(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, int width, int height) {
+		const int yPitch = width + 2, uvPitch = width / 2 + 3;
+		byte *ySrc = new byte[yPitch * height];
+		byte *uSrc = new byte[uvPitch * height / 2];
+		byte *vSrc = new byte[uvPitch * height / 2];
+		fillRandom(ySrc, yPitch * height);
+		fillRandom(uSrc, uvPitch * height / 2);
+		fillRandom(vSrc, uvPitch * height / 2);
+
+		Graphics::Surface dst;
+		dst.create(width, height, format);
+		YUVToRGBMan.convert420(&dst, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+
+		for (int y = 0; y < height; y++)
+			for (int x = 0; x < width; x++)
+				TS_ASSERT_EQUALS(getPixel(dst, x, y), convertReference(format, scale, ySrc[y * yPitch + x], uSrc[(y / 2) * uvPitch + x / 2], vSrc[(y / 2) * uvPitch + x / 2]));
+
+		dst.free();
+		delete[] ySrc;
+		delete[] uSrc;
+		delete[] vSrc;
+	}
+
+	static byte interpolate410(const byte *src, int uvPitch, int x, int y) {
+		const byte *quad = src + (y / 4) * uvPitch + x / 4;
+		int xDiff = x & 3, yDiff = y & 3;
+		return (quad[0] * (4 - xDiff) * (4 - yDiff) + quad[1] * xDiff * (4 - yDiff) +
+				quad[uvPitch] * yDiff * (4 - xDiff) + quad[uvPitch + 1] * xDiff * yDiff) >> 4;
+	}
+
+	void checkConvert410(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, int width, int height) {
+		// The interpolation reads one chroma sample past the right and
+		// bottom edges
+		const int yPitch = width, uvPitch = width / 4 + 1, uvHeight = height / 4 + 1;
+		byte *ySrc = new byte[yPitch * height];
+		byte *uSrc = new byte[uvPitch * uvHeight];
+		byte *vSrc = new byte[uvPitch * uvHeight];
+		fillRandom(ySrc, yPitch * height);
+		fillRandom(uSrc, uvPitch * uvHeight);
+		fillRandom(vSrc, uvPitch * uvHeight);
+
+		Graphics::Surface dst;
+		dst.create(width, height, format);
+		YUVToRGBMan.convert410(&dst, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+
+		for (int y = 0; y < height; y++)
+			for (int x = 0; x < width; x++)
+				TS_ASSERT_EQUALS(getPixel(dst, x, y), convertReference(format, scale, ySrc[y * yPitch + x], interpolate410(uSrc, uvPitch, x, y), interpolate410(vSrc, uvPitch, x, y)));
+
+		dst.free();
+		delete[] ySrc;
+		delete[] uSrc;
+		delete[] vSrc;
+	}
+
+public:
+	void setUp() {
+		_seed = 0x13579bdf;
+	}
+
+	void test_convert444() {
+		for (int i = 0; i < kFormatCount; i++) {
+			checkConvert444(getFormat(i), Graphics::YUVToRGBManager::kScaleFull, 256, 16, true);
+			checkConvert444(getFormat(i), Graphics::YUVToRGBManager::kScaleITU, 256, 16, true);
+			checkConvert444(getFormat(i), Graphics::YUVToRGBManager::kScaleFull, 37, 5, false);
+			checkConvert444(getFormat(i), Graphics::YUVToRGBManager::kScaleITU, 37, 5, false);
+		}
+	}
+
+	void test_convert420() {
+		for (int i = 0; i < kFormatCount; i++) {
+			checkConvert420(getFormat(i), Graphics::YUVToRGBManager::kScaleFull, 70, 6);
+			checkConvert420(getFormat(i), Graphics::YUVToRGBManager::kScaleITU, 70, 6);
+			checkConvert420(getFormat(i), Graphics::YUVToRGBManager::kScaleFull, 2, 2);
+		}
+	}
+
+	void test_convert410() {
+		for (int i = 0; i < kFormatCount; i++) {
+			checkConvert410(getFormat(i), Graphics::YUVToRGBManager::kScaleFull, 76, 8);
+			checkConvert410(getFormat(i), Graphics::YUVToRGBManager::kScaleITU, 76, 8);
+			checkConvert410(getFormat(i), Graphics::YUVToRGBManager::kScaleFull, 4, 4);
+		}
+	}
+};
@@ -0,0 +1,180 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/list.h"
+#include "common/system.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+#include "video/video_decoder.h"
+
+/**
+ * Just enough of a backend for the video decoder: a clock which only moves
+ * when the test tells it to.
+ */
+class VideoTestSystem : public OSystem {
+public:
+	uint32 _millis;
+
+	VideoTestSystem() : _millis(0) {}
+
+	const GraphicsMode *getSupportedGraphicsModes() const { return 0; }
+	int getDefaultGraphicsMode() const { return 0; }
+	bool setGraphicsMode(int mode) { return false; }
+	int getGraphicsMode() const { return 0; }
+#ifdef USE_RGB_COLOR
+	Graphics::PixelFormat getScreenFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	Common::List<Graphics::PixelFormat> getSupportedFormats() const { return Common::List<Graphics::PixelFormat>(); }
+#endif
+	void initSize(uint width, uint height, const Graphics::PixelFormat *format) {}
+	int16 getHeight() { return 0; }
+	int16 getWidth() { return 0; }
+	PaletteManager *getPaletteManager() { return 0; }
+	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {}
+	Graphics::Surface *lockScreen() { return 0; }
+	void unlockScreen() {}
+	void fillScreen(uint32 col) {}
+	void updateScreen() {}
+	void setShakePos(int shakeOffset) {}
+	void showOverlay() {}
+	void hideOverlay() {}
+	Graphics::PixelFormat getOverlayFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	void clearOverlay() {}
+	void grabOverlay(void *buf, int pitch) {}
+	void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {}
+	int16 getOverlayHeight() { return 0; }
+	int16 getOverlayWidth() { return 0; }
+	bool showMouse(bool visible) { return false; }
+	void warpMouse(int x, int y) {}
+	void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale, const Graphics::PixelFormat *format) {}
+	uint32 getMillis(bool skipRecord) { return _millis; }
+	void delayMillis(uint msecs) { _millis += msecs; }
+	void getTimeAndDate(TimeDate &t) const {}
+	MutexRef createMutex() { return 0; }
+	void lockMutex(MutexRef mutex) {}
+	void unlockMutex(MutexRef mutex) {}
+	void deleteMutex(MutexRef mutex) {}
+	Audio::Mixer *getMixer() { return 0; }
+	void quit() {}
+	void displayMessageOnOSD(const char *msg) {}
+	void logMessage(LogMessageType::Type type, const char *message) {}
+};
+
+/**
+ * A 10 fps video whose frames are a single pixel holding the frame number.
+ */
+class TestVideoDecoder : public Video::VideoDecoder {
+public:
+	bool loadStream(Common::SeekableReadStream *stream) {
+		close();
+		addTrack(new TestVideoTrack());
+		return true;
+	}
+
+private:
+	class TestVideoTrack : public FixedRateVideoTrack {
+	public:
+		TestVideoTrack() : _curFrame(-1), _reversed(false) {
+			_surface.create(1, 1, Graphics::PixelFormat::createFormatCLUT8());
+		}
+
+		~TestVideoTrack() {
+			_surface.free();
+		}
+
+		bool endOfTrack() const { return _reversed ? _curFrame <= 0 : _curFrame >= getFrameCount() - 1; }
+		uint16 getWidth() const { return 1; }
+		uint16 getHeight() const { return 1; }
+		Graphics::PixelFormat getPixelFormat() const { return _surface.format; }
+		int getCurFrame() const { return _curFrame; }
+		int getFrameCount() const { return 20; }
+
+		uint32 getNextFrameStartTime() const {
+			// Played backwards, the previous frame is due once the start of
+			// the current one has been passed
+			if (_reversed)
+				return endOfTrack() ? 0 : getFrameTime(_curFrame).msecs();
+
+			return FixedRateVideoTrack::getNextFrameStartTime();
+		}
+
+		const Graphics::Surface *decodeNextFrame() {
+			_curFrame += _reversed ? -1 : 1;
+			*(byte *)_surface.getPixels() = _curFrame;
+			return &_surface;
+		}
+
+		bool isSeekable() const { return true; }
+
+		bool seek(const Audio::Timestamp &time) {
+			_curFrame = getFrameAtTime(time) - 1;
+			return true;
+		}
+
+		bool setReverse(bool reverse) {
+			_reversed = reverse;
+			return true;
+		}
+
+		bool isReversed() const { return _reversed; }
+
+	protected:
+		Common::Rational getFrameRate() const { return 10; }
+
+	private:
+		Graphics::Surface _surface;
+		int _curFrame;
+		bool _reversed;
+	};
+};
+
+class VideoDecoderTestSuite : public CxxTest::TestSuite
+{
+private:
+	VideoTestSystem _system;
+	OSystem *_oldSystem;
+
+public:
+	void setUp() {
+		_oldSystem = g_system;
+		g_system = &_system;
+		_system._millis = 0;
+	}
+
+	void tearDown() {
+		g_system = _oldSystem;
+	}
+
+	void test_reverse_after_decode_ahead() {
+		TestVideoDecoder decoder;
+		TS_ASSERT(decoder.loadStream(0));
+		TS_ASSERT(decoder.setDecodeAhead(3));
+		decoder.start();
+
+		const Graphics::Surface *frame = decoder.decodeNextFrame();
+		TS_ASSERT(frame);
+		TS_ASSERT_EQUALS(*(const byte *)frame->getPixels(), 0);
+
+		// Frame 1 is displayed while frames 2 to 4 are queued
+		_system._millis = 150;
+		TS_ASSERT(decoder.needsUpdate());
+		decoder.decodeNextFrame();
+		decoder.updateDecodeAhead();
+		TS_ASSERT_EQUALS(decoder.getDecodeAheadQueueDepth(), 3u);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 1);
+
+		// Playing backwards has to continue from the frame on screen, not
+		// from the last one decoded ahead
+		decoder.setRate(-1);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 1);
+		TS_ASSERT_EQUALS(decoder.getTime(), 150u);
+
+		decoder.updateDecodeAhead();
+		TS_ASSERT_EQUALS(decoder.getDecodeAheadQueueDepth(), 0u);
+
+		_system._millis = 210;
+		TS_ASSERT(decoder.needsUpdate());
+		frame = decoder.decodeNextFrame();
+		TS_ASSERT(frame);
+		TS_ASSERT_EQUALS(*(const byte *)frame->getPixels(), 0);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 0);
+	}
+};
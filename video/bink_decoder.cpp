@@ -27,6 +27,7 @@
 #include "audio/audiostream.h"
 #include "audio/decoders/raw.h"
 
+#include "common/debug.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 #include "common/math.h"
@@ -59,10 +60,19 @@ static const uint16 kAudioFlagStereo = 0x2000;
 // Number of bits used to store first DC value in bundle
 static const uint32 kDCStartBits = 11;
 
+/** The value of all pixels of an IDCT'd block with only a DC coefficient. */
+static inline byte IDCTDC(int16 dc) {
+	return (dc + 0x7F) >> 8;
+}
+
 namespace Video {
 
 BinkDecoder::BinkDecoder() {
 	_bink = 0;
+
+	_decodedFrameCount = 0;
+	_videoDecodeTime = 0;
+	_maxFrameDecodeTime = 0;
 }
 
 BinkDecoder::~BinkDecoder() {
@@ -145,6 +155,13 @@ bool BinkDecoder::loadStream(Common::SeekableReadStream *stream) {
 }
 
 void BinkDecoder::close() {
+	if (_decodedFrameCount > 0)
+		debug(1, "Bink: Decoded %d video frames in %d ms (%d ms max)", _decodedFrameCount, _videoDecodeTime, _maxFrameDecodeTime);
+
+	_decodedFrameCount = 0;
+	_videoDecodeTime = 0;
+	_maxFrameDecodeTime = 0;
+
 	VideoDecoder::close();
 
 	delete _bink;
@@ -206,8 +223,16 @@ void BinkDecoder::readNextPacket() {
 	frame.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
 			videoPacketStart, videoPacketEnd), true);
 
+	uint32 startTime = g_system->getMillis();
+
 	videoTrack->decodePacket(frame);
 
+	uint32 decodeTime = g_system->getMillis() - startTime;
+
+	_decodedFrameCount++;
+	_videoDecodeTime += decodeTime;
+	_maxFrameDecodeTime = MAX(_maxFrameDecodeTime, decodeTime);
+
 	delete frame.bits;
 	frame.bits = 0;
 }
@@ -681,7 +706,16 @@ void BinkDecoder::BinkVideoTrack::blockScaledIntra(DecodeContext &ctx) {
 
 	block[0] = getBundleValue(kSourceIntraDC);
 
-	readDCTCoeffs(*ctx.video, block, true);
+	if (readDCTCoeffs(*ctx.video, block, true) == 0) {
+		// Only a DC coefficient, so the whole block has the same value
+		byte v = IDCTDC(block[0]);
+
+		byte *dest = ctx.dest;
+		for (int i = 0; i < 16; i++, dest += ctx.pitch)
+			memset(dest, v, 16);
+
+		return;
+	}
 
 	IDCT(block);
 
@@ -826,7 +860,15 @@ void BinkDecoder::BinkVideoTrack::blockIntra(DecodeContext &ctx) {
 
 	block[0] = getBundleValue(kSourceIntraDC);
 
-	readDCTCoeffs(*ctx.video, block, true);
+	if (readDCTCoeffs(*ctx.video, block, true) == 0) {
+		byte v = IDCTDC(block[0]);
+
+		byte *dest = ctx.dest;
+		for (int i = 0; i < 8; i++, dest += ctx.pitch)
+			memset(dest, v, 8);
+
+		return;
+	}
 
 	IDCTPut(ctx, block);
 }
@@ -847,7 +889,16 @@ void BinkDecoder::BinkVideoTrack::blockInter(DecodeContext &ctx) {
 
 	block[0] = getBundleValue(kSourceInterDC);
 
-	readDCTCoeffs(*ctx.video, block, false);
+	if (readDCTCoeffs(*ctx.video, block, false) == 0) {
+		byte v = IDCTDC(block[0]);
+
+		byte *dest = ctx.dest;
+		for (int i = 0; i < 8; i++, dest += ctx.pitch)
+			for (int j = 0; j < 8; j++)
+				dest[j] += v;
+
+		return;
+	}
 
 	IDCTAdd(ctx, block);
 }
@@ -1077,8 +1128,8 @@ void BinkDecoder::BinkVideoTrack::readDCS(VideoFrame &video, Bundle &bundle, int
 	bundle.curDec = (byte *) dest;
 }
 
-/** Reads 8x8 block of DCT coefficients. */
-void BinkDecoder::BinkVideoTrack::readDCTCoeffs(VideoFrame &video, int16 *block, bool isIntra) {
+/** Reads 8x8 block of DCT coefficients and returns the number of AC coefficients. */
+int BinkDecoder::BinkVideoTrack::readDCTCoeffs(VideoFrame &video, int16 *block, bool isIntra) {
 	int coefCount = 0;
 	int coefIdx[64];
 
@@ -1173,6 +1224,7 @@ void BinkDecoder::BinkVideoTrack::readDCTCoeffs(VideoFrame &video, int16 *block,
 		block[binkScan[idx]] = (block[binkScan[idx]] * quant[idx]) >> 11;
 	}
 
+	return coefCount;
 }
 
 /** Reads 8x8 block with residue after motion compensation. */
@@ -1318,15 +1370,24 @@ static inline void IDCTCol(int16 *dest, const int16 *src) {
 	}
 }
 
+template<typename T>
+static inline void IDCTRow(T *dest, const int16 *src) {
+	if ((src[1] | src[2] | src[3] | src[4] | src[5] | src[6] | src[7]) == 0) {
+		const T v = MUNGE_ROW(src[0]);
+		dest[0] = dest[1] = dest[2] = dest[3] = dest[4] = dest[5] = dest[6] = dest[7] = v;
+	} else {
+		IDCT_ROW(dest, src);
+	}
+}
+
 void BinkDecoder::BinkVideoTrack::IDCT(int16 *block) {
 	int i;
 	int16 temp[64];
 
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&block[8*i]), (&temp[8*i]) );
-	}
+	for (i = 0; i < 8; i++)
+		IDCTRow(&block[8*i], &temp[8*i]);
 }
 
 void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int16 *block) {
@@ -1344,9 +1405,8 @@ void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int16 *block) {
 	int16 temp[64];
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
-	}
+	for (i = 0; i < 8; i++)
+		IDCTRow(&ctx.dest[i*ctx.pitch], &temp[8*i]);
 }
 
 BinkDecoder::BinkAudioTrack::BinkAudioTrack(BinkDecoder::AudioInfo &audio) : _audioInfo(&audio) {
@@ -72,6 +72,13 @@ public:
 	bool loadStream(Common::SeekableReadStream *stream);
 	void close();
 
+	/** Return the number of video frames decoded since the video was loaded. */
+	uint32 getDecodedFrameCount() const { return _decodedFrameCount; }
+	/** Return the time in milliseconds spent decoding video frames since the video was loaded. */
+	uint32 getVideoDecodeTime() const { return _videoDecodeTime; }
+	/** Return the longest time in milliseconds spent decoding a single video frame. */
+	uint32 getMaxFrameDecodeTime() const { return _maxFrameDecodeTime; }
+
 protected:
 	void readNextPacket();
 	bool supportsAudioTrackSwitching() const { return true; }
@@ -309,7 +316,7 @@ private:
 		void readPatterns    (VideoFrame &video, Bundle &bundle);
 		void readColors      (VideoFrame &video, Bundle &bundle);
 		void readDCS         (VideoFrame &video, Bundle &bundle, int startBits, bool hasSign);
-		void readDCTCoeffs   (VideoFrame &video, int16 *block, bool isIntra);
+		int  readDCTCoeffs   (VideoFrame &video, int16 *block, bool isIntra);
 		void readResidue     (VideoFrame &video, int16 *block, int masksCount);
 
 		// Bink video IDCT
@@ -352,6 +359,10 @@ private:
 	Common::Array<AudioInfo> _audioTracks; ///< All audio tracks.
 	Common::Array<VideoFrame> _frames;      ///< All video frames.
 
+	uint32 _decodedFrameCount;  ///< Number of video frames decoded.
+	uint32 _videoDecodeTime;    ///< Time spent decoding video frames, in ms.
+	uint32 _maxFrameDecodeTime; ///< Longest time spent decoding a video frame, in ms.
+
 	void initAudioTrack(AudioInfo &audio);
 };
 
@@ -74,6 +74,10 @@ public:
 protected:
 	Common::QuickTimeParser::SampleDesc *readSampleDesc(Common::QuickTimeParser::Track *track, uint32 format, uint32 descSize);
 
+	// updateAudioBuffer() and reverse playback need the video tracks to be
+	// at the frame which is displayed
+	bool supportsDecodeAhead() const { return false; }
+
 private:
 	void init();
 
@@ -30,6 +30,7 @@
 #include "common/system.h"
 
 #include "graphics/palette.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
@@ -47,6 +48,11 @@ VideoDecoder::VideoDecoder() {
 	_endTimeSet = false;
 	_nextVideoTrack = 0;
 	_mainAudioTrack = 0;
+	_frameQueueStart = 0;
+	_frameQueueCount = 0;
+	_decodeAheadFrames = 0;
+	_decodeTimeEstimate = 0;
+	_lateFrameCount = 0;
 
 	// Find the best format for output
 	_defaultHighColorFormat = g_system->getScreenFormat();
@@ -55,6 +61,10 @@ VideoDecoder::VideoDecoder() {
 		_defaultHighColorFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 }
 
+VideoDecoder::~VideoDecoder() {
+	freeFrameQueue();
+}
+
 void VideoDecoder::close() {
 	if (isPlaying())
 		stop();
@@ -77,6 +87,11 @@ void VideoDecoder::close() {
 	_endTimeSet = false;
 	_nextVideoTrack = 0;
 	_mainAudioTrack = 0;
+
+	freeFrameQueue();
+	_decodeAheadFrames = 0;
+	_decodeTimeEstimate = 0;
+	_lateFrameCount = 0;
 }
 
 bool VideoDecoder::loadFile(const Common::String &filename) {
@@ -172,6 +187,27 @@ Graphics::PixelFormat VideoDecoder::getPixelFormat() const {
 const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_needsUpdate = false;
 
+	if (getDecodeAheadTrack()) {
+		// Decode the frame now if none was ready in time
+		if (_frameQueueCount == 0 && !queueNextFrame())
+			return 0;
+
+		const QueuedFrame &queuedFrame = _frameQueue[_frameQueueStart];
+		_frameQueueStart = (_frameQueueStart + 1) % _frameQueue.size();
+		_frameQueueCount--;
+
+		if (queuedFrame.dirtyPalette) {
+			memcpy(_queuedPalette, queuedFrame.palette, sizeof(_queuedPalette));
+			_palette = _queuedPalette;
+			_dirtyPalette = true;
+		}
+
+		if (isPlaying() && !isPaused() && hasFramesLeft() && getTimeToNextFrame() == 0)
+			_lateFrameCount++;
+
+		return queuedFrame.hasFrame ? queuedFrame.surface : 0;
+	}
+
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -189,6 +225,9 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	// Look for the next video track here for the next decode.
 	findNextVideoTrack();
 
+	if (frame && isPlaying() && !isPaused() && hasFramesLeft() && getTimeToNextFrame() == 0)
+		_lateFrameCount++;
+
 	return frame;
 }
 
@@ -200,6 +239,10 @@ bool VideoDecoder::setReverse(bool reverse) {
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
+			// The track has already moved on to the frames decoded ahead
+			if (!seekToPresentedFrame())
+				return false;
+
 			if (!((VideoTrack *)*it)->setReverse(reverse))
 				return false;
 
@@ -219,9 +262,12 @@ const byte *VideoDecoder::getPalette() {
 int VideoDecoder::getCurFrame() const {
 	int32 frame = -1;
 
-	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)*it)->getCurFrame() + 1;
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo) {
+			const QueuedFrame *presentedFrame = getPresentedFrame(*it);
+			frame += (presentedFrame ? presentedFrame->curFrame : ((VideoTrack *)*it)->getCurFrame()) + 1;
+		}
+	}
 
 	return frame;
 }
@@ -258,13 +304,21 @@ uint32 VideoDecoder::getTime() const {
 }
 
 uint32 VideoDecoder::getTimeToNextFrame() const {
-	if (endOfVideo() || _needsUpdate || !_nextVideoTrack)
+	if (endOfVideo() || _needsUpdate)
+		return 0;
+
+	// While frames are queued, the video track has already moved past the
+	// frame that is displayed next
+	VideoTrack *track = _frameQueueCount ? getDecodeAheadTrack() : _nextVideoTrack;
+
+	if (!track)
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	const QueuedFrame *presentedFrame = getPresentedFrame(track);
+	uint32 nextFrameStartTime = presentedFrame ? presentedFrame->nextFrameStartTime : track->getNextFrameStartTime();
 
-	if (_nextVideoTrack->isReversed()) {
+	if (track->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
 		if (nextFrameStartTime >= currentTime)
 			return 0;
@@ -280,10 +334,16 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 }
 
 bool VideoDecoder::endOfVideo() const {
-	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
-		if (!(*it)->endOfTrack() && (!isPlaying() || (*it)->getTrackType() != Track::kTrackTypeVideo || !_endTimeSet || ((VideoTrack *)*it)->getNextFrameStartTime() < (uint)_endTime.msecs()))
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		// A video track with queued frames has not been displayed to its end yet
+		const QueuedFrame *presentedFrame = getPresentedFrame(*it);
+		if (presentedFrame && (!isPlaying() || !_endTimeSet || presentedFrame->nextFrameStartTime < (uint)_endTime.msecs()))
 			return false;
 
+		if (!presentedFrame && !(*it)->endOfTrack() && (!isPlaying() || (*it)->getTrackType() != Track::kTrackTypeVideo || !_endTimeSet || ((VideoTrack *)*it)->getNextFrameStartTime() < (uint)_endTime.msecs()))
+			return false;
+	}
+
 	return true;
 }
 
@@ -306,6 +366,8 @@ bool VideoDecoder::rewind() {
 	if (isPlaying())
 		stopAudio();
 
+	flushFrameQueue();
+
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if (!(*it)->rewind())
 			return false;
@@ -340,6 +402,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (isPlaying())
 		stopAudio();
 
+	flushFrameQueue();
+
 	// Do the actual seeking
 	if (!seekIntern(time))
 		return false;
@@ -875,9 +939,17 @@ bool VideoDecoder::hasFramesLeft() const {
 	// This is similar to endOfVideo(), except it doesn't take Audio into account (and returns true if not the end of the video)
 	// This is only used for needsUpdate() atm so that setEndTime() works properly
 	// And unlike endOfVideoTracks(), this takes into account _endTime
-	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack() && (!isPlaying() || !_endTimeSet || ((VideoTrack *)*it)->getNextFrameStartTime() < (uint)_endTime.msecs()))
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() != Track::kTrackTypeVideo)
+			continue;
+
+		const QueuedFrame *presentedFrame = getPresentedFrame(*it);
+		bool endOfTrack = presentedFrame ? false : (*it)->endOfTrack();
+		uint32 nextFrameStartTime = presentedFrame ? presentedFrame->nextFrameStartTime : ((VideoTrack *)*it)->getNextFrameStartTime();
+
+		if (!endOfTrack && (!isPlaying() || !_endTimeSet || nextFrameStartTime < (uint)_endTime.msecs()))
 			return true;
+	}
 
 	return false;
 }
@@ -890,4 +962,161 @@ bool VideoDecoder::hasAudio() const {
 	return false;
 }
 
+bool VideoDecoder::setDecodeAhead(uint frames) {
+	if (frames != 0 && !supportsDecodeAhead())
+		return false;
+
+	freeFrameQueue();
+	_decodeAheadFrames = frames;
+
+	// One more entry than frames to decode ahead, so that the frame last
+	// returned by decodeNextFrame() stays valid until the next call
+	if (frames != 0) {
+		_frameQueue.resize(frames + 1);
+
+		for (uint i = 0; i < _frameQueue.size(); i++) {
+			_frameQueue[i].surface = new Graphics::Surface();
+			_frameQueue[i].hasFrame = false;
+			_frameQueue[i].dirtyPalette = false;
+		}
+	}
+
+	return true;
+}
+
+VideoDecoder::VideoTrack *VideoDecoder::getDecodeAheadTrack() const {
+	if (_decodeAheadFrames == 0)
+		return 0;
+
+	VideoTrack *videoTrack = 0;
+
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo) {
+			// The queue only keeps the state of one track
+			if (videoTrack)
+				return 0;
+
+			videoTrack = (VideoTrack *)*it;
+		}
+	}
+
+	// Reversed tracks decode each frame from the previous key frame anyway
+	if (videoTrack && videoTrack->isReversed())
+		return 0;
+
+	return videoTrack;
+}
+
+const VideoDecoder::QueuedFrame *VideoDecoder::getPresentedFrame(const Track *track) const {
+	// While frames are queued, the state of the video track before the first
+	// of them is decoded is the one that has been displayed.
+	if (_frameQueueCount == 0 || track->getTrackType() != Track::kTrackTypeVideo)
+		return 0;
+
+	return &_frameQueue[_frameQueueStart];
+}
+
+bool VideoDecoder::seekToPresentedFrame() {
+	VideoTrack *track = getDecodeAheadTrack();
+	const QueuedFrame *presentedFrame = track ? getPresentedFrame(track) : 0;
+
+	if (!presentedFrame)
+		return true;
+
+	if (!isSeekable())
+		return false;
+
+	// Seek to the frame after the one being displayed, so that it is the
+	// next one to be decoded again. Prefer the exact frame time, the queued
+	// start time is rounded to milliseconds.
+	Audio::Timestamp time = track->getFrameTime(presentedFrame->curFrame + 1);
+	if (time.totalNumberOfFrames() < 0)
+		time = Audio::Timestamp(presentedFrame->nextFrameStartTime, 1000);
+
+	flushFrameQueue();
+
+	// Unlike seek(), leave the playback time alone
+	if (!seekIntern(time))
+		return false;
+
+	for (TrackListIterator it = _externalTracks.begin(); it != _externalTracks.end(); it++)
+		if (!(*it)->seek(time))
+			return false;
+
+	findNextVideoTrack();
+	return true;
+}
+
+bool VideoDecoder::queueNextFrame() {
+	if (!_nextVideoTrack || _frameQueueCount >= _decodeAheadFrames)
+		return false;
+
+	QueuedFrame &queuedFrame = _frameQueue[(_frameQueueStart + _frameQueueCount) % _frameQueue.size()];
+	queuedFrame.curFrame = _nextVideoTrack->getCurFrame();
+	queuedFrame.nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+
+	uint32 startTime = g_system->getMillis();
+
+	readNextPacket();
+
+	if (!_nextVideoTrack)
+		return false;
+
+	const Graphics::Surface *frame = _nextVideoTrack->decodeNextFrame();
+
+	queuedFrame.dirtyPalette = _nextVideoTrack->hasDirtyPalette();
+	if (queuedFrame.dirtyPalette)
+		memcpy(queuedFrame.palette, _nextVideoTrack->getPalette(), sizeof(queuedFrame.palette));
+
+	queuedFrame.hasFrame = (frame != 0);
+	if (frame) {
+		Graphics::Surface *surface = queuedFrame.surface;
+
+		if (surface->w != frame->w || surface->h != frame->h || surface->format != frame->format) {
+			surface->free();
+			surface->create(frame->w, frame->h, frame->format);
+		}
+
+		surface->copyRectToSurface(frame->getPixels(), frame->pitch, 0, 0, frame->w, frame->h);
+	}
+
+	findNextVideoTrack();
+	_frameQueueCount++;
+
+	// Keep track of how long decoding takes, slowly forgetting about
+	// expensive frames from the past
+	uint32 decodeTime = g_system->getMillis() - startTime;
+	_decodeTimeEstimate = MAX(decodeTime, _decodeTimeEstimate * 7 / 8);
+	return true;
+}
+
+void VideoDecoder::updateDecodeAhead() {
+	if (!isPlaying() || isPaused() || !getDecodeAheadTrack())
+		return;
+
+	// Only decode ahead as long as we don't risk missing the next frame
+	while (_frameQueueCount < _decodeAheadFrames && _nextVideoTrack && getTimeToNextFrame() > _decodeTimeEstimate) {
+		if (_endTimeSet && _nextVideoTrack->getNextFrameStartTime() >= (uint)_endTime.msecs())
+			break;
+
+		if (!queueNextFrame())
+			break;
+	}
+}
+
+void VideoDecoder::flushFrameQueue() {
+	_frameQueueStart = 0;
+	_frameQueueCount = 0;
+}
+
+void VideoDecoder::freeFrameQueue() {
+	for (uint i = 0; i < _frameQueue.size(); i++) {
+		_frameQueue[i].surface->free();
+		delete _frameQueue[i].surface;
+	}
+
+	_frameQueue.clear();
+	flushFrameQueue();
+}
+
 } // End of namespace Video
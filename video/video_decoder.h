@@ -52,7 +52,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -334,10 +334,20 @@ public:
 	/**
 	 * Check whether a new frame should be decoded, i.e. because enough
 	 * time has elapsed since the last frame was decoded.
+	 *
 	 * @return whether a new frame should be decoded or not
 	 */
 	bool needsUpdate() const;
 
+	/**
+	 * Use the time until the next frame is due to decode upcoming frames.
+	 * Call this from the playback loop while waiting for the next frame.
+	 * It does nothing unless decoding ahead is enabled.
+	 *
+	 * @see setDecodeAhead()
+	 */
+	void updateDecodeAhead();
+
 	/**
 	 * Decode the next frame into a surface and return the latter.
 	 *
@@ -377,6 +387,36 @@ public:
 	 */
 	bool setReverse(bool reverse);
 
+	/**
+	 * Set the number of frames to decode ahead of time.
+	 *
+	 * Decoded frames are kept in a queue and are filled in by
+	 * updateDecodeAhead() while there is time left until the next frame is
+	 * due. This way, a frame which takes unusually long to decode (e.g. a
+	 * key frame) does not make the frames after it late. Only videos with a
+	 * single video track can be decoded ahead, and only while they are
+	 * played forward.
+	 *
+	 * This setting remains until close() is called (which may be called
+	 * from loadStream()). The default is 0, which disables decoding ahead.
+	 *
+	 * @param frames The maximum number of frames to keep decoded ahead
+	 * @return true on success, false if this video cannot be decoded ahead
+	 */
+	bool setDecodeAhead(uint frames);
+
+	/**
+	 * Get the number of frames which have been decoded ahead and are
+	 * waiting to be displayed.
+	 */
+	uint getDecodeAheadQueueDepth() const { return _frameQueueCount; }
+
+	/**
+	 * Get the number of frames which were only decoded after the frame
+	 * following them was already due.
+	 */
+	uint32 getLateFrameCount() const { return _lateFrameCount; }
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -884,6 +924,16 @@ protected:
 	 */
 	virtual AudioTrack *getAudioTrack(int index) { return 0; }
 
+	/**
+	 * Can the frames of this video be decoded ahead of time?
+	 *
+	 * A subclass whose decodeNextFrame() relies on the tracks being at the
+	 * frame that is about to be displayed should return false here.
+	 *
+	 * @see setDecodeAhead()
+	 */
+	virtual bool supportsDecodeAhead() const { return true; }
+
 private:
 	// Tracks owned by this VideoDecoder
 	TrackList _tracks;
@@ -918,6 +968,32 @@ private:
 	int8 _audioBalance;
 
 	AudioTrack *_mainAudioTrack;
+
+	// Frames that have been decoded ahead
+	struct QueuedFrame {
+		Graphics::Surface *surface;
+		bool hasFrame;
+		bool dirtyPalette;
+		byte palette[256 * 3];
+
+		// State of the video track before this frame was decoded
+		int curFrame;
+		uint32 nextFrameStartTime;
+	};
+
+	Common::Array<QueuedFrame> _frameQueue;
+	uint _frameQueueStart, _frameQueueCount;
+	uint _decodeAheadFrames;
+	uint32 _decodeTimeEstimate;
+	uint32 _lateFrameCount;
+	byte _queuedPalette[256 * 3];
+
+	VideoTrack *getDecodeAheadTrack() const;
+	const QueuedFrame *getPresentedFrame(const Track *track) const;
+	bool seekToPresentedFrame();
+	bool queueNextFrame();
+	void flushFrameQueue();
+	void freeFrameQueue();
 };
 
 } // End of namespace Video